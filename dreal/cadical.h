@@ -0,0 +1,15 @@
+/// @file cadical.h
+///
+/// This is the header file where we include CaDiCaL. It is only used when
+/// dReal is built with --//:enable-cadical (together with
+/// --//:enable-soplex), and it requires a version of CaDiCaL which provides
+/// the IPASIR-UP interface (CaDiCaL::ExternalPropagator, 2.0 or newer).
+///
+/// Other files in dreal should include this file and should NOT
+/// include files in the cadical directory. Similarly, BUILD files
+/// should only have a dependency on "//dreal/:cadical", not
+/// "//:cadical".
+///
+#pragma once
+
+#include <cadical.hpp>
@@ -22,6 +22,9 @@
 #if HAVE_SOPLEX
 # include "dreal/soplex.h"
 #endif
+#if HAVE_CADICAL
+# include "dreal/cadical.h"
+#endif
 
 namespace dreal {
 
@@ -51,6 +54,9 @@ string get_version_string() {
                             qsopt_ex::QSopt_ex_repository_status());
 #if HAVE_SOPLEX
   vstr += fmt::format(" (soplex: {})", soplex::getGitHash());
+#endif
+#if HAVE_CADICAL
+  vstr += fmt::format(" (cadical: {})", CaDiCaL::Solver::version());
 #endif
   return vstr;
 }
@@ -121,6 +127,13 @@ void MainProgram::AddOptions() {
            0 /* Delimiter if expecting multiple args. */, "Debug parsing\n",
            "--debug-parsing");
 
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Parse smt2 files with the streaming parser, which runs each "
+           "command as soon as it is read.\n",
+           "--streaming-parser");
+
   opt_.add("false" /* Default */, false /* Required? */,
            0 /* Number of args expected. */,
            0 /* Delimiter if expecting multiple args. */,
@@ -175,6 +188,36 @@ void MainProgram::AddOptions() {
            " One of these (default = qsoptex): qsoptex, soplex.\n",
            "--lp-solver", lp_solver_option_validator);
 
+  auto* const sat_solver_option_validator = new ez::ezOptionValidator(
+      "t", "in", "picosat,cadical");
+  opt_.add("picosat" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "SAT solver to use."
+           " One of these (default = picosat): picosat, cadical.\n"
+           "cadical checks partial assignments with the LP solver during the"
+           " search, and requires --lp-solver soplex.\n",
+           "--sat-solver", sat_solver_option_validator);
+
+  auto* const online_check_period_option_validator =
+      new ez::ezOptionValidator("s4" /* 4byte integer */, "ge", "0");
+  opt_.add("1" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "With --sat-solver cadical, check and propagate partial"
+           " assignments every N-th decision level (0 = complete assignments"
+           " only).\n",
+           "--online-check-period", online_check_period_option_validator);
+
+  auto* const lp_explanation_option_validator = new ez::ezOptionValidator(
+      "t", "in", "assertions,farkas,minimal");
+  opt_.add("farkas" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Explanation learned when the LP is infeasible."
+           " One of these (default = farkas): assertions, farkas, minimal.\n",
+           "--lp-explanation", lp_explanation_option_validator);
+
   auto* const verbose_simplex_option_validator = new ez::ezOptionValidator(
       "s4", "in", "0,1,2,3,4,5");
   opt_.add("0" /* Default */, false /* Required? */,
@@ -184,6 +227,21 @@ void MainProgram::AddOptions() {
            "One of these (default = 0): 0, 1, 2, 3, 4, 5.\n",
            "--verbose-simplex", verbose_simplex_option_validator);
 
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Keep the simplex basis between theory checks and only update"
+           " the constraints which changed (SoPlex only).\n",
+           "--simplex-warm-start");
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "When optimizing, add the best objective value found so far as a"
+           " cutoff to the LP, so that regions which can't improve on it are"
+           " pruned (QSopt_ex only).\n",
+           "--opt-cutoff");
+
   opt_.add("false" /* Default */, false /* Required? */,
            0 /* Number of args expected. */,
            0 /* Delimiter if expecting multiple args. */,
@@ -198,9 +256,28 @@ void MainProgram::AddOptions() {
 
   opt_.add("1" /* Default */, false /* Required? */,
            1 /* Number of args expected. */,
-           0 /* Delimiter if expecting multiple args. */, "Number of jobs.\n",
+           0 /* Delimiter if expecting multiple args. */,
+           "Number of jobs. With more than one job, as many diversified\n"
+           "instances of the solver (random seed, SAT default phase and\n"
+           "simplex phase) run in parallel, and the first answer wins.\n",
            "--jobs", "-j");
 
+  auto* const max_shared_clause_size_option_validator =
+      new ez::ezOptionValidator("s4" /* 4byte integer */, "ge", "0");
+  opt_.add("8" /* Default */, false /* Required? */,
+           1 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "With --jobs, the longest learned clause which the parallel"
+           " instances share with each other (0 = no sharing).\n",
+           "--max-shared-clause-size", max_shared_clause_size_option_validator);
+
+  opt_.add("false" /* Default */, false /* Required? */,
+           0 /* Number of args expected. */,
+           0 /* Delimiter if expecting multiple args. */,
+           "Share a single copy of structurally equal terms, which makes\n"
+           "comparing them a pointer comparison.\n",
+           "--hash-consing");
+
   const string kDefaultNloptFtolRel{
       fmt::format("{}", Config::kDefaultNloptFtolRel)};
   opt_.add(kDefaultNloptFtolRel.c_str() /* Default */, false /* Required? */,
@@ -415,6 +492,24 @@ void MainProgram::ExtractOptions() {
                     config_.number_of_jobs());
   }
 
+  // --max-shared-clause-size
+  if (opt_.isSet("--max-shared-clause-size")) {
+    int max_shared_clause_size{8};
+    opt_.get("--max-shared-clause-size")->getInt(max_shared_clause_size);
+    config_.mutable_max_shared_clause_size().set_from_command_line(
+        max_shared_clause_size);
+    DREAL_LOG_DEBUG(
+        "MainProgram::ExtractOptions() --max-shared-clause-size = {}",
+        config_.max_shared_clause_size());
+  }
+
+  // --hash-consing
+  if (opt_.isSet("--hash-consing")) {
+    config_.mutable_hash_consing().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --hash-consing = {}",
+                    config_.hash_consing());
+  }
+
   // --forall-polytope
   if (opt_.isSet("--forall-polytope")) {
     config_.mutable_use_polytope_in_forall().set_from_command_line(true);
@@ -456,6 +551,42 @@ void MainProgram::ExtractOptions() {
                     config_.lp_solver(), lp_solver);
   }
 
+  // --sat-solver
+  if (opt_.isSet("--sat-solver")) {
+    string sat_solver;
+    opt_.get("--sat-solver")->getString(sat_solver);
+    Config::SatSolver val = sat_solver == "cadical" ? Config::CADICAL
+                                                    : Config::PICOSAT;
+    config_.mutable_sat_solver().set_from_command_line(val);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --sat-solver = {} ({})",
+                    config_.sat_solver(), sat_solver);
+  }
+
+  // --online-check-period
+  if (opt_.isSet("--online-check-period")) {
+    int online_check_period{1};
+    opt_.get("--online-check-period")->getInt(online_check_period);
+    config_.mutable_online_check_period().set_from_command_line(
+        online_check_period);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --online-check-period = {}",
+                    config_.online_check_period());
+  }
+
+  // --lp-explanation
+  if (opt_.isSet("--lp-explanation")) {
+    string lp_explanation;
+    opt_.get("--lp-explanation")->getString(lp_explanation);
+    Config::LPExplanation val = Config::LPExplanation::Farkas;
+    if (lp_explanation == "assertions") {
+      val = Config::LPExplanation::Assertions;
+    } else if (lp_explanation == "minimal") {
+      val = Config::LPExplanation::Minimal;
+    }
+    config_.mutable_lp_explanation().set_from_command_line(val);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --lp-explanation = {}",
+                    config_.lp_explanation());
+  }
+
   // --verbose-simplex
   if (opt_.isSet("--verbose-simplex")) {
     int verbose_simplex{0};
@@ -465,6 +596,20 @@ void MainProgram::ExtractOptions() {
                     config_.verbose_simplex());
   }
 
+  // --simplex-warm-start
+  if (opt_.isSet("--simplex-warm-start")) {
+    config_.mutable_simplex_warm_start().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --simplex-warm-start = {}",
+                    config_.simplex_warm_start());
+  }
+
+  // --opt-cutoff
+  if (opt_.isSet("--opt-cutoff")) {
+    config_.mutable_objective_cutoff().set_from_command_line(true);
+    DREAL_LOG_DEBUG("MainProgram::ExtractOptions() --opt-cutoff = {}",
+                    config_.objective_cutoff());
+  }
+
   // --continuous-output
   if (opt_.isSet("--continuous-output")) {
     config_.mutable_continuous_output().set_from_command_line(true);
@@ -551,6 +696,7 @@ void MainProgram::Init() {
     throw DREAL_RUNTIME_ERROR("SoPlex not enabled at compile time");
 #endif
   }
+  set_hash_consing(config_.hash_consing());
   Expression::InitConstants();
 }
 
@@ -596,7 +742,7 @@ int MainProgram::Run() {
       (format_opt == "auto" && (extension == "smt2" || opt_.isSet("--in")))) {
     Init();
     RunSmt2(filename, config_, opt_.isSet("--debug-scanning"),
-            opt_.isSet("--debug-parsing"));
+            opt_.isSet("--debug-parsing"), opt_.isSet("--streaming-parser"));
     DeInit();
   } else if (format_opt == "dr" ||
              (format_opt == "auto" && extension == "dr")) {
@@ -728,6 +728,12 @@ PYBIND11_MODULE(_dreal_py, m) {
              SignalHandlerGuard guard{SIGINT, &sigint_handler, &g_interrupted};
              return self.CheckSat();
            })
+      .def("CheckSatAssuming",
+           [](Context& self, const std::vector<Formula>& assumptions) {
+             SignalHandlerGuard guard{SIGINT, &sigint_handler, &g_interrupted};
+             mpq_class actual_precision{self.config().precision()};
+             return self.CheckSatAssuming(assumptions, &actual_precision);
+           })
       .def("DeclareVariable",
            [](Context& self, const Variable& v) {
              return self.DeclareVariable(v);
@@ -740,6 +746,7 @@ PYBIND11_MODULE(_dreal_py, m) {
            [](Context& self, const Expression& f) { return self.Minimize(f); })
       .def("Maximize",
            [](Context& self, const Expression& f) { return self.Maximize(f); })
+      .def("GetUnsatAssumptions", &Context::GetUnsatAssumptions)
       .def("Pop", &Context::Pop)
       .def("Push", &Context::Push)
       .def("SetInfo",
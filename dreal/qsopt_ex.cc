@@ -4,6 +4,7 @@
 #include "dreal/qsopt_ex.h"
 
 using std::string;
+using std::vector;
 using std::fprintf;
 using std::exit;
 
@@ -45,6 +46,40 @@ MpqArray::~MpqArray() {
     mpq_EGlpNumFreeArray(array);
 }
 
+vector<mpq_class> TransposeTimes(mpq_QSprob prob, const mpq_t* y) {
+    const int rowcount = mpq_QSget_rowcount(prob);
+    const int colcount = mpq_QSget_colcount(prob);
+    vector<mpq_class> result(colcount);
+    vector<int> rowlist;
+    for (int i = 0; i < rowcount; ++i) {
+        if (mpq_sgn(y[i]) != 0) {
+            rowlist.push_back(i);
+        }
+    }
+    if (rowlist.empty()) {
+        return result;
+    }
+    int* rowcnt = nullptr;
+    int* rowbeg = nullptr;
+    int* rowind = nullptr;
+    mpq_t* rowval = nullptr;
+    const int status = mpq_QSget_rows_list(
+        prob, static_cast<int>(rowlist.size()), rowlist.data(), &rowcnt,
+        &rowbeg, &rowind, &rowval, nullptr, nullptr, nullptr, nullptr);
+    EXIT(status, "mpq_QSget_rows_list returned %d\n", status);
+    for (size_t k = 0; k < rowlist.size(); ++k) {
+        const mpq_t& y_i = y[rowlist[k]];
+        for (int j = rowbeg[k]; j < rowbeg[k] + rowcnt[k]; ++j) {
+            result[rowind[j]] += mpq_class(y_i) * mpq_class(rowval[j]);
+        }
+    }
+    mpq_QSfree(rowcnt);
+    mpq_QSfree(rowbeg);
+    mpq_QSfree(rowind);
+    mpq_EGlpNumFreeArray(rowval);
+    return result;
+}
+
 void QSXStart() {
   QSexactStart();
 }
@@ -24,6 +24,8 @@
 #include <unistd.h>
 
 #include <string>
+#include <vector>
+
 #include <gmpxx.h>
 
 namespace dreal {
@@ -54,6 +56,10 @@ class MpqArray {
   mpq_t* array;
 };
 
+/// Returns yᵀA, where A is the constraint matrix of @p prob and @p y holds
+/// one multiplier per row. Rows with a zero multiplier are not fetched.
+std::vector<mpq_class> TransposeTimes(mpq_QSprob prob, const mpq_t* y);
+
 void QSXStart();
 void QSXFinish();
 
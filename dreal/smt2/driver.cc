@@ -1,5 +1,8 @@
 #include "dreal/smt2/driver.h"
 
+#include <unistd.h>
+
+#include <cstdio>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -9,6 +12,8 @@
 #include <limits>
 
 #include "dreal/smt2/scanner.h"
+#include "dreal/smt2/stream_parser.h"
+#include "dreal/symbolic/prefix_printer.h"
 #include "dreal/util/timer.h"
 
 namespace dreal {
@@ -32,6 +37,13 @@ Smt2Driver::Smt2Driver(Context context) : context_{std::move(context)} {}
 bool Smt2Driver::parse_stream(istream& in, const string& sname) {
   streamname_ = sname;
 
+  if (streaming_) {
+    Smt2StreamParser parser{this};
+    // A script typed on a terminal is run command by command.
+    const bool interactive{&in == &cin && isatty(fileno(stdin))};
+    return parser.Parse(&in, sname, interactive);
+  }
+
   Smt2Scanner scanner(&in);
   scanner.set_debug(trace_scanning_);
   this->scanner_ = &scanner;
@@ -91,22 +103,47 @@ void Smt2Driver::CheckSat() {
   } else {
     mpq_class actual_precision = context_.config().precision();
     const optional<Box> model{context_.CheckSat(&actual_precision)};
-    double actual_precision_upper = nextafter(actual_precision.get_d(),
-                                              numeric_limits<double>::infinity());
-    if (model) {
-      // fmt::print uses shortest round-trip format for doubles, by default
-      fmt::print("delta-sat with delta = {} ( > {})",
-                 actual_precision_upper, actual_precision);
-    } else {
-      fmt::print("unsat");
-    }
-    if (context_.config().with_timings()) {
-      fmt::print(" after {} seconds", main_timer.seconds());
-    }
-    fmt::print("\n");
-    if (model && context_.config().produce_models()) {
-      fmt::print("{}\n", *model);
+    PrintSatResult(model, actual_precision);
+  }
+}
+
+void Smt2Driver::CheckSatAssuming(const vector<Formula>& assumptions) {
+  mpq_class actual_precision = context_.config().precision();
+  const optional<Box> model{
+      context_.CheckSatAssuming(assumptions, &actual_precision)};
+  PrintSatResult(model, actual_precision);
+}
+
+void Smt2Driver::GetUnsatAssumptions() {
+  cout << "(";
+  bool first{true};
+  for (const Formula& f : context_.GetUnsatAssumptions()) {
+    if (!first) {
+      cout << " ";
     }
+    first = false;
+    cout << ToPrefix(f);
+  }
+  cout << ")" << endl;
+}
+
+void Smt2Driver::PrintSatResult(const optional<Box>& model,
+                                const mpq_class& actual_precision) {
+  double actual_precision_upper = nextafter(actual_precision.get_d(),
+                                            numeric_limits<double>::infinity());
+  if (model) {
+    // fmt::print uses shortest round-trip format for doubles, by default
+    fmt::print("delta-sat with delta = {} ( > {})",
+               actual_precision_upper, actual_precision);
+  } else {
+    fmt::print("unsat");
+  }
+  if (context_.config().with_timings()) {
+    fmt::print(" after {} seconds", main_timer.seconds());
+  }
+  fmt::print("\n");
+  if (model && context_.config().produce_models()) {
+    fmt::print("{}\n", *model);
   }
 }
 
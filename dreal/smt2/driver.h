@@ -61,6 +61,14 @@ class Smt2Driver {
   /// Calls context_.CheckSat() and print proper output messages to cout.
   void CheckSat();
 
+  /// Calls context_.CheckSatAssuming() with @p assumptions and print proper
+  /// output messages to cout.
+  void CheckSatAssuming(const std::vector<Formula>& assumptions);
+
+  /// Prints the assumptions of the last check-sat-assuming command which
+  /// were used to show UNSAT.
+  void GetUnsatAssumptions();
+
   /// Register a variable with name @p name and sort @p s in the scope. Note
   /// that it does not declare the variable in the context.
   Variable RegisterVariable(const std::string& name, Sort sort);
@@ -116,6 +124,11 @@ class Smt2Driver {
   bool trace_parsing() const { return trace_parsing_; }
   void set_trace_parsing(bool b) { trace_parsing_ = b; }
 
+  /// Whether parse_stream uses Smt2StreamParser instead of the flex scanner
+  /// and the bison parser.
+  bool streaming() const { return streaming_; }
+  void set_streaming(bool b) { streaming_ = b; }
+
   Context& mutable_context() { return context_; }
 
   std::string& mutable_streamname() { return streamname_; }
@@ -125,12 +138,19 @@ class Smt2Driver {
   Smt2Scanner* scanner_{nullptr};
 
  private:
+  /// Prints the result of a satisfiability check to cout.
+  void PrintSatResult(const optional<Box>& model,
+                      const mpq_class& actual_precision);
+
   /// enable debug output in the flex scanner
   bool trace_scanning_{false};
 
   /// enable debug output in the bison parser
   bool trace_parsing_{false};
 
+  /// use Smt2StreamParser
+  bool streaming_{false};
+
   /** Scoped map from a string to a corresponding Variable or constant Expression. */
   ScopedUnorderedMap<std::string, VariableOrConstant> scope_;
 
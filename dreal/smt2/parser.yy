@@ -138,17 +138,21 @@ using dreal::qsopt_ex::StringToMpq;
 script:         command_list END
                 ;
 
+/* Left recursion keeps the parser stack bounded by the depth of a single
+ * command, however many commands the script has. */
 command_list:   command
-        |       command command_list
+        |       command_list command
                 ;
 
 command:
                 command_assert
         |       command_check_sat
+        |       command_check_sat_assuming
         |       command_declare_fun
         |       command_define_fun
         |       command_exit
         |       command_get_model
+        |       command_get_unsat_assumptions
         |       command_maximize
         |       command_minimize
         |       command_pop
@@ -168,6 +172,26 @@ command_check_sat:
                     driver.CheckSat();
                 }
                 ;
+command_check_sat_assuming:
+                '(' TK_CHECK_SAT_ASSUMING '(' ')' ')' {
+                    driver.CheckSatAssuming({});
+                }
+        |       '(' TK_CHECK_SAT_ASSUMING '(' term_list ')' ')' {
+                    std::vector<Formula> assumptions;
+                    for (const Term& t : *$4) {
+                        if (t.type() != Term::Type::FORMULA) {
+                            std::cerr << @4 << " : check-sat-assuming expects "
+                                      << "Boolean terms, but got " << t
+                                      << std::endl;
+                            delete $4;
+                            YYABORT;
+                        }
+                        assumptions.push_back(t.formula());
+                    }
+                    driver.CheckSatAssuming(assumptions);
+                    delete $4;
+                }
+                ;
 command_declare_fun:
                 '(' TK_DECLARE_FUN SYMBOL '(' ')' sort ')' {
                     driver.DeclareVariable(*$3, $6);
@@ -218,6 +242,12 @@ command_get_model:
                 }
                 ;
 
+command_get_unsat_assumptions:
+                '(' TK_GET_UNSAT_ASSUMPTIONS ')' {
+                    driver.GetUnsatAssumptions();
+                }
+                ;
+
 command_maximize: '(' TK_MAXIMIZE term ')' {
                       driver.mutable_context().Maximize($3->expression());
                       delete $3;
@@ -331,19 +361,21 @@ term:           TK_TRUE { $$ = new Term(Formula::True()); }
         |       '('TK_GT term term ')' { $$ = new Term($3->expression() > $4->expression()); delete $3; delete $4; }
         |       '('TK_GTE term term ')' { $$ = new Term($3->expression() >= $4->expression()); delete $3; delete $4; }
         |       '('TK_AND term_list ')' {
-            Formula f = Formula::True();
+            std::vector<Formula> operands;
+            operands.reserve($3->size());
             for (const Term& t : *$3) {
-                f = f && t.formula();
+                operands.push_back(t.formula());
             }
-            $$ = new Term(f);
+            $$ = new Term(make_conjunction(operands));
             delete $3;
         }
         |       '('TK_OR term_list ')' {
-            Formula f = Formula::False();
+            std::vector<Formula> operands;
+            operands.reserve($3->size());
             for (const Term& t : *$3) {
-                f = f || t.formula();
+                operands.push_back(t.formula());
             }
-            $$ = new Term(f);
+            $$ = new Term(make_disjunction(operands));
             delete $3;
         }
         |       '('TK_XOR term_list ')' {
@@ -8,7 +8,8 @@ namespace dreal {
 using std::string;
 
 void RunSmt2(const string& filename, const Config& config,
-             const bool debug_scanning, const bool debug_parsing) {
+             const bool debug_scanning, const bool debug_parsing,
+             const bool streaming) {
   Smt2Driver smt2_driver{Context{config}};
   // Set up --debug-scanning option.
   smt2_driver.set_trace_scanning(debug_scanning);
@@ -18,6 +19,10 @@ void RunSmt2(const string& filename, const Config& config,
   smt2_driver.set_trace_parsing(debug_parsing);
   DREAL_LOG_DEBUG("RunSmt2() --debug-parsing = {}",
                   smt2_driver.trace_parsing());
+  // Set up --streaming-parser option.
+  smt2_driver.set_streaming(streaming);
+  DREAL_LOG_DEBUG("RunSmt2() --streaming-parser = {}",
+                  smt2_driver.streaming());
   smt2_driver.parse_file(filename);
 }
 }  // namespace dreal
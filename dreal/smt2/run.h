@@ -7,6 +7,6 @@
 namespace dreal {
 
 void RunSmt2(const std::string& filename, const Config& config,
-             bool debug_scanning, bool debug_parsing);
+             bool debug_scanning, bool debug_parsing, bool streaming = false);
 
 }  // namespace dreal
@@ -0,0 +1,813 @@
+#include "dreal/smt2/stream_parser.h"
+
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "dreal/smt2/driver.h"
+#include "dreal/smt2/logic.h"
+#include "dreal/smt2/sort.h"
+#include "dreal/util/assert.h"
+
+namespace dreal {
+
+using std::istream;
+using std::string;
+using std::tuple;
+using std::vector;
+
+using Kind = Smt2Tokenizer::Kind;
+
+namespace {
+
+// The symbols which are not reserved words are forgotten between two
+// commands once there are more of them.
+constexpr size_t kMaxInternedSymbols{1 << 16};
+
+// The size of the buffer through which the input is read.
+constexpr size_t kBufferSize{1 << 16};
+
+// Returns the minimum and the maximum numbers of arguments of the function
+// @p builtin, or {-1, -1} if it is not a function.
+std::pair<int, int> GetArity(const Smt2Builtin builtin) {
+  constexpr int kMany{std::numeric_limits<int>::max()};
+  switch (builtin) {
+    case Smt2Builtin::Not:
+    case Smt2Builtin::Exp:
+    case Smt2Builtin::Log:
+    case Smt2Builtin::Abs:
+    case Smt2Builtin::Sin:
+    case Smt2Builtin::Cos:
+    case Smt2Builtin::Tan:
+    case Smt2Builtin::Asin:
+    case Smt2Builtin::Acos:
+    case Smt2Builtin::Atan:
+    case Smt2Builtin::Sinh:
+    case Smt2Builtin::Cosh:
+    case Smt2Builtin::Tanh:
+    case Smt2Builtin::Sqrt:
+      return {1, 1};
+    case Smt2Builtin::Implies:
+    case Smt2Builtin::Eq:
+    case Smt2Builtin::Lt:
+    case Smt2Builtin::Lte:
+    case Smt2Builtin::Gt:
+    case Smt2Builtin::Gte:
+    case Smt2Builtin::Atan2:
+    case Smt2Builtin::Min:
+    case Smt2Builtin::Max:
+    case Smt2Builtin::Pow:
+      return {2, 2};
+    case Smt2Builtin::Ite:
+      return {3, 3};
+    case Smt2Builtin::And:
+    case Smt2Builtin::Or:
+    case Smt2Builtin::Xor:
+    case Smt2Builtin::Plus:
+    case Smt2Builtin::Minus:
+      return {1, kMany};
+    case Smt2Builtin::Times:
+    case Smt2Builtin::Div:
+      return {2, kMany};
+    default:
+      return {-1, -1};
+  }
+}
+
+}  // namespace
+
+Smt2StreamParser::Smt2StreamParser(Smt2Driver* const driver)
+    : driver_{driver} {
+  DREAL_ASSERT(driver_ != nullptr);
+}
+
+bool Smt2StreamParser::Parse(istream* const in, const string& sname,
+                             const bool interactive) {
+  Smt2Tokenizer tokenizer{in, kBufferSize, interactive};
+  tokenizer_ = &tokenizer;
+  streamname_ = sname;
+  bool ok{true};
+  while (ok && tokenizer.Next() != Kind::End) {
+    ok = Expect(Kind::LeftParen) && ParseCommand();
+    terms_.clear();
+    frames_.clear();
+    let_names_.clear();
+    quantifiers_.clear();
+    tokenizer.TrimSymbols(kMaxInternedSymbols);
+  }
+  tokenizer_ = nullptr;
+  return ok;
+}
+
+bool Smt2StreamParser::ParseCommand() {
+  if (!ExpectNext(Kind::Symbol)) {
+    return false;
+  }
+  Context& context{driver_->mutable_context()};
+  const Smt2Builtin command{tokenizer_->symbol().builtin};
+  switch (command) {
+    case Smt2Builtin::Assert:
+      tokenizer_->Next();
+      if (!ParseTerm() || !ExpectNext(Kind::RightParen)) {
+        return false;
+      }
+      context.Assert(terms_.back().formula());
+      return true;
+
+    case Smt2Builtin::CheckSat:
+      if (!ExpectNext(Kind::RightParen)) {
+        return false;
+      }
+      driver_->CheckSat();
+      return true;
+
+    case Smt2Builtin::CheckSatAssuming: {
+      if (!ExpectNext(Kind::LeftParen)) {
+        return false;
+      }
+      vector<tuple<int, int>> positions;
+      while (tokenizer_->Next() != Kind::RightParen) {
+        positions.emplace_back(tokenizer_->line(), tokenizer_->column());
+        if (!ParseTerm()) {
+          return false;
+        }
+      }
+      if (!ExpectNext(Kind::RightParen)) {
+        return false;
+      }
+      vector<Formula> assumptions;
+      assumptions.reserve(terms_.size());
+      for (size_t i = 0; i < terms_.size(); ++i) {
+        if (terms_[i].type() != Term::Type::FORMULA) {
+          return Error(std::get<0>(positions[i]), std::get<1>(positions[i]),
+                       fmt::format("check-sat-assuming expects Boolean "
+                                   "terms, but got {}",
+                                   terms_[i]));
+        }
+        assumptions.push_back(terms_[i].formula());
+      }
+      driver_->CheckSatAssuming(assumptions);
+      return true;
+    }
+
+    case Smt2Builtin::DeclareConst:
+    case Smt2Builtin::DeclareFun: {
+      if (!ExpectNextName()) {
+        return false;
+      }
+      // The interned symbols are kept until the end of the command.
+      const string& name{tokenizer_->symbol().name};
+      if (command == Smt2Builtin::DeclareFun &&
+          (!ExpectNext(Kind::LeftParen) || !ExpectNext(Kind::RightParen))) {
+        return false;
+      }
+      if (!ExpectNext(Kind::Symbol)) {
+        return false;
+      }
+      const Sort sort{ParseSort(tokenizer_->symbol().name)};
+      bool has_bounds{false};
+      if (!ParseBounds(&has_bounds) || !Expect(Kind::RightParen)) {
+        return false;
+      }
+      if (has_bounds) {
+        driver_->DeclareVariable(name, sort, terms_[0], terms_[1]);
+      } else {
+        driver_->DeclareVariable(name, sort);
+      }
+      return true;
+    }
+
+    case Smt2Builtin::DefineFun: {
+      if (!ExpectNextName()) {
+        return false;
+      }
+      const string& name{tokenizer_->symbol().name};
+      if (!ExpectNext(Kind::LeftParen) || !ExpectNext(Kind::RightParen) ||
+          !ExpectNext(Kind::Symbol)) {
+        return false;
+      }
+      const Sort sort{ParseSort(tokenizer_->symbol().name)};
+      tokenizer_->Next();
+      if (!ParseTerm() || !ExpectNext(Kind::RightParen)) {
+        return false;
+      }
+      const Variable v{driver_->DeclareVariable(name, sort)};
+      const Term& t{terms_.back()};
+      if (t.type() == Term::Type::FORMULA) {
+        context.Assert(v == t.formula());
+      } else {
+        context.Assert(v == t.expression());
+      }
+      return true;
+    }
+
+    case Smt2Builtin::Exit:
+      if (!ExpectNext(Kind::RightParen)) {
+        return false;
+      }
+      context.Exit();
+      return true;
+
+    case Smt2Builtin::GetModel:
+      if (!ExpectNext(Kind::RightParen)) {
+        return false;
+      }
+      driver_->GetModel();
+      return true;
+
+    case Smt2Builtin::GetUnsatAssumptions:
+      if (!ExpectNext(Kind::RightParen)) {
+        return false;
+      }
+      driver_->GetUnsatAssumptions();
+      return true;
+
+    case Smt2Builtin::Maximize:
+    case Smt2Builtin::Minimize:
+      tokenizer_->Next();
+      if (!ParseTerm() || !ExpectNext(Kind::RightParen)) {
+        return false;
+      }
+      if (command == Smt2Builtin::Maximize) {
+        context.Maximize(terms_.back().expression());
+      } else {
+        context.Minimize(terms_.back().expression());
+      }
+      return true;
+
+    case Smt2Builtin::Push:
+    case Smt2Builtin::Pop: {
+      if (!ExpectNext(Kind::Number)) {
+        return false;
+      }
+      if (!tokenizer_->is_integer()) {
+        return SyntaxError();
+      }
+      if (!tokenizer_->number().get_num().fits_sint_p()) {
+        return Error(fmt::format("{} does not fit in an int.",
+                                 tokenizer_->text()));
+      }
+      const int n{static_cast<int>(tokenizer_->number().get_num().get_si())};
+      if (!ExpectNext(Kind::RightParen)) {
+        return false;
+      }
+      if (command == Smt2Builtin::Push) {
+        context.Push(n);
+      } else {
+        context.Pop(n);
+      }
+      return true;
+    }
+
+    case Smt2Builtin::SetInfo:
+    case Smt2Builtin::SetOption: {
+      if (!ExpectNext(Kind::Keyword)) {
+        return false;
+      }
+      const string key{tokenizer_->text()};
+      string value;
+      double number{0};
+      switch (tokenizer_->Next()) {
+        case Kind::Symbol:
+          value = tokenizer_->symbol().name;
+          break;
+        case Kind::String:
+          if (command != Smt2Builtin::SetInfo) {
+            return SyntaxError();
+          }
+          value = tokenizer_->text();
+          break;
+        case Kind::Number:
+          number = std::stod(tokenizer_->text());
+          break;
+        default:
+          return SyntaxError();
+      }
+      const bool is_number{tokenizer_->kind() == Kind::Number};
+      if (!ExpectNext(Kind::RightParen)) {
+        return false;
+      }
+      if (command == Smt2Builtin::SetInfo && is_number) {
+        context.SetInfo(key, number);
+      } else if (command == Smt2Builtin::SetInfo) {
+        context.SetInfo(key, value);
+      } else if (is_number) {
+        context.SetOption(key, number);
+      } else {
+        context.SetOption(key, value);
+      }
+      return true;
+    }
+
+    case Smt2Builtin::SetLogic: {
+      if (!ExpectNext(Kind::Symbol)) {
+        return false;
+      }
+      const Logic logic{parse_logic(tokenizer_->symbol().name)};
+      if (!ExpectNext(Kind::RightParen)) {
+        return false;
+      }
+      context.SetLogic(logic);
+      return true;
+    }
+
+    default:
+      return SyntaxError();
+  }
+}
+
+bool Smt2StreamParser::ParseTerm() {
+  const size_t frame_base{frames_.size()};
+  // Whether a term has just been pushed to terms_. Otherwise, the current
+  // token starts a term.
+  bool completed{false};
+  while (true) {
+    if (completed) {
+      if (frames_.size() == frame_base) {
+        return true;
+      }
+      completed = false;
+      tokenizer_->Next();
+      Frame& frame{frames_.back()};
+      switch (frame.state) {
+        case Frame::State::Arguments:
+          if (tokenizer_->kind() == Kind::RightParen) {
+            if (!Apply(frame)) {
+              return false;
+            }
+            frames_.pop_back();
+            completed = true;
+          }
+          continue;
+        case Frame::State::LetBindings:
+          if (!Expect(Kind::RightParen)) {
+            return false;
+          }
+          tokenizer_->Next();
+          if (!NextLetBinding(&frame)) {
+            return false;
+          }
+          continue;
+        case Frame::State::LetBody:
+          if (!Expect(Kind::RightParen)) {
+            return false;
+          }
+          driver_->PopScope();
+          frames_.pop_back();
+          completed = true;
+          continue;
+        case Frame::State::ForallBody: {
+          if (!Expect(Kind::RightParen)) {
+            return false;
+          }
+          const Variables& vars{quantifiers_.back().first};
+          const Formula& domain{quantifiers_.back().second};
+          Term& body{terms_.back()};
+          body = Term{forall(vars, imply(domain, body.formula()))};
+          quantifiers_.pop_back();
+          driver_->PopScope();
+          frames_.pop_back();
+          completed = true;
+          continue;
+        }
+      }
+    }
+
+    switch (tokenizer_->kind()) {
+      case Kind::Number:
+        terms_.emplace_back(Expression{tokenizer_->number()});
+        completed = true;
+        continue;
+      case Kind::HexFloat:
+        terms_.emplace_back(Expression{tokenizer_->hexfloat()});
+        completed = true;
+        continue;
+      case Kind::Symbol:
+        if (!PushSymbol(tokenizer_->symbol())) {
+          return false;
+        }
+        completed = true;
+        continue;
+      case Kind::LeftParen:
+        break;
+      default:
+        return SyntaxError();
+    }
+
+    Frame frame{Frame::State::Arguments, nullptr,   terms_.size(),
+                let_names_.size(),        tokenizer_->line(),
+                tokenizer_->column()};
+    if (!ExpectNext(Kind::Symbol)) {
+      return false;
+    }
+    frame.symbol = &tokenizer_->symbol();
+    switch (frame.symbol->builtin) {
+      case Smt2Builtin::Let:
+        driver_->PushScope();
+        if (!ExpectNext(Kind::LeftParen)) {
+          return false;
+        }
+        frame.state = Frame::State::LetBindings;
+        frames_.push_back(frame);
+        tokenizer_->Next();
+        if (!NextLetBinding(&frames_.back())) {
+          return false;
+        }
+        continue;
+      case Smt2Builtin::Forall:
+        driver_->PushScope();
+        if (!ExpectNext(Kind::LeftParen) || !ParseSortedVariables()) {
+          return false;
+        }
+        frame.state = Frame::State::ForallBody;
+        frames_.push_back(frame);
+        tokenizer_->Next();
+        continue;
+      default:
+        if (GetArity(frame.symbol->builtin).first < 0) {
+          return SyntaxError();
+        }
+        frames_.push_back(frame);
+        // The next token is the first argument, or the ')' which is
+        // reported by Apply().
+        if (tokenizer_->Next() == Kind::RightParen) {
+          if (!Apply(frames_.back())) {
+            return false;
+          }
+          frames_.pop_back();
+          completed = true;
+        }
+        continue;
+    }
+  }
+}
+
+bool Smt2StreamParser::ParseBounds(bool* const has_bounds) {
+  *has_bounds = tokenizer_->Next() == Kind::LeftBracket;
+  if (!*has_bounds) {
+    return true;
+  }
+  tokenizer_->Next();
+  if (!ParseTerm() || !ExpectNext(Kind::Comma)) {
+    return false;
+  }
+  tokenizer_->Next();
+  if (!ParseTerm() || !ExpectNext(Kind::RightBracket)) {
+    return false;
+  }
+  tokenizer_->Next();
+  return true;
+}
+
+bool Smt2StreamParser::ParseSortedVariables() {
+  vector<tuple<Variable, Expression, Expression>> sorted_vars;
+  while (tokenizer_->Next() == Kind::LeftParen) {
+    if (!ExpectNextName()) {
+      return false;
+    }
+    const string& name{tokenizer_->symbol().name};
+    if (!ExpectNext(Kind::Symbol)) {
+      return false;
+    }
+    const Sort sort{ParseSort(tokenizer_->symbol().name)};
+    bool has_bounds{false};
+    if (!ParseBounds(&has_bounds) || !Expect(Kind::RightParen)) {
+      return false;
+    }
+    const Variable v{driver_->RegisterVariable(name, sort)};
+    if (has_bounds) {
+      const size_t n{terms_.size()};
+      const Expression lb{terms_[n - 2].expression().Evaluate()};
+      const Expression ub{terms_[n - 1].expression().Evaluate()};
+      terms_.erase(terms_.end() - 2, terms_.end());
+      sorted_vars.emplace_back(v, lb, ub);
+    } else {
+      sorted_vars.emplace_back(v, Expression::NInfty(), Expression::Infty());
+    }
+  }
+  if (!Expect(Kind::RightParen)) {
+    return false;
+  }
+  // The domain is built from the last variable to the first one, as the
+  // bison parser does.
+  Variables vars;
+  Formula domain{Formula::True()};
+  for (auto it = sorted_vars.rbegin(); it != sorted_vars.rend(); ++it) {
+    const Variable& v{std::get<0>(*it)};
+    const Expression& lb{std::get<1>(*it)};
+    const Expression& ub{std::get<2>(*it)};
+    vars.insert(v);
+    if (!is_infinite(lb)) {
+      domain = domain && (get_constant_value(lb) <= v);
+    }
+    if (!is_infinite(ub)) {
+      domain = domain && (v <= get_constant_value(ub));
+    }
+  }
+  quantifiers_.emplace_back(vars, domain);
+  return true;
+}
+
+bool Smt2StreamParser::NextLetBinding(Frame* const frame) {
+  if (tokenizer_->kind() == Kind::RightParen) {
+    BindLetNames(*frame);
+    frame->state = Frame::State::LetBody;
+    tokenizer_->Next();
+    return true;
+  }
+  if (!Expect(Kind::LeftParen) || !ExpectNextName()) {
+    return false;
+  }
+  let_names_.push_back(&tokenizer_->symbol().name);
+  tokenizer_->Next();
+  return true;
+}
+
+void Smt2StreamParser::BindLetNames(const Frame& frame) {
+  // Locals must be bound simultaneously. They are bound from the last one
+  // to the first one, as the bison parser does.
+  Context& context{driver_->mutable_context()};
+  for (size_t i = let_names_.size(); i-- > frame.first_name;) {
+    const string& name{*let_names_[i]};
+    const Term& term{terms_[frame.first_term + (i - frame.first_name)]};
+    if (term.type() == Term::Type::FORMULA) {
+      const Variable v{driver_->DeclareLocalVariable(name, Sort::Bool)};
+      const Formula fv{v};
+      const Formula& ft{term.formula()};
+      context.Assert((fv && ft) || (!fv && !ft));
+    } else if (is_constant(term.expression())) {
+      driver_->DefineLocalConstant(name, term.expression());
+    } else {
+      const Variable v{driver_->DeclareLocalVariable(name, Sort::Real)};
+      context.Assert(Expression{v} == term.expression());
+    }
+  }
+  terms_.erase(terms_.begin() + frame.first_term, terms_.end());
+  let_names_.resize(frame.first_name);
+}
+
+bool Smt2StreamParser::Apply(const Frame& frame) {
+  const Smt2Builtin builtin{frame.symbol->builtin};
+  const std::pair<int, int> arity{GetArity(builtin)};
+  const int n{static_cast<int>(terms_.size() - frame.first_term)};
+  if (n < arity.first || n > arity.second) {
+    return Error(frame.line, frame.column,
+                 fmt::format("wrong number of arguments to {}: {}",
+                             frame.symbol->name, n));
+  }
+  Term* const args{&terms_[frame.first_term]};
+  Term& result{args[0]};
+  switch (builtin) {
+    case Smt2Builtin::Eq: {
+      const Term& t1{args[0]};
+      const Term& t2{args[1]};
+      if (t1.type() == Term::Type::EXPRESSION &&
+          t2.type() == Term::Type::EXPRESSION) {
+        result = Term{t1.expression() == t2.expression()};
+      } else if (t1.type() == Term::Type::FORMULA &&
+                 t2.type() == Term::Type::FORMULA) {
+        //    (f1 = f2)
+        // -> (f1 ⇔ f2)
+        // -> (f1 ∧ f2) ∨ (¬f1 ∧ ¬f2)
+        result = Term{t1.formula() == t2.formula()};
+      } else {
+        return Error(frame.line, frame.column,
+                     fmt::format("Type mismatch in `t1 == t2`:\n"
+                                 "    t1 = {}\n"
+                                 "    t2 = {}",
+                                 t1, t2));
+      }
+      break;
+    }
+    case Smt2Builtin::Lt:
+      result = Term{args[0].expression() < args[1].expression()};
+      break;
+    case Smt2Builtin::Lte:
+      result = Term{args[0].expression() <= args[1].expression()};
+      break;
+    case Smt2Builtin::Gt:
+      result = Term{args[0].expression() > args[1].expression()};
+      break;
+    case Smt2Builtin::Gte:
+      result = Term{args[0].expression() >= args[1].expression()};
+      break;
+    case Smt2Builtin::And:
+    case Smt2Builtin::Or: {
+      vector<Formula> operands;
+      operands.reserve(n);
+      for (int i = 0; i < n; ++i) {
+        operands.push_back(args[i].formula());
+      }
+      result = Term{builtin == Smt2Builtin::And ? make_conjunction(operands)
+                                                : make_disjunction(operands)};
+      break;
+    }
+    case Smt2Builtin::Xor: {
+      Formula f{Formula::False()};
+      for (int i = 0; i < n; ++i) {
+        f = (f && !args[i].formula()) || (!f && args[i].formula());
+      }
+      result = Term{f};
+      break;
+    }
+    case Smt2Builtin::Not:
+      result = Term{!args[0].formula()};
+      break;
+    case Smt2Builtin::Implies:
+      result = Term{!args[0].formula() || args[1].formula()};
+      break;
+    case Smt2Builtin::Ite: {
+      const Formula& cond{args[0].formula()};
+      const Term& then_term{args[1]};
+      const Term& else_term{args[2]};
+      if (then_term.type() == Term::Type::EXPRESSION &&
+          else_term.type() == Term::Type::EXPRESSION) {
+        result = Term{if_then_else(cond, then_term.expression(),
+                                   else_term.expression())};
+      } else if (then_term.type() == Term::Type::FORMULA &&
+                 else_term.type() == Term::Type::FORMULA) {
+        //    if(cond) then f1 else f2
+        // -> (cond => f1) ∧ (¬cond => f2)
+        // -> (¬cond ∨ f1) ∧ (cond ∨ f2)
+        const Formula& f1{then_term.formula()};
+        const Formula& f2{else_term.formula()};
+        result = Term{(!cond || f1) && (cond || f2)};
+      } else {
+        return Error(frame.line, frame.column,
+                     fmt::format("Type mismatch in `if (c) then t1 else t2`:\n"
+                                 "    t1 = {}\n"
+                                 "    t2 = {}",
+                                 then_term, else_term));
+      }
+      break;
+    }
+    case Smt2Builtin::Plus:
+      for (int i = 1; i < n; ++i) {
+        result.mutable_expression() += args[i].expression();
+      }
+      break;
+    case Smt2Builtin::Minus:
+      if (n == 1) {
+        result = Term{-args[0].expression()};
+      }
+      for (int i = 1; i < n; ++i) {
+        result.mutable_expression() -= args[i].expression();
+      }
+      break;
+    case Smt2Builtin::Times:
+      for (int i = 1; i < n; ++i) {
+        result.mutable_expression() *= args[i].expression();
+      }
+      break;
+    case Smt2Builtin::Div:
+      for (int i = 1; i < n; ++i) {
+        result.mutable_expression() /= args[i].expression();
+      }
+      break;
+    case Smt2Builtin::Exp:
+      result = Term{exp(args[0].expression())};
+      break;
+    case Smt2Builtin::Log:
+      result = Term{log(args[0].expression())};
+      break;
+    case Smt2Builtin::Abs:
+      result = Term{abs(args[0].expression())};
+      break;
+    case Smt2Builtin::Sin:
+      result = Term{sin(args[0].expression())};
+      break;
+    case Smt2Builtin::Cos:
+      result = Term{cos(args[0].expression())};
+      break;
+    case Smt2Builtin::Tan:
+      result = Term{tan(args[0].expression())};
+      break;
+    case Smt2Builtin::Asin:
+      result = Term{asin(args[0].expression())};
+      break;
+    case Smt2Builtin::Acos:
+      result = Term{acos(args[0].expression())};
+      break;
+    case Smt2Builtin::Atan:
+      result = Term{atan(args[0].expression())};
+      break;
+    case Smt2Builtin::Atan2:
+      result = Term{atan2(args[0].expression(), args[1].expression())};
+      break;
+    case Smt2Builtin::Sinh:
+      result = Term{sinh(args[0].expression())};
+      break;
+    case Smt2Builtin::Cosh:
+      result = Term{cosh(args[0].expression())};
+      break;
+    case Smt2Builtin::Tanh:
+      result = Term{tanh(args[0].expression())};
+      break;
+    case Smt2Builtin::Min:
+      result = Term{min(args[0].expression(), args[1].expression())};
+      break;
+    case Smt2Builtin::Max:
+      result = Term{max(args[0].expression(), args[1].expression())};
+      break;
+    case Smt2Builtin::Sqrt:
+      result = Term{sqrt(args[0].expression())};
+      break;
+    case Smt2Builtin::Pow:
+      result = Term{pow(args[0].expression(), args[1].expression())};
+      break;
+    default:
+      DREAL_UNREACHABLE();
+  }
+  terms_.erase(terms_.begin() + frame.first_term + 1, terms_.end());
+  return true;
+}
+
+bool Smt2StreamParser::PushSymbol(const Smt2Symbol& symbol) {
+  switch (symbol.builtin) {
+    case Smt2Builtin::True:
+      terms_.emplace_back(Formula::True());
+      return true;
+    case Smt2Builtin::False:
+      terms_.emplace_back(Formula::False());
+      return true;
+    case Smt2Builtin::None:
+      break;
+    default:
+      return SyntaxError();
+  }
+  try {
+    const Smt2Driver::VariableOrConstant& voc{
+        driver_->lookup_variable(symbol.name)};
+    if (!voc.is_variable()) {
+      DREAL_ASSERT(is_constant(voc.expression()));
+      terms_.emplace_back(voc.expression());
+    } else if (voc.variable().get_type() == Variable::Type::BOOLEAN) {
+      terms_.emplace_back(Formula{voc.variable()});
+    } else {
+      terms_.emplace_back(Expression{voc.variable()});
+    }
+  } catch (std::runtime_error& e) {
+    return Error(e.what());
+  }
+  return true;
+}
+
+bool Smt2StreamParser::ExpectNext(const Kind kind) {
+  tokenizer_->Next();
+  return Expect(kind);
+}
+
+bool Smt2StreamParser::ExpectNextName() {
+  if (!ExpectNext(Kind::Symbol)) {
+    return false;
+  }
+  return tokenizer_->symbol().builtin == Smt2Builtin::None || SyntaxError();
+}
+
+bool Smt2StreamParser::Expect(const Kind kind) {
+  return tokenizer_->kind() == kind || SyntaxError();
+}
+
+bool Smt2StreamParser::Error(const string& message) const {
+  return Error(tokenizer_->line(), tokenizer_->column(), message);
+}
+
+bool Smt2StreamParser::Error(const int line, const int column,
+                             const string& message) const {
+  Smt2Driver::error(
+      fmt::format("{}:{}.{} : {}", streamname_, line, column, message));
+  return false;
+}
+
+bool Smt2StreamParser::SyntaxError() const {
+  string token;
+  switch (tokenizer_->kind()) {
+    case Kind::End:
+      token = "end of file";
+      break;
+    case Kind::LeftParen:
+      token = "'('";
+      break;
+    case Kind::RightParen:
+      token = "')'";
+      break;
+    case Kind::LeftBracket:
+      token = "'['";
+      break;
+    case Kind::RightBracket:
+      token = "']'";
+      break;
+    case Kind::Comma:
+      token = "','";
+      break;
+    default:
+      token = tokenizer_->text();
+  }
+  return Error(fmt::format("syntax error, unexpected {}", token));
+}
+
+}  // namespace dreal
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dreal/smt2/term.h"
+#include "dreal/smt2/tokenizer.h"
+#include "dreal/symbolic/symbolic.h"
+
+namespace dreal {
+
+class Smt2Driver;
+
+/// A hand-written parser for the SMT-LIB2 scripts accepted by the bison
+/// parser (see parser.yy), which runs each command as soon as it is read.
+///
+/// Unlike the bison parser, its memory use does not grow with the number of
+/// commands in a script: the input is read through a buffer of fixed size,
+/// the symbols are interned and then forgotten between commands, and the
+/// terms of a command are built on a stack which is reused by the next
+/// command. Terms are parsed with an explicit stack, so that deeply nested
+/// terms (e.g. chains of `let`) do not overflow the call stack.
+class Smt2StreamParser {
+ public:
+  /// Constructs a parser which runs the commands on @p driver.
+  explicit Smt2StreamParser(Smt2Driver* driver);
+
+  /// Parses and runs the commands read from @p in. @p sname is the stream
+  /// name for error messages. If @p interactive, each command is run as soon
+  /// as it has been typed, see Smt2Tokenizer.
+  ///
+  /// @return true if successfully parsed
+  bool Parse(std::istream* in, const std::string& sname,
+             bool interactive = false);
+
+ private:
+  // A term which is being parsed.
+  struct Frame {
+    enum class State {
+      Arguments,    // The arguments of a function application.
+      LetBindings,  // The bindings of a let.
+      LetBody,      // The body of a let.
+      ForallBody,   // The body of a forall.
+    };
+    State state;
+    const Smt2Symbol* symbol;
+    // Position of the first argument in terms_.
+    size_t first_term;
+    // Position of the first bound name in let_names_.
+    size_t first_name;
+    int line;
+    int column;
+  };
+
+  // Parses and runs a command. The current token is its '('.
+  bool ParseCommand();
+
+  // Parses a term which starts with the current token, and pushes it to
+  // terms_. The current token is then the last one of the term.
+  bool ParseTerm();
+
+  // Reads the bounds `[lb, ub]` of a variable, after its sort, and pushes
+  // them to terms_. Does nothing if the next token is not '['. The current
+  // token is then the one which follows.
+  bool ParseBounds(bool* has_bounds);
+
+  // Parses the sorted variables of a forall, and pushes them to
+  // quantifiers_ with their domain. The current token is the '(' before
+  // the first one.
+  bool ParseSortedVariables();
+
+  // Reads the next binding of the let in @p frame, or its end. The current
+  // token is the '(' of the binding or the ')' of the bindings.
+  bool NextLetBinding(Frame* frame);
+
+  // Binds the names of the let in @p frame to their terms.
+  void BindLetNames(const Frame& frame);
+
+  // Replaces the arguments of the function application in @p frame by its
+  // result.
+  bool Apply(const Frame& frame);
+
+  // Pushes the term of the symbol @p symbol to terms_.
+  bool PushSymbol(const Smt2Symbol& symbol);
+
+  // Reads the next token and checks that it is of kind @p kind.
+  bool ExpectNext(Smt2Tokenizer::Kind kind);
+
+  // Reads the next token and checks that it is a symbol which is not a
+  // reserved word.
+  bool ExpectNextName();
+
+  // Checks that the current token is of kind @p kind.
+  bool Expect(Smt2Tokenizer::Kind kind);
+
+  // Reports an error at the current token, and returns false.
+  bool Error(const std::string& message) const;
+
+  // Reports an error at @p line and @p column, and returns false.
+  bool Error(int line, int column, const std::string& message) const;
+
+  // Reports that the current token is unexpected, and returns false.
+  bool SyntaxError() const;
+
+  Smt2Driver* const driver_;
+  Smt2Tokenizer* tokenizer_{nullptr};
+  std::string streamname_;
+
+  // The stacks of the term parser, which are emptied after each command.
+  std::vector<Term> terms_;
+  std::vector<Frame> frames_;
+  std::vector<const std::string*> let_names_;
+  std::vector<std::pair<Variables, Formula>> quantifiers_;
+};
+
+}  // namespace dreal
@@ -0,0 +1,105 @@
+// Measures the time spent in predicate abstraction over a set of SMT-LIB2
+// files, for instance the regression corpus:
+//
+//   bazel run //dreal/smt2:abstraction_benchmark -- $PWD/dreal/test/smt2/*.smt2
+//
+// The assertions of each file are converted by a fresh PredicateAbstractor,
+// which names its atoms lazily. Then every atom is printed as `b(<formula>)`,
+// which is what naming them eagerly used to cost on top of that.
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "dreal/qsopt_ex.h"
+#include "dreal/smt2/driver.h"
+#include "dreal/solver/context.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/infty.h"
+#include "dreal/util/predicate_abstractor.h"
+#include "dreal/util/timer.h"
+
+namespace dreal {
+namespace {
+
+using std::cerr;
+using std::cout;
+using std::ifstream;
+using std::string;
+using std::stringstream;
+using std::vector;
+
+// Returns the content of @p filename without the commands which would run
+// the solver. Every command is expected to start on its own line.
+string ReadAssertions(const string& filename) {
+  ifstream in{filename};
+  stringstream out;
+  string line;
+  while (std::getline(in, line)) {
+    const string::size_type pos{line.find_first_not_of(" \t")};
+    if (pos != string::npos && (line.compare(pos, 10, "(check-sat") == 0 ||
+                                line.compare(pos, 5, "(get-") == 0)) {
+      continue;
+    }
+    out << line << "\n";
+  }
+  return out.str();
+}
+
+int Run(const vector<string>& filenames) {
+  fmt::print(cout, "{:<50} {:>8} {:>12} {:>12}\n", "file", "#atoms",
+             "convert (s)", "naming (s)");
+  double total_convert{0};
+  double total_naming{0};
+  for (const string& filename : filenames) {
+    Smt2Driver driver{Context{Config{}}};
+    if (!driver.parse_string(ReadAssertions(filename), filename)) {
+      cerr << "Failed to parse " << filename << "\n";
+      continue;
+    }
+    const vector<Formula>& assertions{
+        driver.mutable_context().assertions().get_vector()};
+
+    PredicateAbstractor abstractor;
+    Timer convert_timer;
+    convert_timer.start();
+    abstractor.Convert(assertions);
+    convert_timer.pause();
+
+    Timer naming_timer;
+    naming_timer.start();
+    for (const auto& p : abstractor.var_to_formula_map()) {
+      stringstream ss;
+      ss << "b(" << p.second << ")";
+    }
+    naming_timer.pause();
+
+    fmt::print(cout, "{:<50} {:>8} {:>12.6f} {:>12.6f}\n", filename,
+               abstractor.var_to_formula_map().size(), convert_timer.seconds(),
+               naming_timer.seconds());
+    total_convert += convert_timer.seconds();
+    total_naming += naming_timer.seconds();
+  }
+  fmt::print(cout, "{:<50} {:>8} {:>12.6f} {:>12.6f}\n", "total", "",
+             total_convert, total_naming);
+  return 0;
+}
+
+}  // namespace
+}  // namespace dreal
+
+int main(int argc, char* argv[]) {
+  dreal::qsopt_ex::QSXStart();
+  dreal::util::InftyStart(dreal::qsopt_ex::mpq_INFTY,
+                          dreal::qsopt_ex::mpq_NINFTY);
+  dreal::Expression::InitConstants();
+  const int ret{dreal::Run(std::vector<std::string>(argv + 1, argv + argc))};
+  dreal::Expression::DeInitConstants();
+  dreal::util::InftyFinish();
+  dreal::qsopt_ex::QSXFinish();
+  return ret;
+}
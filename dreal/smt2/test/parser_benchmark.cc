@@ -0,0 +1,129 @@
+// Measures the throughput of the flex/bison parser and of Smt2StreamParser,
+// in MB/s, on a synthetic script or on a set of SMT-LIB2 files:
+//
+//   bazel run //dreal/smt2:parser_benchmark -- [#asserts]
+//   bazel run //dreal/smt2:parser_benchmark -- $PWD/dreal/test/smt2/*.smt2
+//
+// The synthetic script declares 1000 variables and asserts #asserts linear
+// constraints over them, some of them under a let. The commands which would
+// run the solver are removed from the files, so that the time is spent
+// reading the script and asserting its formulas.
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "dreal/smt2/driver.h"
+#include "dreal/solver/context.h"
+#include "dreal/util/timer.h"
+
+namespace dreal {
+namespace {
+
+using std::cerr;
+using std::cout;
+using std::ifstream;
+using std::pair;
+using std::string;
+using std::stringstream;
+using std::vector;
+
+// Returns the content of @p filename without the commands which would run
+// the solver. Every command is expected to start on its own line.
+string ReadAssertions(const string& filename) {
+  ifstream in{filename};
+  stringstream out;
+  string line;
+  while (std::getline(in, line)) {
+    const string::size_type pos{line.find_first_not_of(" \t")};
+    if (pos != string::npos && (line.compare(pos, 10, "(check-sat") == 0 ||
+                                line.compare(pos, 5, "(get-") == 0)) {
+      continue;
+    }
+    out << line << "\n";
+  }
+  return out.str();
+}
+
+string MakeScript(const int num_asserts) {
+  constexpr int kNumVars{1000};
+  std::mt19937 rng{0};
+  std::uniform_int_distribution<int> var_dist{0, kNumVars - 1};
+  std::uniform_int_distribution<int> coeff_dist{-1000, 1000};
+  stringstream out;
+  out << "(set-logic QF_LRA)\n";
+  for (int i = 0; i < kNumVars; ++i) {
+    out << fmt::format("(declare-fun x{} () Real)\n", i);
+  }
+  for (int i = 0; i < num_asserts; ++i) {
+    const string sum{fmt::format("(+ (* {}.5 x{}) (* {} x{}) (* {} x{}))",
+                                 coeff_dist(rng), var_dist(rng),
+                                 coeff_dist(rng), var_dist(rng),
+                                 coeff_dist(rng), var_dist(rng))};
+    if (i % 4 == 0) {
+      out << fmt::format("(assert (let ((s {})) (or (<= s {}) (>= s {}))))\n",
+                         sum, coeff_dist(rng), coeff_dist(rng));
+    } else {
+      out << fmt::format("(assert (<= {} {}))\n", sum, coeff_dist(rng));
+    }
+  }
+  return out.str();
+}
+
+// Returns the time spent by parse_string on @p script, in seconds.
+double Parse(const string& script, const string& name, const bool streaming) {
+  Smt2Driver driver{Context{Config{}}};
+  driver.set_streaming(streaming);
+  Timer timer;
+  timer.start();
+  if (!driver.parse_string(script, name)) {
+    cerr << "Failed to parse " << name << "\n";
+  }
+  timer.pause();
+  return timer.seconds();
+}
+
+int Run(const vector<pair<string, string>>& scripts) {
+  fmt::print(cout, "{:<50} {:>10} {:>14} {:>14}\n", "script", "size (MB)",
+             "bison (MB/s)", "stream (MB/s)");
+  double total_size{0};
+  double total_bison{0};
+  double total_stream{0};
+  for (const auto& script : scripts) {
+    const double size{script.second.size() / 1e6};
+    const double bison{Parse(script.second, script.first, false)};
+    const double stream{Parse(script.second, script.first, true)};
+    fmt::print(cout, "{:<50} {:>10.3f} {:>14.2f} {:>14.2f}\n", script.first,
+               size, size / bison, size / stream);
+    total_size += size;
+    total_bison += bison;
+    total_stream += stream;
+  }
+  fmt::print(cout, "{:<50} {:>10.3f} {:>14.2f} {:>14.2f}\n", "total",
+             total_size, total_size / total_bison, total_size / total_stream);
+  return 0;
+}
+
+}  // namespace
+}  // namespace dreal
+
+int main(int argc, char* argv[]) {
+  std::vector<std::pair<std::string, std::string>> scripts;
+  const int num_asserts{argc == 2 ? std::atoi(argv[1]) : 100000};
+  if (argc == 1 || (argc == 2 && num_asserts > 0)) {
+    scripts.emplace_back(fmt::format("synthetic ({} asserts)", num_asserts),
+                         dreal::MakeScript(num_asserts));
+  } else {
+    for (int i = 1; i < argc; ++i) {
+      scripts.emplace_back(argv[i], dreal::ReadAssertions(argv[i]));
+    }
+  }
+  return dreal::Run(scripts);
+}
@@ -0,0 +1,166 @@
+#include "dreal/smt2/tokenizer.h"
+
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace dreal {
+namespace {
+
+using std::istringstream;
+using std::string;
+
+using Kind = Smt2Tokenizer::Kind;
+
+TEST(Smt2TokenizerTest, Punctuation) {
+  istringstream in{"( ) [ , ] #"};
+  Smt2Tokenizer tokenizer{&in};
+  EXPECT_EQ(tokenizer.Next(), Kind::LeftParen);
+  EXPECT_EQ(tokenizer.Next(), Kind::RightParen);
+  EXPECT_EQ(tokenizer.Next(), Kind::LeftBracket);
+  EXPECT_EQ(tokenizer.Next(), Kind::Comma);
+  EXPECT_EQ(tokenizer.Next(), Kind::RightBracket);
+  EXPECT_EQ(tokenizer.Next(), Kind::Invalid);
+  EXPECT_EQ(tokenizer.text(), "#");
+  EXPECT_EQ(tokenizer.Next(), Kind::End);
+  EXPECT_EQ(tokenizer.Next(), Kind::End);
+}
+
+TEST(Smt2TokenizerTest, Symbols) {
+  istringstream in{"x |a b| arctan <= x - -x"};
+  Smt2Tokenizer tokenizer{&in};
+  ASSERT_EQ(tokenizer.Next(), Kind::Symbol);
+  const Smt2Symbol* const x{&tokenizer.symbol()};
+  EXPECT_EQ(x->name, "x");
+  EXPECT_EQ(x->builtin, Smt2Builtin::None);
+  ASSERT_EQ(tokenizer.Next(), Kind::Symbol);
+  EXPECT_EQ(tokenizer.symbol().name, "|a b|");
+  ASSERT_EQ(tokenizer.Next(), Kind::Symbol);
+  EXPECT_EQ(tokenizer.symbol().builtin, Smt2Builtin::Atan);
+  ASSERT_EQ(tokenizer.Next(), Kind::Symbol);
+  EXPECT_EQ(tokenizer.symbol().builtin, Smt2Builtin::Lte);
+  // Symbols are interned.
+  ASSERT_EQ(tokenizer.Next(), Kind::Symbol);
+  EXPECT_EQ(&tokenizer.symbol(), x);
+  ASSERT_EQ(tokenizer.Next(), Kind::Symbol);
+  EXPECT_EQ(tokenizer.symbol().builtin, Smt2Builtin::Minus);
+  ASSERT_EQ(tokenizer.Next(), Kind::Symbol);
+  EXPECT_EQ(tokenizer.symbol().name, "-x");
+}
+
+TEST(Smt2TokenizerTest, Numbers) {
+  istringstream in{"0 -12 +3 007 1.25 .5 5. 1e3 -2.5E-2 0x1.8p1 1x"};
+  Smt2Tokenizer tokenizer{&in};
+  ASSERT_EQ(tokenizer.Next(), Kind::Number);
+  EXPECT_EQ(tokenizer.number(), 0);
+  EXPECT_TRUE(tokenizer.is_integer());
+  ASSERT_EQ(tokenizer.Next(), Kind::Number);
+  EXPECT_EQ(tokenizer.number(), -12);
+  EXPECT_TRUE(tokenizer.is_integer());
+  ASSERT_EQ(tokenizer.Next(), Kind::Number);
+  EXPECT_EQ(tokenizer.number(), 3);
+  EXPECT_TRUE(tokenizer.is_integer());
+  ASSERT_EQ(tokenizer.Next(), Kind::Number);
+  EXPECT_EQ(tokenizer.number(), 7);
+  EXPECT_FALSE(tokenizer.is_integer());
+  ASSERT_EQ(tokenizer.Next(), Kind::Number);
+  EXPECT_EQ(tokenizer.number(), mpq_class(5, 4));
+  EXPECT_FALSE(tokenizer.is_integer());
+  ASSERT_EQ(tokenizer.Next(), Kind::Number);
+  EXPECT_EQ(tokenizer.number(), mpq_class(1, 2));
+  ASSERT_EQ(tokenizer.Next(), Kind::Number);
+  EXPECT_EQ(tokenizer.number(), 5);
+  ASSERT_EQ(tokenizer.Next(), Kind::Number);
+  EXPECT_EQ(tokenizer.number(), 1000);
+  EXPECT_FALSE(tokenizer.is_integer());
+  ASSERT_EQ(tokenizer.Next(), Kind::Number);
+  EXPECT_EQ(tokenizer.number(), mpq_class(-1, 40));
+  ASSERT_EQ(tokenizer.Next(), Kind::HexFloat);
+  EXPECT_EQ(tokenizer.hexfloat(), 3.0);
+  EXPECT_EQ(tokenizer.Next(), Kind::Invalid);
+}
+
+TEST(Smt2TokenizerTest, KeywordsStringsAndComments) {
+  istringstream in{
+      "(set-info :source \"a \"\"b\"\"\n c\") ; comment ( x\n"
+      "  :status"};
+  Smt2Tokenizer tokenizer{&in};
+  EXPECT_EQ(tokenizer.Next(), Kind::LeftParen);
+  ASSERT_EQ(tokenizer.Next(), Kind::Symbol);
+  EXPECT_EQ(tokenizer.symbol().builtin, Smt2Builtin::SetInfo);
+  ASSERT_EQ(tokenizer.Next(), Kind::Keyword);
+  EXPECT_EQ(tokenizer.text(), ":source");
+  ASSERT_EQ(tokenizer.Next(), Kind::String);
+  EXPECT_EQ(tokenizer.text(), "\"a \"\"b\"\"\n c\"");
+  EXPECT_EQ(tokenizer.Next(), Kind::RightParen);
+  EXPECT_EQ(tokenizer.line(), 2);
+  ASSERT_EQ(tokenizer.Next(), Kind::Keyword);
+  EXPECT_EQ(tokenizer.text(), ":status");
+  EXPECT_EQ(tokenizer.line(), 3);
+  EXPECT_EQ(tokenizer.column(), 3);
+  EXPECT_EQ(tokenizer.Next(), Kind::End);
+}
+
+TEST(Smt2TokenizerTest, SmallBuffer) {
+  // Tokens may span several refills of the buffer.
+  string input;
+  for (int i = 0; i < 1000; ++i) {
+    input += "(assert (<= x_" + std::to_string(i) + " 1234.5678))\n";
+  }
+  istringstream in{input};
+  Smt2Tokenizer tokenizer{&in, 3};
+  int num_numbers{0};
+  int num_symbols{0};
+  for (Kind kind = tokenizer.Next(); kind != Kind::End;
+       kind = tokenizer.Next()) {
+    ASSERT_NE(kind, Kind::Invalid);
+    if (kind == Kind::Number) {
+      EXPECT_EQ(tokenizer.number(), mpq_class(6172839, 5000));
+      ++num_numbers;
+    } else if (kind == Kind::Symbol) {
+      ++num_symbols;
+    }
+  }
+  EXPECT_EQ(num_numbers, 1000);
+  EXPECT_EQ(num_symbols, 3000);
+  EXPECT_EQ(tokenizer.bytes_read(), input.size());
+  EXPECT_EQ(tokenizer.line(), 1001);
+}
+
+TEST(Smt2TokenizerTest, Interactive) {
+  // An interactive tokenizer reads what is available, and the same tokens.
+  istringstream in{"(assert (<= x 1.5))\n(check-sat)\n"};
+  Smt2Tokenizer tokenizer{&in, 4, true};
+  EXPECT_EQ(tokenizer.Next(), Kind::LeftParen);
+  ASSERT_EQ(tokenizer.Next(), Kind::Symbol);
+  EXPECT_EQ(tokenizer.symbol().builtin, Smt2Builtin::Assert);
+  EXPECT_EQ(tokenizer.Next(), Kind::LeftParen);
+  EXPECT_EQ(tokenizer.Next(), Kind::Symbol);
+  EXPECT_EQ(tokenizer.Next(), Kind::Symbol);
+  ASSERT_EQ(tokenizer.Next(), Kind::Number);
+  EXPECT_EQ(tokenizer.number(), mpq_class(3, 2));
+  EXPECT_EQ(tokenizer.Next(), Kind::RightParen);
+  EXPECT_EQ(tokenizer.Next(), Kind::RightParen);
+  EXPECT_EQ(tokenizer.Next(), Kind::LeftParen);
+  ASSERT_EQ(tokenizer.Next(), Kind::Symbol);
+  EXPECT_EQ(tokenizer.symbol().builtin, Smt2Builtin::CheckSat);
+  EXPECT_EQ(tokenizer.Next(), Kind::RightParen);
+  EXPECT_EQ(tokenizer.Next(), Kind::End);
+  EXPECT_EQ(tokenizer.bytes_read(), in.str().size());
+}
+
+TEST(Smt2TokenizerTest, TrimSymbols) {
+  istringstream in{"x y z and"};
+  Smt2Tokenizer tokenizer{&in};
+  tokenizer.Next();
+  tokenizer.Next();
+  tokenizer.Next();
+  tokenizer.TrimSymbols(2);
+  ASSERT_EQ(tokenizer.Next(), Kind::Symbol);
+  // The reserved words are kept.
+  EXPECT_EQ(tokenizer.symbol().builtin, Smt2Builtin::And);
+}
+
+}  // namespace
+}  // namespace dreal
@@ -0,0 +1,379 @@
+#include "dreal/smt2/tokenizer.h"
+
+#include <cstdlib>
+#include <limits>
+
+namespace dreal {
+
+using std::istream;
+using std::string;
+
+namespace {
+
+struct BuiltinName {
+  const char* name;
+  Smt2Builtin builtin;
+};
+
+// The reserved words which are recognized by the flex scanner, see
+// scanner.ll, including its aliases.
+constexpr BuiltinName kBuiltinNames[] = {
+    {"assert", Smt2Builtin::Assert},
+    {"check-sat", Smt2Builtin::CheckSat},
+    {"check-sat-assuming", Smt2Builtin::CheckSatAssuming},
+    {"declare-const", Smt2Builtin::DeclareConst},
+    {"declare-fun", Smt2Builtin::DeclareFun},
+    {"define-fun", Smt2Builtin::DefineFun},
+    {"exit", Smt2Builtin::Exit},
+    {"get-model", Smt2Builtin::GetModel},
+    {"get-unsat-assumptions", Smt2Builtin::GetUnsatAssumptions},
+    {"maximize", Smt2Builtin::Maximize},
+    {"minimize", Smt2Builtin::Minimize},
+    {"pop", Smt2Builtin::Pop},
+    {"push", Smt2Builtin::Push},
+    {"set-info", Smt2Builtin::SetInfo},
+    {"set-logic", Smt2Builtin::SetLogic},
+    {"set-option", Smt2Builtin::SetOption},
+    {"forall", Smt2Builtin::Forall},
+    {"let", Smt2Builtin::Let},
+    {"true", Smt2Builtin::True},
+    {"false", Smt2Builtin::False},
+    {"and", Smt2Builtin::And},
+    {"or", Smt2Builtin::Or},
+    {"xor", Smt2Builtin::Xor},
+    {"not", Smt2Builtin::Not},
+    {"=>", Smt2Builtin::Implies},
+    {"ite", Smt2Builtin::Ite},
+    {"=", Smt2Builtin::Eq},
+    {"<", Smt2Builtin::Lt},
+    {"<=", Smt2Builtin::Lte},
+    {">", Smt2Builtin::Gt},
+    {">=", Smt2Builtin::Gte},
+    {"+", Smt2Builtin::Plus},
+    {"-", Smt2Builtin::Minus},
+    {"*", Smt2Builtin::Times},
+    {"/", Smt2Builtin::Div},
+    {"exp", Smt2Builtin::Exp},
+    {"log", Smt2Builtin::Log},
+    {"abs", Smt2Builtin::Abs},
+    {"sin", Smt2Builtin::Sin},
+    {"cos", Smt2Builtin::Cos},
+    {"tan", Smt2Builtin::Tan},
+    {"asin", Smt2Builtin::Asin},
+    {"arcsin", Smt2Builtin::Asin},
+    {"acos", Smt2Builtin::Acos},
+    {"arccos", Smt2Builtin::Acos},
+    {"atan", Smt2Builtin::Atan},
+    {"arctan", Smt2Builtin::Atan},
+    {"atan2", Smt2Builtin::Atan2},
+    {"arctan2", Smt2Builtin::Atan2},
+    {"sinh", Smt2Builtin::Sinh},
+    {"cosh", Smt2Builtin::Cosh},
+    {"tanh", Smt2Builtin::Tanh},
+    {"min", Smt2Builtin::Min},
+    {"max", Smt2Builtin::Max},
+    {"sqrt", Smt2Builtin::Sqrt},
+    {"^", Smt2Builtin::Pow},
+    {"pow", Smt2Builtin::Pow},
+};
+
+bool IsDigit(const int c) { return c >= '0' && c <= '9'; }
+
+bool IsSymbolChar(const int c) {
+  if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || IsDigit(c)) {
+    return true;
+  }
+  switch (c) {
+    case '+':
+    case '-':
+    case '/':
+    case '*':
+    case '=':
+    case '%':
+    case '?':
+    case '!':
+    case '.':
+    case '$':
+    case '_':
+    case '~':
+    case '&':
+    case '^':
+    case '<':
+    case '>':
+    case '@':
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+Smt2Tokenizer::Smt2Tokenizer(istream* in, const size_t buffer_size,
+                             const bool interactive)
+    : in_{in},
+      interactive_{interactive},
+      buffer_(buffer_size > 0 ? buffer_size : 1) {
+  for (const BuiltinName& b : kBuiltinNames) {
+    symbols_.emplace(b.name, Smt2Symbol{b.name, b.builtin});
+  }
+  num_builtins_ = symbols_.size();
+}
+
+bool Smt2Tokenizer::Refill() {
+  pos_ = 0;
+  end_ = 0;
+  if (interactive_) {
+    // Only waits for the first character, so that a command is processed as
+    // soon as it is complete. Note that readsome() only returns what the
+    // stream has already buffered.
+    const int c{in_->get()};
+    if (c == std::char_traits<char>::eof()) {
+      return false;
+    }
+    buffer_[0] = static_cast<char>(c);
+    end_ = 1 + in_->readsome(buffer_.data() + 1, buffer_.size() - 1);
+  } else {
+    // Fills the whole buffer in one call to the stream buffer, e.g. a single
+    // fread() for std::cin.
+    end_ = in_->rdbuf()->sgetn(buffer_.data(), buffer_.size());
+  }
+  bytes_read_ += end_;
+  return end_ > 0;
+}
+
+int Smt2Tokenizer::Peek() {
+  if (pos_ == end_ && !Refill()) {
+    return -1;
+  }
+  return static_cast<unsigned char>(buffer_[pos_]);
+}
+
+void Smt2Tokenizer::Advance() {
+  if (buffer_[pos_] == '\n') {
+    ++line_;
+    column_ = 1;
+  } else {
+    ++column_;
+  }
+  ++pos_;
+}
+
+Smt2Tokenizer::Kind Smt2Tokenizer::Next() {
+  // Skips white-spaces and comments.
+  int c{Peek()};
+  while (c != -1) {
+    if (c == ';') {
+      while (c != -1 && c != '\n') {
+        Advance();
+        c = Peek();
+      }
+    } else if (c <= ' ' || c == 0xA0) {
+      Advance();
+      c = Peek();
+    } else {
+      break;
+    }
+  }
+  token_line_ = line_;
+  token_column_ = column_;
+  text_.clear();
+  if (c == -1) {
+    return kind_ = Kind::End;
+  }
+
+  switch (c) {
+    case '(':
+      Advance();
+      return kind_ = Kind::LeftParen;
+    case ')':
+      Advance();
+      return kind_ = Kind::RightParen;
+    case '[':
+      Advance();
+      return kind_ = Kind::LeftBracket;
+    case ']':
+      Advance();
+      return kind_ = Kind::RightBracket;
+    case ',':
+      Advance();
+      return kind_ = Kind::Comma;
+    case ':':
+      text_.push_back(':');
+      Advance();
+      while (IsSymbolChar(c = Peek())) {
+        text_.push_back(static_cast<char>(c));
+        Advance();
+      }
+      return kind_ = text_.size() > 1 ? Kind::Keyword : Kind::Invalid;
+    case '"':
+      // A string literal, where "" stands for ".
+      text_.push_back('"');
+      Advance();
+      while ((c = Peek()) != -1) {
+        text_.push_back(static_cast<char>(c));
+        Advance();
+        if (c == '"') {
+          if (Peek() != '"') {
+            return kind_ = Kind::String;
+          }
+          text_.push_back('"');
+          Advance();
+        }
+      }
+      return kind_ = Kind::Invalid;
+    case '|':
+      text_.push_back('|');
+      Advance();
+      while ((c = Peek()) != -1) {
+        text_.push_back(static_cast<char>(c));
+        Advance();
+        if (c == '|') {
+          Intern();
+          return kind_ = Kind::Symbol;
+        }
+      }
+      return kind_ = Kind::Invalid;
+    default:
+      if (IsSymbolChar(c)) {
+        return kind_ = ReadSymbolOrNumber();
+      }
+      text_.push_back(static_cast<char>(c));
+      Advance();
+      return kind_ = Kind::Invalid;
+  }
+}
+
+Smt2Tokenizer::Kind Smt2Tokenizer::ReadSymbolOrNumber() {
+  int c;
+  while (IsSymbolChar(c = Peek())) {
+    text_.push_back(static_cast<char>(c));
+    Advance();
+  }
+  if (ParseNumber()) {
+    return Kind::Number;
+  }
+  if (ParseHexFloat()) {
+    return Kind::HexFloat;
+  }
+  if (IsDigit(text_[0])) {
+    // A symbol does not start with a digit.
+    return Kind::Invalid;
+  }
+  Intern();
+  return Kind::Symbol;
+}
+
+bool Smt2Tokenizer::ParseNumber() {
+  // [-+]?([0-9]+|[0-9]*\.?[0-9]+|[0-9]+\.)([eE][-+]?[0-9]+)?
+  const size_t n{text_.size()};
+  size_t i{0};
+  bool negative{false};
+  if (text_[0] == '-' || text_[0] == '+') {
+    negative = text_[0] == '-';
+    ++i;
+  }
+  digits_.clear();
+  bool seen_point{false};
+  long scale{0};  // NOLINT(runtime/int)
+  for (; i < n; ++i) {
+    const char c{text_[i]};
+    if (IsDigit(c)) {
+      digits_.push_back(c);
+      scale += seen_point;
+    } else if (c == '.' && !seen_point) {
+      seen_point = true;
+    } else {
+      break;
+    }
+  }
+  if (digits_.empty()) {
+    return false;
+  }
+  long exponent{0};  // NOLINT(runtime/int)
+  const bool has_exponent{i < n};
+  if (has_exponent) {
+    if (text_[i] != 'e' && text_[i] != 'E') {
+      return false;
+    }
+    ++i;
+    bool negative_exponent{false};
+    if (i < n && (text_[i] == '-' || text_[i] == '+')) {
+      negative_exponent = text_[i] == '-';
+      ++i;
+    }
+    if (i == n) {
+      return false;
+    }
+    for (; i < n; ++i) {
+      if (!IsDigit(text_[i]) ||
+          exponent > std::numeric_limits<int>::max() / 10) {
+        return false;
+      }
+      exponent = exponent * 10 + (text_[i] - '0');
+    }
+    if (negative_exponent) {
+      exponent = -exponent;
+    }
+  }
+  // [-+]?(0|[1-9][0-9]*) is an integer numeral.
+  is_integer_ = !seen_point && !has_exponent &&
+                (digits_.size() == 1 || digits_[0] != '0');
+
+  mpz_set_str(number_.get_num_mpz_t(), digits_.c_str(), 10);
+  exponent -= scale;
+  if (exponent == 0) {
+    number_.get_den() = 1;
+  } else {
+    mpz_ui_pow_ui(power_.get_mpz_t(), 10,
+                  static_cast<unsigned long>(  // NOLINT(runtime/int)
+                      exponent > 0 ? exponent : -exponent));
+    if (exponent > 0) {
+      number_.get_num() *= power_;
+      number_.get_den() = 1;
+    } else {
+      number_.get_den() = power_;
+      number_.canonicalize();
+    }
+  }
+  if (negative) {
+    mpq_neg(number_.get_mpq_t(), number_.get_mpq_t());
+  }
+  return true;
+}
+
+bool Smt2Tokenizer::ParseHexFloat() {
+  // [-+]?0[xX]({hex}+\.?|{hex}*\.{hex}+)([pP][-+]?[0-9]+)?
+  const size_t start{text_[0] == '-' || text_[0] == '+' ? 1u : 0u};
+  if (text_.size() < start + 3 || text_[start] != '0' ||
+      (text_[start + 1] != 'x' && text_[start + 1] != 'X')) {
+    return false;
+  }
+  char* end{nullptr};
+  hexfloat_ = std::strtod(text_.c_str(), &end);
+  return end == text_.c_str() + text_.size();
+}
+
+void Smt2Tokenizer::Intern() {
+  auto it = symbols_.find(text_);
+  if (it == symbols_.end()) {
+    it = symbols_.emplace(text_, Smt2Symbol{text_, Smt2Builtin::None}).first;
+  }
+  symbol_ = &it->second;
+}
+
+void Smt2Tokenizer::TrimSymbols(const size_t max_size) {
+  if (symbols_.size() <= num_builtins_ + max_size) {
+    return;
+  }
+  for (auto it = symbols_.begin(); it != symbols_.end();) {
+    if (it->second.builtin == Smt2Builtin::None) {
+      it = symbols_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  symbol_ = nullptr;
+}
+
+}  // namespace dreal
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dreal/gmp.h"
+
+namespace dreal {
+
+/// The reserved words and the function symbols of SMT-LIB2 which are
+/// understood by Smt2StreamParser.
+enum class Smt2Builtin {
+  None,  ///< Not a reserved word.
+  // Commands.
+  Assert,
+  CheckSat,
+  CheckSatAssuming,
+  DeclareConst,
+  DeclareFun,
+  DefineFun,
+  Exit,
+  GetModel,
+  GetUnsatAssumptions,
+  Maximize,
+  Minimize,
+  Pop,
+  Push,
+  SetInfo,
+  SetLogic,
+  SetOption,
+  // Binders.
+  Forall,
+  Let,
+  // Boolean functions.
+  True,
+  False,
+  And,
+  Or,
+  Xor,
+  Not,
+  Implies,
+  Ite,
+  // Relations.
+  Eq,
+  Lt,
+  Lte,
+  Gt,
+  Gte,
+  // Arithmetic functions.
+  Plus,
+  Minus,
+  Times,
+  Div,
+  Exp,
+  Log,
+  Abs,
+  Sin,
+  Cos,
+  Tan,
+  Asin,
+  Acos,
+  Atan,
+  Atan2,
+  Sinh,
+  Cosh,
+  Tanh,
+  Min,
+  Max,
+  Sqrt,
+  Pow,
+};
+
+/// An interned symbol. Two tokens with the same text share the same Symbol.
+struct Smt2Symbol {
+  std::string name;
+  Smt2Builtin builtin;
+};
+
+/// Splits an SMT-LIB2 input stream into tokens, for Smt2StreamParser.
+///
+/// The input is read through a buffer of fixed size, so that a file of any
+/// size can be scanned in bounded memory. Symbols are interned in a table
+/// which also identifies the reserved words, and numerals and decimals are
+/// converted to mpq_class as they are read.
+class Smt2Tokenizer {
+ public:
+  enum class Kind {
+    End,          ///< End of the input.
+    LeftParen,    ///< (
+    RightParen,   ///< )
+    LeftBracket,  ///< [, which starts the bounds of a variable.
+    RightBracket, ///< ]
+    Comma,        ///< , which separates the bounds of a variable.
+    Symbol,       ///< A simple or a quoted symbol, see symbol().
+    Keyword,      ///< :keyword, see text().
+    String,       ///< A string literal with its quotes, see text().
+    Number,       ///< A numeral or a decimal, see number().
+    HexFloat,     ///< A hexadecimal floating-point literal, see hexfloat().
+    Invalid,      ///< A character which starts no token, see text().
+  };
+
+  /// Reads tokens from @p in, @p buffer_size bytes at a time.
+  ///
+  /// If @p interactive, a read returns as soon as some input is available,
+  /// so that a command typed on a terminal is processed without waiting for
+  /// the buffer to be filled.
+  explicit Smt2Tokenizer(std::istream* in, size_t buffer_size = 1 << 16,
+                         bool interactive = false);
+
+  Smt2Tokenizer(const Smt2Tokenizer&) = delete;
+  Smt2Tokenizer& operator=(const Smt2Tokenizer&) = delete;
+
+  /// Reads the next token and returns its kind.
+  Kind Next();
+
+  /// Returns the kind of the last token.
+  Kind kind() const { return kind_; }
+
+  /// Returns the interned symbol of the last Symbol token.
+  const Smt2Symbol& symbol() const { return *symbol_; }
+
+  /// Returns the text of the last token.
+  const std::string& text() const { return text_; }
+
+  /// Returns the value of the last Number token.
+  const mpq_class& number() const { return number_; }
+
+  /// Returns true if the last Number token was an integer numeral.
+  bool is_integer() const { return is_integer_; }
+
+  /// Returns the value of the last HexFloat token.
+  double hexfloat() const { return hexfloat_; }
+
+  /// Returns the line of the first character of the last token.
+  int line() const { return token_line_; }
+
+  /// Returns the column of the first character of the last token.
+  int column() const { return token_column_; }
+
+  /// Returns the number of bytes read so far.
+  size_t bytes_read() const { return bytes_read_; }
+
+  /// Forgets the symbols which are not reserved words, once there are more
+  /// than @p max_size of them. The references returned by symbol() are
+  /// invalidated.
+  void TrimSymbols(size_t max_size);
+
+ private:
+  // Returns the next character without consuming it, or -1 at the end.
+  int Peek();
+  // Consumes the next character.
+  void Advance();
+  // Reads the next part of the input into buffer_.
+  bool Refill();
+
+  // Reads a token which starts with a symbol character.
+  Kind ReadSymbolOrNumber();
+  // Parses text_ as a numeral or a decimal into number_, or returns false.
+  bool ParseNumber();
+  // Parses text_ as a hexadecimal floating-point literal, or returns false.
+  bool ParseHexFloat();
+  // Points symbol_ to the entry of text_ in symbols_, adding it if needed.
+  void Intern();
+
+  std::istream* const in_;
+  const bool interactive_;
+  std::vector<char> buffer_;
+  size_t pos_{0};
+  size_t end_{0};
+  size_t bytes_read_{0};
+  int line_{1};
+  int column_{1};
+
+  Kind kind_{Kind::End};
+  int token_line_{1};
+  int token_column_{1};
+  std::string text_;
+  const Smt2Symbol* symbol_{nullptr};
+  mpq_class number_;
+  bool is_integer_{false};
+  double hexfloat_{0};
+  // Scratch space of ParseNumber().
+  std::string digits_;
+  mpz_class power_;
+
+  std::unordered_map<std::string, Smt2Symbol> symbols_;
+  size_t num_builtins_{0};
+};
+
+}  // namespace dreal
@@ -61,6 +61,20 @@ OptionValue<Config::LPSolver>& Config::mutable_lp_solver() {
   return lp_solver_;
 }
 
+Config::SatSolver Config::sat_solver() const {
+  return sat_solver_.get();
+}
+OptionValue<Config::SatSolver>& Config::mutable_sat_solver() {
+  return sat_solver_;
+}
+
+int Config::online_check_period() const {
+  return online_check_period_.get();
+}
+OptionValue<int>& Config::mutable_online_check_period() {
+  return online_check_period_;
+}
+
 int Config::verbose_simplex() const {
   return verbose_simplex_.get();
 }
@@ -68,6 +82,27 @@ OptionValue<int>& Config::mutable_verbose_simplex() {
   return verbose_simplex_;
 }
 
+bool Config::simplex_warm_start() const {
+  return simplex_warm_start_.get();
+}
+OptionValue<bool>& Config::mutable_simplex_warm_start() {
+  return simplex_warm_start_;
+}
+
+Config::LPExplanation Config::lp_explanation() const {
+  return lp_explanation_.get();
+}
+OptionValue<Config::LPExplanation>& Config::mutable_lp_explanation() {
+  return lp_explanation_;
+}
+
+bool Config::objective_cutoff() const {
+  return objective_cutoff_.get();
+}
+OptionValue<bool>& Config::mutable_objective_cutoff() {
+  return objective_cutoff_;
+}
+
 bool Config::continuous_output() const {
   return continuous_output_.get();
 }
@@ -85,6 +120,16 @@ OptionValue<bool>& Config::mutable_with_timings() {
 int Config::number_of_jobs() const { return number_of_jobs_.get(); }
 OptionValue<int>& Config::mutable_number_of_jobs() { return number_of_jobs_; }
 
+int Config::max_shared_clause_size() const {
+  return max_shared_clause_size_.get();
+}
+OptionValue<int>& Config::mutable_max_shared_clause_size() {
+  return max_shared_clause_size_;
+}
+
+bool Config::hash_consing() const { return hash_consing_.get(); }
+OptionValue<bool>& Config::mutable_hash_consing() { return hash_consing_; }
+
 bool Config::stack_left_box_first() const {
   return stack_left_box_first_.get();
 }
@@ -143,6 +188,19 @@ std::ostream& operator<<(std::ostream& os,
   DREAL_UNREACHABLE();
 }
 
+std::ostream& operator<<(std::ostream& os,
+                         const Config::LPExplanation& lp_explanation) {
+  switch (lp_explanation) {
+    case Config::LPExplanation::Assertions:
+      return os << "Assertions";
+    case Config::LPExplanation::Farkas:
+      return os << "Farkas";
+    case Config::LPExplanation::Minimal:
+      return os << "Minimal";
+  }
+  DREAL_UNREACHABLE();
+}
+
 ostream& operator<<(ostream& os, const Config& config) {
   return os << fmt::format(
              "Config("
@@ -154,10 +212,17 @@ ostream& operator<<(ostream& os, const Config& config) {
              "use_local_optimization = {}, "
              "simplex_sat_phase = {}, "
              "lp_solver = {}, "
+             "sat_solver = {}, "
+             "online_check_period = {}, "
              "verbose_simplex = {}, "
+             "simplex_warm_start = {}, "
+             "lp_explanation = {}, "
+             "objective_cutoff = {}, "
              "continuous_output = {}, "
              "with_timings = {}, "
              "number_of_jobs = {}, "
+             "max_shared_clause_size = {}, "
+             "hash_consing = {}, "
              "nlopt_ftol_rel = {}, "
              "nlopt_ftol_abs = {}, "
              "nlopt_maxeval = {}, "
@@ -168,9 +233,13 @@ ostream& operator<<(ostream& os, const Config& config) {
              config.precision(), config.produce_models(), config.use_polytope(),
              config.use_polytope_in_forall(), config.use_worklist_fixpoint(),
              config.use_local_optimization(), config.simplex_sat_phase(),
-             config.lp_solver(), config.verbose_simplex(),
+             config.lp_solver(), config.sat_solver(),
+             config.online_check_period(), config.verbose_simplex(),
+             config.simplex_warm_start(),
+             config.lp_explanation(), config.objective_cutoff(),
              config.continuous_output(), config.with_timings(),
-             config.number_of_jobs(),
+             config.number_of_jobs(), config.max_shared_clause_size(),
+             config.hash_consing(),
              config.nlopt_ftol_rel(), config.nlopt_ftol_abs(),
              config.nlopt_maxeval(), config.nlopt_maxtime(),
              config.sat_default_phase(), config.random_seed());
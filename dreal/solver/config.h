@@ -77,12 +77,60 @@ class Config {
   /// Returns a mutable OptionValue for 'lp_solver'.
   OptionValue<LPSolver>& mutable_lp_solver();
 
+  enum SatSolver {
+    PICOSAT = 0,
+    CADICAL,
+  };
+
+  /// Returns which SAT solver to use. With CADICAL, the theory solver is
+  /// consulted during the search (on partial assignments) through the
+  /// solver's propagation callbacks, instead of only on complete models.
+  SatSolver sat_solver() const;
+
+  /// Returns a mutable OptionValue for 'sat_solver'.
+  OptionValue<SatSolver>& mutable_sat_solver();
+
+  /// Returns how often the theory solver checks partial assignments, and
+  /// propagates the literals they imply, when the SAT solver is CADICAL:
+  /// every N-th decision level, or never if 0.
+  int online_check_period() const;
+
+  /// Returns a mutable OptionValue for 'online_check_period'.
+  OptionValue<int>& mutable_online_check_period();
+
   /// Returns verbosity level for simplex.
   int verbose_simplex() const;
 
   /// Returns a mutable OptionValue for 'verbose_simplex'.
   OptionValue<int>& mutable_verbose_simplex();
 
+  /// Returns whether the LP solver keeps its basis between theory checks,
+  /// only updating the rows and bounds which changed.
+  bool simplex_warm_start() const;
+
+  /// Returns a mutable OptionValue for 'simplex_warm_start'.
+  OptionValue<bool>& mutable_simplex_warm_start();
+
+  enum class LPExplanation {
+    Assertions = 0,  // Every active theory literal
+    Farkas = 1,      // Literals with a nonzero Farkas multiplier (default)
+    Minimal = 2,     // Farkas, then shrunk by deletion-based minimization
+  };
+
+  /// Returns how explanations are built when the LP solver reports an
+  /// infeasible problem.
+  LPExplanation lp_explanation() const;
+
+  /// Returns a mutable OptionValue for 'lp_explanation'.
+  OptionValue<LPExplanation>& mutable_lp_explanation();
+
+  /// Returns whether CheckOpt() prunes the regions which can't beat the
+  /// incumbent, by adding `objective ≤ incumbent - precision` to their LPs.
+  bool objective_cutoff() const;
+
+  /// Returns a mutable OptionValue for 'objective_cutoff'.
+  OptionValue<bool>& mutable_objective_cutoff();
+
   /// Returns whether it outputs partial results continuously, as and when
   /// available.
   bool continuous_output() const;
@@ -96,12 +144,28 @@ class Config {
   /// Returns a mutable OptionValue for 'with_timings'.
   OptionValue<bool>& mutable_with_timings();
 
-  /// Returns the number of parallel jobs.
+  /// Returns the number of parallel jobs. When it is more than one,
+  /// Context::CheckSat() runs a portfolio of diversified instances.
   int number_of_jobs() const;
 
   /// Returns a mutable OptionValue for 'number_of_jobs'.
   OptionValue<int>& mutable_number_of_jobs();
 
+  /// Returns the maximum number of literals of a learned clause which the
+  /// instances of a portfolio share with each other (0 = no sharing).
+  int max_shared_clause_size() const;
+
+  /// Returns a mutable OptionValue for 'max_shared_clause_size'.
+  OptionValue<int>& mutable_max_shared_clause_size();
+
+  /// Returns whether structurally equal expressions and formulas share a
+  /// single hash-consed cell. It applies to the whole process, and takes
+  /// effect when the program sets up the symbolic library.
+  bool hash_consing() const;
+
+  /// Returns a mutable OptionValue for 'hash_consing'.
+  OptionValue<bool>& mutable_hash_consing();
+
   /// Returns whether the ICP algorithm stacks the left box first
   /// after branching.
   bool stack_left_box_first() const;
@@ -186,9 +250,16 @@ class Config {
   OptionValue<bool> continuous_output_{false};
   OptionValue<bool> with_timings_{false};
   OptionValue<LPSolver> lp_solver_{LPSolver::QSOPTEX};
+  OptionValue<SatSolver> sat_solver_{SatSolver::PICOSAT};
+  OptionValue<int> online_check_period_{1};
   OptionValue<int> simplex_sat_phase_{1};
   OptionValue<int> verbose_simplex_{0};
+  OptionValue<bool> simplex_warm_start_{false};
+  OptionValue<LPExplanation> lp_explanation_{LPExplanation::Farkas};
+  OptionValue<bool> objective_cutoff_{false};
   OptionValue<int> number_of_jobs_{1};
+  OptionValue<int> max_shared_clause_size_{8};
+  OptionValue<bool> hash_consing_{false};
   OptionValue<bool> stack_left_box_first_{false};
 
   // --------------------------------------------------------------------------
@@ -244,6 +315,9 @@ class Config {
 std::ostream& operator<<(std::ostream& os,
                          const Config::SatDefaultPhase& sat_default_phase);
 
+std::ostream& operator<<(std::ostream& os,
+                         const Config::LPExplanation& lp_explanation);
+
 std::ostream& operator<<(std::ostream& os, const Config& config);
 
 }  // namespace dreal
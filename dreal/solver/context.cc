@@ -20,6 +20,10 @@ namespace dreal {
 
 unique_ptr<Context::Impl> Context::make_impl(Config config) {
   if (config.lp_solver() == Config::QSOPTEX) {
+    if (config.sat_solver() != Config::PICOSAT) {
+      throw DREAL_RUNTIME_ERROR(
+          "The QSopt_ex backend only supports PicoSAT as the SAT solver");
+    }
     return make_unique<Context::QsoptexImpl>(config);
   } else {
     DREAL_ASSERT(config.lp_solver() == Config::SOPLEX);
@@ -46,6 +50,11 @@ optional<Box> Context::CheckSat(mpq_class* actual_precision) {
   return impl_->CheckSat(actual_precision);
 }
 
+optional<Box> Context::CheckSatAssuming(const vector<Formula>& assumptions,
+                                        mpq_class* actual_precision) {
+  return impl_->CheckSatAssuming(assumptions, actual_precision);
+}
+
 int Context::CheckOpt(mpq_class* obj_lo, mpq_class* obj_up, Box* model) {
   return impl_->CheckOpt(obj_lo, obj_up, model);
 }
@@ -130,6 +139,14 @@ const ScopedVector<Formula>& Context::assertions() const {
   return impl_->assertions();
 }
 
+const vector<Formula>& Context::GetUnsatAssumptions() const {
+  return impl_->unsat_assumptions();
+}
+
+Context::Statistics Context::statistics() const {
+  return impl_->statistics();
+}
+
 bool Context::have_objective() const { return impl_->have_objective(); }
 
 bool Context::is_max() const { return impl_->is_max(); }
@@ -38,6 +38,24 @@ enum {
 /// @note The implementation details are in context_impl.h file.
 class Context {
  public:
+  /// Counters of the work done by the checks of a context. With a
+  /// portfolio, they are the ones of the context itself, i.e. of its
+  /// instance 0.
+  struct Statistics {
+    /// Number of simplex iterations made by the theory solver.
+    long num_simplex_iterations{0};
+    /// Number of warm-started LP solves which were redone from scratch.
+    int num_cold_restarts{0};
+    /// Number of partial assignments checked during the SAT search, with
+    /// Config::online_check_period().
+    int num_partial_checks{0};
+    /// Number of theory literals propagated during the SAT search, with
+    /// Config::online_check_period().
+    int num_propagations{0};
+    /// Instance of the portfolio which answered the latest check.
+    int portfolio_winner{0};
+  };
+
   /// Constructs a context with an empty configuration.
   Context();
 
@@ -67,6 +85,17 @@ class Context {
   /// appropriate.
   optional<Box> CheckSat(mpq_class* actual_precision);
 
+  /// Checks the satisfiability of the asserted formulas together with
+  /// @p assumptions, which only hold for this check. Sets
+  /// @p actual_precision as CheckSat() does.
+  ///
+  /// Learned clauses are kept between calls, so that a series of checks
+  /// under different assumptions can reuse the work of the previous ones.
+  /// If the result is UNSAT, GetUnsatAssumptions() returns the assumptions
+  /// which were used to show it.
+  optional<Box> CheckSatAssuming(const std::vector<Formula>& assumptions,
+                                 mpq_class* actual_precision);
+
   /// Checks the satisfiability of the asserted formulas, and (where
   /// possible) optimizes an objective function over them.
   int CheckOpt(mpq_class* obj_lo, mpq_class* obj_up, Box* model);
@@ -147,6 +176,16 @@ class Context {
   /// response to an invocation of the check-sat.
   const Box& get_model() const;
 
+  /// Returns a subset of the assumptions of the last CheckSatAssuming() call
+  /// which, together with the asserted formulas, is UNSAT. It is empty if
+  /// the last call was SAT, or if the asserted formulas are UNSAT on their
+  /// own.
+  const std::vector<Formula>& GetUnsatAssumptions() const;
+
+  /// Returns the statistics of the checks done so far. Only the SoPlex
+  /// backend keeps the counters of its LP and SAT solvers.
+  Statistics statistics() const;
+
   /// Returns whether or not there is an objective function (which may be
   /// zero). If true, then CheckOpt() must be used, and not CheckSat(). If
   /// false, then CheckSat() must be used, and not CheckOpt().
@@ -1,15 +1,23 @@
 #include "dreal/solver/context_impl.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <exception>
+#include <future>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <ostream>
 #include <set>
+#include <string>
 #include <unordered_set>
 #include <utility>
 
 #include <fmt/format.h>
 
+#include "ThreadPool/ThreadPool.h"
+
 //#include "dreal/solver/filter_assertion.h"
 #include "dreal/util/assert.h"
 #include "dreal/util/exception.h"
@@ -18,9 +26,15 @@
 
 namespace dreal {
 
+using std::atomic;
+using std::exception_ptr;
 using std::find_if;
+using std::future;
+using std::lock_guard;
+using std::mutex;
 using std::set;
 using std::string;
+using std::unique_ptr;
 using std::unordered_set;
 using std::vector;
 
@@ -66,6 +80,28 @@ bool ParseBooleanOption(const string& key, const string& val) {
   throw DREAL_RUNTIME_ERROR("Unknown value {} is provided for option {}", val,
                             key);
 }
+
+// Number of clauses kept by the buffer through which the instances of a
+// portfolio share their learned clauses.
+constexpr int kPortfolioExchangeCapacity{1024};
+
+// Returns the configuration of the @p i-th instance of a portfolio. The first
+// instance keeps @p config as it is. The others use another random seed, and
+// go through the default phases of the SAT solver and the simplex phases.
+Config MakePortfolioConfig(const Config& config, const int i) {
+  Config result{config};
+  result.mutable_number_of_jobs() = 1;
+  if (i == 0) {
+    return result;
+  }
+  result.mutable_random_seed() = config.random_seed() + i;
+  result.mutable_sat_default_phase() = static_cast<Config::SatDefaultPhase>(
+      (static_cast<int>(config.sat_default_phase()) + i) % 4);
+  if (i % 2 == 1) {
+    result.mutable_simplex_sat_phase() = 3 - config.simplex_sat_phase();
+  }
+  return result;
+}
 }  // namespace
 
 Context::Impl::Impl() : Impl{Config{}} {}
@@ -76,6 +112,78 @@ Context::Impl::Impl(Config config)
 }
 
 optional<Box> Context::Impl::CheckSat(mpq_class* actual_precision) {
+  assumptions_.clear();
+  if (config_.number_of_jobs() > 1) {
+    return CheckSatPortfolio(actual_precision);
+  }
+  return CheckSatWithAssumptions(actual_precision);
+}
+
+optional<Box> Context::Impl::CheckSatAssuming(
+    const vector<Formula>& assumptions, mpq_class* actual_precision) {
+  DREAL_LOG_DEBUG("ContextImpl::CheckSatAssuming(#assumptions = {})",
+                  assumptions.size());
+  if (have_objective_) {
+    throw DREAL_RUNTIME_ERROR(
+        "CheckSatAssuming() is not supported with an objective function.");
+  }
+  unsat_assumptions_.clear();
+  assumptions_.clear();
+  vector<Formula> assumed;
+  for (const Formula& f : assumptions) {
+    if (is_true(f)) {
+      continue;
+    }
+    if (is_false(f)) {
+      unsat_assumptions_.push_back(f);
+      model_.set_empty();
+      return {};
+    }
+    assumed.push_back(f);
+    assumptions_.push_back(MakeAssumptionLiteral(f));
+  }
+  const optional<Box> result{CheckSatWithAssumptions(actual_precision)};
+  if (!result) {
+    const vector<Literal> failed{GetFailedAssumptions()};
+    for (size_t i = 0; i < assumed.size(); ++i) {
+      const Literal& l{assumptions_[i]};
+      if (find_if(failed.begin(), failed.end(), [&l](const Literal& l_) {
+            return l.first.get_id() == l_.first.get_id() &&
+                   l.second == l_.second;
+          }) != failed.end()) {
+        unsat_assumptions_.push_back(assumed[i]);
+      }
+    }
+  }
+  assumptions_.clear();
+  return result;
+}
+
+Literal Context::Impl::MakeAssumptionLiteral(const Formula& f) {
+  if (is_variable(f)) {
+    AddToBox(get_variable(f));
+    return {get_variable(f), true};
+  }
+  if (is_negation(f) && is_variable(get_operand(f))) {
+    AddToBox(get_variable(get_operand(f)));
+    return {get_variable(get_operand(f)), false};
+  }
+  const auto it = assumption_guards_.find(f);
+  if (it != assumption_guards_.end()) {
+    return {it->second, true};
+  }
+  static atomic<size_t> id{0};
+  const Variable guard{"assume" + std::to_string(id++),
+                       Variable::Type::BOOLEAN};
+  // Note that the following does not mark `guard` as a model variable.
+  AddToBox(guard);
+  Assert(imply(guard, f));
+  assumption_guards_.insert(f, guard);
+  return {guard, true};
+}
+
+optional<Box> Context::Impl::CheckSatWithAssumptions(
+    mpq_class* actual_precision) {
   auto result = CheckSatCore(stack_, box(), actual_precision);
   if (result) {
     // In case of delta-sat, do post-processing.
@@ -89,6 +197,126 @@ optional<Box> Context::Impl::CheckSat(mpq_class* actual_precision) {
   }
 }
 
+optional<Box> Context::Impl::CheckSatPortfolio(mpq_class* actual_precision) {
+  const int jobs{config_.number_of_jobs()};
+  DREAL_LOG_DEBUG("ContextImpl::CheckSatPortfolio(#jobs = {})", jobs);
+  if (box().empty()) {
+    portfolio_winner_ = 0;
+    model_.set_empty();
+    return {};
+  }
+  MakePortfolio();
+  // Raised by the first instance which finds an answer, to stop the others.
+  atomic<bool> cancelled{false};
+  // Through which the instances share the clauses they learn, unless it is
+  // disabled. It only lives for this check, since the clauses learned from
+  // the box may not hold in another scope.
+  unique_ptr<ClauseExchange> exchange;
+  if (config_.max_shared_clause_size() > 0) {
+    exchange = std::make_unique<ClauseExchange>(
+        kPortfolioExchangeCapacity, config_.max_shared_clause_size());
+  }
+  // The instance 0 is this context itself.
+  vector<Impl*> instances{this};
+  for (const unique_ptr<Impl>& instance : portfolio_) {
+    instance->box() = box();
+    instance->model_variables_ = model_variables_;
+    instances.push_back(instance.get());
+  }
+  mutex m;
+  int winner{-1};
+  optional<Box> result;
+  mpq_class precision;
+  vector<exception_ptr> errors(jobs);
+  {
+    ThreadPool pool{static_cast<size_t>(jobs)};
+    vector<future<void>> futures;
+    futures.reserve(jobs);
+    for (int i = 0; i < jobs; ++i) {
+      futures.push_back(pool.enqueue([&, i]() {
+        Impl* const instance{instances[i]};
+        try {
+          instance->SetCancelFlag(&cancelled);
+          if (exchange) {
+            instance->SetClauseExchange(exchange.get(), i);
+          }
+          mpq_class instance_precision{*actual_precision};
+          const optional<Box> instance_result{
+              instance->CheckSatWithAssumptions(&instance_precision)};
+          lock_guard<mutex> guard{m};
+          if (winner < 0) {
+            DREAL_LOG_DEBUG("ContextImpl::CheckSatPortfolio() - Instance {} "
+                            "answers first",
+                            i);
+            winner = i;
+            result = instance_result;
+            precision = instance_precision;
+            cancelled = true;
+          }
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+        // The flag and the exchange go away with this check.
+        instance->SetCancelFlag(nullptr);
+        instance->SetClauseExchange(nullptr, 0);
+      }));
+    }
+    for (future<void>& f : futures) {
+      f.get();
+    }
+  }
+  if (winner < 0) {
+    // No answer at all: every instance failed on its own.
+    for (const exception_ptr& e : errors) {
+      if (e) {
+        std::rethrow_exception(e);
+      }
+    }
+    DREAL_UNREACHABLE();
+  }
+  *actual_precision = precision;
+  portfolio_winner_ = winner;
+  if (result) {
+    model_ = *result;
+  } else {
+    model_.set_empty();
+  }
+  return result;
+}
+
+void Context::Impl::MakePortfolio() {
+  const int jobs{config_.number_of_jobs()};
+  const vector<size_t>& scopes{stack_.scopes()};
+  for (int i = static_cast<int>(portfolio_.size()) + 1; i < jobs; ++i) {
+    // Each instance has its own SAT and LP solvers, which are given the
+    // assertions of this context, scope by scope. Its box stays empty until
+    // the check, so that none of them is filtered into it.
+    unique_ptr<Impl> instance{make_impl(MakePortfolioConfig(config_, i))};
+    size_t scope{0};
+    for (size_t j = 0; j < stack_.size(); ++j) {
+      for (; scope < scopes.size() && scopes[scope] == j; ++scope) {
+        instance->Push();
+      }
+      instance->Assert(stack_[j]);
+    }
+    for (; scope < scopes.size(); ++scope) {
+      instance->Push();
+    }
+    portfolio_.push_back(std::move(instance));
+  }
+}
+
+void Context::Impl::SetCancelFlag(const atomic<bool>* const cancelled) {
+  cancelled_ = cancelled;
+}
+
+void Context::Impl::ThrowIfCancelled() const {
+  if (cancelled_ != nullptr && *cancelled_) {
+    DREAL_LOG_DEBUG("ContextImpl::ThrowIfCancelled() - Cancelled.");
+    throw DREAL_RUNTIME_ERROR("The check has been cancelled.");
+  }
+}
+
 int Context::Impl::CheckOpt(mpq_class* obj_lo, mpq_class* obj_up, Box* model) {
   int result = CheckOptCore(stack_, obj_lo, obj_up, model);
   if (LP_DELTA_OPTIMAL == result) {
@@ -238,6 +466,12 @@ const ScopedVector<Formula>& Context::Impl::assertions() const {
   return stack_;
 }
 
+Context::Statistics Context::Impl::statistics() const {
+  Statistics result;
+  result.portfolio_winner = portfolio_winner_;
+  return result;
+}
+
 bool Context::Impl::have_objective() const {
   return have_objective_;
 }
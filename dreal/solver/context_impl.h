@@ -2,11 +2,17 @@
 
 #include "dreal/solver/context.h"
 
+#include <atomic>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "dreal/util/clause_exchange.h"
+#include "dreal/util/if_then_else_eliminator.h"
+#include "dreal/util/literal.h"
+#include "dreal/util/scoped_unordered_map.h"
 #include "dreal/util/scoped_vector.h"
 
 namespace dreal {
@@ -20,13 +26,15 @@ class Context::Impl {
   Impl(Impl&&) = delete;
   Impl& operator=(const Impl&) = delete;
   Impl& operator=(Impl&&) = delete;
-  ~Impl() = default;
+  virtual ~Impl() = default;
 
   virtual void Assert(const Formula& f) = 0;
   virtual void Pop() = 0;
   virtual void Push() = 0;
 
   optional<Box> CheckSat(mpq_class* actual_precision);
+  optional<Box> CheckSatAssuming(const std::vector<Formula>& assumptions,
+                                 mpq_class* actual_precision);
   int CheckOpt(mpq_class* obj_lo, mpq_class* obj_up, Box* model);
   void DeclareVariable(const Variable& v, bool is_model_variable);
   void SetDomain(const Variable& v, const Expression& lb, const Expression& ub);
@@ -43,9 +51,21 @@ class Context::Impl {
   const ScopedVector<Formula>& assertions() const;
   Box& box() { return boxes_.last(); }
   const Box& get_model() { return model_; }
+  const std::vector<Formula>& unsat_assumptions() const {
+    return unsat_assumptions_;
+  }
+  virtual Statistics statistics() const;
   bool have_objective() const;
   bool is_max() const;
 
+  // Sets the flag which, once raised by another thread, makes the running
+  // check give up by throwing an exception.
+  virtual void SetCancelFlag(const std::atomic<bool>* cancelled);
+
+  // Shares the clauses learned from theory conflicts with the other
+  // instances of a portfolio through @p exchange, as the worker @p worker.
+  virtual void SetClauseExchange(ClauseExchange* exchange, int worker) = 0;
+
  protected:
   // Add the variable @p v to the current box. This is used to
   // introduce a non-model variable to solver. For a model variable,
@@ -60,6 +80,31 @@ class Context::Impl {
 
   virtual void MinimizeCore(const Expression& obj_expr) = 0;
 
+  // Checks the asserted formulas, under the literals in assumptions_.
+  optional<Box> CheckSatWithAssumptions(mpq_class* actual_precision);
+
+  // Checks the asserted formulas with config_.number_of_jobs() diversified
+  // instances running in parallel, and returns the first answer. This
+  // context is the first instance, and the others are kept in portfolio_.
+  optional<Box> CheckSatPortfolio(mpq_class* actual_precision);
+
+  // Adds the missing instances to portfolio_, with the assertions and the
+  // scopes of this context.
+  void MakePortfolio();
+
+  // Throws if the cancel flag has been raised. It is checked between the
+  // iterations of the SAT/LP loop.
+  void ThrowIfCancelled() const;
+
+  // Returns the assumptions in assumptions_ which the SAT solver used to
+  // show UNSAT in its last check.
+  virtual std::vector<Literal> GetFailedAssumptions() const = 0;
+
+  // Returns the literal to assume for the assumption @p f. A formula which
+  // is not a Boolean literal is guarded by a fresh Boolean variable `a`, and
+  // `a ⇒ f` is asserted (once per scope).
+  Literal MakeAssumptionLiteral(const Formula& f);
+
   // Marks variable @p v as a model variable
   void mark_model_variable(const Variable& v);
 
@@ -83,10 +128,35 @@ class Context::Impl {
   ScopedVector<Formula> stack_;
   std::unordered_set<Variable::Id> model_variables_;
 
+  // Literals assumed by the running CheckSatAssuming(). The SAT solver is
+  // given them in CheckSatCore().
+  std::vector<Literal> assumptions_;
+  // Result of the latest CheckSatAssuming(), if it was UNSAT.
+  std::vector<Formula> unsat_assumptions_;
+  // Guard variable of each non-literal assumption.
+  ScopedUnorderedMap<Formula, Variable> assumption_guards_;
+  // Eliminates the ite, min, max and abs terms of the asserted formulas. It
+  // is kept across assertions, so that a term shares its variable with its
+  // occurrences in the previous assertions of the current scope.
+  IfThenElseEliminator ite_eliminator_;
+
   // Stores the result of the latest checksat.
   // Note that if the checksat result was UNSAT, this box holds an empty box.
   Box model_;
 
+  // The instances of a portfolio other than this context, once it has run.
+  // They are kept across checks: the formulas asserted to this context and
+  // its scopes are forwarded to them. Those formulas are never bounds, which
+  // this context moves into its box, and the box is copied to them before
+  // each check.
+  std::vector<std::unique_ptr<Impl>> portfolio_;
+  // Instance which answered the latest check of the portfolio.
+  int portfolio_winner_{0};
+
+  // Raised when the answer of this instance of a portfolio is not needed
+  // any more. See CheckSatPortfolio().
+  const std::atomic<bool>* cancelled_{nullptr};
+
   // Keeps track of whether or not there is an objective function ...
   bool have_objective_;
   // ... and whether it's being maximized.
@@ -1,27 +1,27 @@
 #include "dreal/solver/filter_assertion.h"
 
-#include <cmath>
-#include <limits>
-
 #include "dreal/util/box.h"
-#include "dreal/util/exception.h"
 
 namespace dreal {
 namespace {
 
-using std::nextafter;
-using std::numeric_limits;
+// Note that the strict bounds below are relaxed into non-strict ones, as
+// the LP solvers do with strict inequalities (see the SAT solvers). The
+// type of a variable is not used either, since the integrality of a
+// variable is not enforced by the LP solvers.
 
-// Constrains the @p box with ` box[var].lb() == v`.
+// Constrains the @p box with `box[var] == v`.
 FilterAssertionResult UpdateBoundsViaEquality(const Variable& var,
-                                              const double v, Box* const box) {
+                                              const mpq_class& v,
+                                              Box* const box) {
+  if (!box->has_variable(var)) {
+    return FilterAssertionResult::NotFiltered;
+  }
   Box::Interval& intv{(*box)[var]};
-  const double lb{intv.lb()};
-  const double ub{intv.ub()};
-  if (lb == ub && lb == v) {
+  if (intv.lb() == v && intv.ub() == v) {
     return FilterAssertionResult::FilteredWithoutChange;
   }
-  if (intv.contains(v)) {
+  if (intv.lb() <= v && v <= intv.ub()) {
     intv = v;
   } else {
     box->set_empty();
@@ -29,82 +29,58 @@ FilterAssertionResult UpdateBoundsViaEquality(const Variable& var,
   return FilterAssertionResult::FilteredWithChange;
 }
 
-// Constrains the @p box with ` box[var].lb() >= v`.
-FilterAssertionResult UpdateLowerBound(const Variable& var, const double new_lb,
+// Constrains the @p box with `box[var].lb() >= new_lb`.
+FilterAssertionResult UpdateLowerBound(const Variable& var,
+                                       const mpq_class& new_lb,
                                        Box* const box) {
+  if (!box->has_variable(var)) {
+    return FilterAssertionResult::NotFiltered;
+  }
   Box::Interval& intv{(*box)[var]};
-  const double lb{intv.lb()};
-  const double ub{intv.ub()};
-  if (new_lb <= lb) {
+  if (new_lb <= intv.lb()) {
     return FilterAssertionResult::FilteredWithoutChange;
   }
-  if (new_lb <= ub) {
-    intv = Box::Interval(new_lb, ub);
+  if (new_lb <= intv.ub()) {
+    intv = Box::Interval(new_lb, intv.ub());
   } else {
     box->set_empty();
   }
   return FilterAssertionResult::FilteredWithChange;
 }
 
-// Constrains the @p box with `box[var].lb() > v`. It changes the
-// strict inequality into a non-strict one:
-//
-//   If var is of CONTINUOUS type: `box[var].lb() >= v + ε`
-//                                 where `v + ε` is the smallest representable
-//                                 floating-point number bigger than `v`.
-//   Otherwise (INTEGER/BINARY)  : `box[var].lb() >= v + 1`
-FilterAssertionResult UpdateStrictLowerBound(const Variable& var,
-                                             const double v, Box* const box) {
-  switch (var.get_type()) {
-    case Variable::Type::CONTINUOUS:
-      return UpdateLowerBound(var, nextafter(v, numeric_limits<double>::max()),
-                              box);
-    case Variable::Type::INTEGER:
-    case Variable::Type::BINARY:
-      return UpdateLowerBound(var, v + 1, box);
-    case Variable::Type::BOOLEAN:
-      DREAL_UNREACHABLE();
-  }
-  DREAL_UNREACHABLE();
-}
-
-// Constrains the @p box with ` box[var].ub() <= v`.
-FilterAssertionResult UpdateUpperBound(const Variable& var, const double new_ub,
+// Constrains the @p box with `box[var].ub() <= new_ub`.
+FilterAssertionResult UpdateUpperBound(const Variable& var,
+                                       const mpq_class& new_ub,
                                        Box* const box) {
+  if (!box->has_variable(var)) {
+    return FilterAssertionResult::NotFiltered;
+  }
   Box::Interval& intv{(*box)[var]};
-  const double lb{intv.lb()};
-  const double ub{intv.ub()};
-  if (new_ub >= ub) {
+  if (new_ub >= intv.ub()) {
     return FilterAssertionResult::FilteredWithoutChange;
   }
-  if (new_ub >= lb) {
-    intv = Box::Interval(lb, new_ub);
+  if (new_ub >= intv.lb()) {
+    intv = Box::Interval(intv.lb(), new_ub);
   } else {
     box->set_empty();
   }
   return FilterAssertionResult::FilteredWithChange;
 }
 
-// Constrains the @p box with `box[var].ub() < v`. It changes the
-// strict inequality into a non-strict one:
-//
-//   If var is of CONTINUOUS type: `box[var].ub() <= v - ε`
-//                                 where `v - ε` is the largest representable
-//                                 floating-point number smaller than `v`.
-//   Otherwise (INTEGER/BINARY)  : `box[var].ub() <= v - 1`
+// Constrains the @p box with `box[var].lb() > v`, relaxed into
+// `box[var].lb() >= v`.
+FilterAssertionResult UpdateStrictLowerBound(const Variable& var,
+                                             const mpq_class& v,
+                                             Box* const box) {
+  return UpdateLowerBound(var, v, box);
+}
+
+// Constrains the @p box with `box[var].ub() < v`, relaxed into
+// `box[var].ub() <= v`.
 FilterAssertionResult UpdateStrictUpperBound(const Variable& var,
-                                             const double v, Box* const box) {
-  switch (var.get_type()) {
-    case Variable::Type::CONTINUOUS:
-      return UpdateUpperBound(var, nextafter(v, numeric_limits<double>::min()),
-                              box);
-    case Variable::Type::INTEGER:
-    case Variable::Type::BINARY:
-      return UpdateUpperBound(var, v - 1, box);
-    case Variable::Type::BOOLEAN:
-      DREAL_UNREACHABLE();
-  }
-  DREAL_UNREACHABLE();
+                                             const mpq_class& v,
+                                             Box* const box) {
+  return UpdateUpperBound(var, v, box);
 }
 
 class AssertionFilter {
@@ -144,14 +120,14 @@ class AssertionFilter {
       if (is_constant(rhs)) {
         // var = v
         const Variable& var{get_variable(lhs)};
-        const double v{get_constant_value(rhs)};
+        const mpq_class v{get_constant_value(rhs)};
         return UpdateBoundsViaEquality(var, v, box);
       }
     }
     if (is_variable(rhs)) {
       if (is_constant(lhs)) {
         // v = var
-        const double v{get_constant_value(lhs)};
+        const mpq_class v{get_constant_value(lhs)};
         const Variable& var{get_variable(rhs)};
         return UpdateBoundsViaEquality(var, v, box);
       }
@@ -171,7 +147,7 @@ class AssertionFilter {
     if (is_variable(lhs)) {
       if (is_constant(rhs)) {
         const Variable& var{get_variable(lhs)};
-        const double v{get_constant_value(rhs)};
+        const mpq_class v{get_constant_value(rhs)};
         if (polarity) {
           // var > v
           return UpdateStrictLowerBound(var, v, box);
@@ -183,7 +159,7 @@ class AssertionFilter {
     }
     if (is_variable(rhs)) {
       if (is_constant(lhs)) {
-        const double v{get_constant_value(lhs)};
+        const mpq_class v{get_constant_value(lhs)};
         const Variable& var{get_variable(rhs)};
         if (polarity) {
           // v > var
@@ -204,7 +180,7 @@ class AssertionFilter {
     if (is_variable(lhs)) {
       if (is_constant(rhs)) {
         const Variable& var{get_variable(lhs)};
-        const double v{get_constant_value(rhs)};
+        const mpq_class v{get_constant_value(rhs)};
         if (polarity) {
           // var >= v
           return UpdateLowerBound(var, v, box);
@@ -216,7 +192,7 @@ class AssertionFilter {
     }
     if (is_variable(rhs)) {
       if (is_constant(lhs)) {
-        const double v{get_constant_value(lhs)};
+        const mpq_class v{get_constant_value(lhs)};
         const Variable& var{get_variable(rhs)};
         if (polarity) {
           // v >= var
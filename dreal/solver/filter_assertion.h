@@ -11,8 +11,10 @@ enum class FilterAssertionResult {
   FilteredWithoutChange,
 };
 
-/// If the @p assertion can be applied into the @p box update @p box
-/// and return true. Otherwise, return false while keeping @p box
-/// intact.
+/// If the @p assertion is a bound on a variable of the @p box (e.g. `x <= 3`
+/// or `¬(2 < x)`), applies it to @p box, which is emptied if the bound is
+/// violated. Otherwise, returns NotFiltered while keeping @p box intact.
+///
+/// The bounds are exact. A strict bound is relaxed into a non-strict one.
 FilterAssertionResult FilterAssertion(const Formula& assertion, Box* box);
 }  // namespace dreal
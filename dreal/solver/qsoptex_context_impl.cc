@@ -5,7 +5,7 @@
 
 #include <fmt/format.h>
 
-//#include "dreal/solver/filter_assertion.h"
+#include "dreal/solver/filter_assertion.h"
 #include "dreal/util/assert.h"
 #include "dreal/util/exception.h"
 #include "dreal/util/if_then_else_eliminator.h"
@@ -34,24 +34,24 @@ void Context::QsoptexImpl::Assert(const Formula& f) {
     box().set_empty();
     return;
   }
-  //if (FilterAssertion(f, &box()) == FilterAssertionResult::NotFiltered) {
+  // A bound on a variable, e.g. `x <= 5`, is applied to the box, which is
+  // emptied if the bound is violated. It is not given to the SAT solver.
+  if (FilterAssertion(f, &box()) != FilterAssertionResult::NotFiltered) {
+    DREAL_LOG_DEBUG("Context::QsoptexImpl::Assert: {} is not added.", f);
+    DREAL_LOG_DEBUG("Box=\n{}", box());
+    return;
+  }
   DREAL_LOG_DEBUG("Context::QsoptexImpl::Assert: {} is added.", f);
-  IfThenElseEliminator ite_eliminator;
-  const Formula no_ite{ite_eliminator.Process(f)};
-  for (const Variable& ite_var : ite_eliminator.variables()) {
+  const Formula no_ite{ite_eliminator_.Process(f, box())};
+  for (const Variable& ite_var : ite_eliminator_.variables()) {
     // Note that the following does not mark `ite_var` as a model variable.
     AddToBox(ite_var);
   }
   stack_.push_back(no_ite);
   sat_solver_.AddFormula(no_ite);
-  return;
-#if 0
-  } else {
-    DREAL_LOG_DEBUG("Context::QsoptexImpl::Assert: {} is not added.", f);
-    DREAL_LOG_DEBUG("Box=\n{}", box());
-    return;
+  for (const auto& instance : portfolio_) {
+    instance->Assert(no_ite);
   }
-#endif
 }  // namespace dreal
 
 optional<Box> Context::QsoptexImpl::CheckSatCore(const ScopedVector<Formula>& stack,
@@ -59,6 +59,7 @@ optional<Box> Context::QsoptexImpl::CheckSatCore(const ScopedVector<Formula>& st
                                                  mpq_class* actual_precision) {
   DREAL_LOG_DEBUG("Context::QsoptexImpl::CheckSatCore()");
   DREAL_LOG_TRACE("Context::QsoptexImpl::CheckSat: Box =\n{}", box);
+  sat_solver_.SetAssumptions(assumptions_);
   if (box.empty()) {
     return {};
   }
@@ -68,8 +69,10 @@ optional<Box> Context::QsoptexImpl::CheckSatCore(const ScopedVector<Formula>& st
       return {};
     }
   }
-  // If stack = ∅ or stack = {true}, it's trivially SAT.
-  if (stack.empty() || (stack.size() == 1 && is_true(stack.first()))) {
+  // If stack = ∅ or stack = {true}, and nothing is assumed, it's trivially
+  // SAT.
+  if (assumptions_.empty() &&
+      (stack.empty() || (stack.size() == 1 && is_true(stack.first())))) {
     DREAL_LOG_DEBUG("Context::QsoptexImpl::CheckSatCore() - Found Model\n{}", box);
     return box;
   }
@@ -83,6 +86,7 @@ optional<Box> Context::QsoptexImpl::CheckSatCore(const ScopedVector<Formula>& st
       throw std::runtime_error("KeyboardInterrupt(SIGINT) Detected.");
     }
 #endif
+    ThrowIfCancelled();
 
     // The box is passed in to the SAT solver solely to provide the LP solver
     // with initial bounds on the numerical variables.
@@ -104,6 +108,9 @@ optional<Box> Context::QsoptexImpl::CheckSatCore(const ScopedVector<Formula>& st
         int theory_result{
           theory_solver_.CheckSat(box, theory_model,
                                   sat_solver_.GetLinearSolver(),
+                                  sat_solver_.GetLinearRowMap(),
+                                  sat_solver_.GetLowerBoundLiterals(),
+                                  sat_solver_.GetUpperBoundLiterals(),
                                   sat_solver_.GetLinearVarMap(),
                                   actual_precision)};
         if (theory_result == SAT_DELTA_SATISFIABLE) {
@@ -128,6 +135,10 @@ optional<Box> Context::QsoptexImpl::CheckSatCore(const ScopedVector<Formula>& st
               "size = {}",
               explanation.size(), stack.get_vector().size());
           sat_solver_.AddLearnedClause(explanation);
+          if (theory_result == SAT_UNSATISFIABLE) {
+            // Only a proper conflict holds for the other workers as well.
+            sat_solver_.ShareLearnedClause(explanation);
+          }
         }
       } else {
         return box;
@@ -150,6 +161,8 @@ int Context::QsoptexImpl::CheckOptCore(const ScopedVector<Formula>& stack,
                                        Box* box) {
   DREAL_LOG_DEBUG("Context::QsoptexImpl::CheckOptCore()");
   DREAL_LOG_TRACE("Context::QsoptexImpl::CheckOpt: Box =\n{}", *box);
+  // Assumptions are only supported by CheckSatAssuming().
+  sat_solver_.SetAssumptions({});
   if (box->empty()) {
     return LP_INFEASIBLE;
   }
@@ -167,6 +180,7 @@ int Context::QsoptexImpl::CheckOptCore(const ScopedVector<Formula>& stack,
   //}
   bool have_unsolved = false;
   bool have_opt_cand = false;  // optimality candidate
+  bool have_cutoff_conflict = false;  // some region was pruned by the cutoff
   mpq_class new_obj_up, new_obj_lo;  // Upper and lower bounds of new optimality candidate
   while (true) {
     // Note that 'DREAL_CHECK_INTERRUPT' is only defined in setup.py,
@@ -198,12 +212,23 @@ int Context::QsoptexImpl::CheckOptCore(const ScopedVector<Formula>& stack,
       // SAT from SATSolver.
       DREAL_LOG_DEBUG("Context::QsoptexImpl::CheckOptCore() - Sat Check = SAT");
 
+      // Once there is a candidate, only regions which can beat it by more
+      // than the precision are of interest. The cutoff only ever decreases,
+      // so the explanations learned with it remain valid for later regions.
+      optional<mpq_class> obj_cutoff;
+      if (have_opt_cand && config_.objective_cutoff()) {
+        obj_cutoff = *obj_up - config_.precision();
+      }
+
       // The selected assertions (and objective function, where applicable)
       // have already been enabled in the LP solver.
       int theory_result{
         theory_solver_.CheckOpt(*box, &new_obj_lo, &new_obj_up, theory_model,
                                 sat_solver_.GetLinearSolver(),
-                                sat_solver_.GetLinearVarMap())};
+                                sat_solver_.GetLinearRowMap(),
+                                sat_solver_.GetLowerBoundLiterals(),
+                                sat_solver_.GetUpperBoundLiterals(),
+                                sat_solver_.GetLinearVarMap(), obj_cutoff)};
       if (LP_UNBOUNDED == theory_result) {
         DREAL_LOG_DEBUG("Context::QsoptexImpl::CheckOptCore() - Theory Check = UNBOUNDED");
         // Result is correct - can return immediately.
@@ -239,6 +264,10 @@ int Context::QsoptexImpl::CheckOptCore(const ScopedVector<Formula>& stack,
           DREAL_LOG_DEBUG(
               "Context::QsoptexImpl::CheckOptCore() - Theory Check = INFEASIBLE");
           // Must continue - to ensure that all regions are infeasible.
+          if (obj_cutoff) {
+            // The region may be feasible, with an optimum above the cutoff.
+            have_cutoff_conflict = true;
+          }
         } else {
           DREAL_ASSERT(LP_UNSOLVED == theory_result);
           DREAL_LOG_DEBUG("Context::QsoptexImpl::CheckOptCore() - Theory Check = UNKNOWN");
@@ -261,6 +290,11 @@ int Context::QsoptexImpl::CheckOptCore(const ScopedVector<Formula>& stack,
         throw DREAL_RUNTIME_ERROR("LP solver failed to solve some instances");
       } else if (have_opt_cand) {
         DREAL_LOG_DEBUG("Context::QsoptexImpl::CheckOptCore() - Sat Check = delta-OPTIMAL");
+        // The pruned regions can't go below the last cutoff, which is the
+        // lowest one.
+        if (have_cutoff_conflict && *obj_up - config_.precision() < *obj_lo) {
+          *obj_lo = *obj_up - config_.precision();
+        }
         return LP_DELTA_OPTIMAL;
       } else {
         DREAL_LOG_DEBUG("Context::QsoptexImpl::CheckOptCore() - Sat Check = INFEASIBLE");
@@ -280,7 +314,12 @@ void Context::QsoptexImpl::Pop() {
   DREAL_LOG_DEBUG("Context::QsoptexImpl::Pop()");
   stack_.pop();
   boxes_.pop();
+  assumption_guards_.pop();
+  ite_eliminator_.Pop();
   sat_solver_.Pop();
+  for (const auto& instance : portfolio_) {
+    instance->Pop();
+  }
 }
 
 void Context::QsoptexImpl::Push() {
@@ -288,7 +327,26 @@ void Context::QsoptexImpl::Push() {
   sat_solver_.Push();
   boxes_.push();
   boxes_.push_back(boxes_.last());
+  assumption_guards_.push();
+  ite_eliminator_.Push();
   stack_.push();
+  for (const auto& instance : portfolio_) {
+    instance->Push();
+  }
+}
+
+void Context::QsoptexImpl::SetCancelFlag(const std::atomic<bool>* const cancelled) {
+  Impl::SetCancelFlag(cancelled);
+  sat_solver_.SetCancelFlag(cancelled);
+}
+
+void Context::QsoptexImpl::SetClauseExchange(ClauseExchange* const exchange,
+                                             const int worker) {
+  sat_solver_.SetClauseExchange(exchange, worker);
+}
+
+vector<Literal> Context::QsoptexImpl::GetFailedAssumptions() const {
+  return sat_solver_.GetFailedAssumptions();
 }
 
 }  // namespace dreal
@@ -16,6 +16,9 @@ class Context::QsoptexImpl : public Context::Impl {
   void Pop();
   void Push();
 
+  void SetCancelFlag(const std::atomic<bool>* cancelled) override;
+  void SetClauseExchange(ClauseExchange* exchange, int worker) override;
+
  protected:
   // Returns the current box in the stack.
   optional<Box> CheckSatCore(const ScopedVector<Formula>& stack, Box box, mpq_class* actual_precision);
@@ -23,6 +26,8 @@ class Context::QsoptexImpl : public Context::Impl {
 
   void MinimizeCore(const Expression& obj_expr);
 
+  std::vector<Literal> GetFailedAssumptions() const;
+
   QsoptexSatSolver sat_solver_;
   QsoptexTheorySolver theory_solver_;
   Expression obj_expr_;
@@ -1,5 +1,7 @@
 #include "dreal/solver/qsoptex_sat_solver.h"
 
+#include <atomic>
+#include <iterator>
 #include <ostream>
 #include <utility>
 #include <cmath>
@@ -13,8 +15,14 @@
 
 namespace dreal {
 
+namespace {
+// Interrupt callback of PicoSAT. @p state is the cancel flag.
+int IsCancelled(void* const state) {
+  return *static_cast<const std::atomic<bool>*>(state) ? 1 : 0;
+}
+}  // namespace
+
 using std::cout;
-using std::set;
 using std::vector;
 using std::pair;
 using std::make_pair;
@@ -27,6 +35,8 @@ using qsopt_ex::mpq_QSget_rowcount;
 using qsopt_ex::mpq_QSnew_row;
 using qsopt_ex::mpq_QSget_colcount;
 using qsopt_ex::mpq_QSnew_col;
+using qsopt_ex::mpq_QSdelete_rows;
+using qsopt_ex::mpq_QSdelete_cols;
 using qsopt_ex::mpq_ILL_MINDOUBLE;  // mpq_NINFTY
 using qsopt_ex::mpq_ILL_MAXDOUBLE;  // mpq_INFTY
 using dreal::util::mpq_ninfty;  // mpq_class versions
@@ -35,7 +45,7 @@ using qsopt_ex::__zeroLpNum_mpq__;  // mpq_zeroLpNum
 using qsopt_ex::__oneLpNum_mpq__;  // mpq_oneLpNum
 
 QsoptexSatSolver::QsoptexSatSolver(const Config& config) : sat_{picosat_init()},
-    cur_clause_start_{0}, config_(config) {
+    config_(config) {
   // Enable partial checks via picosat_deref_partial. See the call-site in
   // QsoptexSatSolver::CheckSat().
   picosat_save_original_clauses(sat_);
@@ -76,6 +86,7 @@ void QsoptexSatSolver::AddFormula(const Formula& f) {
     clause = predicate_abstractor_.Convert(clause);
   }
   AddClauses(clauses);
+  AddBoundImplications(clauses);
 }
 
 void QsoptexSatSolver::AddFormulas(const vector<Formula>& formulas) {
@@ -97,6 +108,24 @@ void QsoptexSatSolver::AddClauses(const vector<Formula>& formulas) {
   }
 }
 
+void QsoptexSatSolver::AddBoundImplications(const vector<Formula>& clauses) {
+  const auto& var_to_formula_map = predicate_abstractor_.var_to_formula_map();
+  for (const Formula& clause : clauses) {
+    for (const Variable& var : clause.GetFreeVariables()) {
+      const auto it = var_to_formula_map.find(var);
+      if (it == var_to_formula_map.end()) {
+        continue;
+      }
+      for (const auto& p : bound_implicator_.Add(var, it->second)) {
+        DREAL_LOG_DEBUG("QsoptexSatSolver::AddBoundImplications({}{} ∨ {}{})",
+                        p.first.second ? "¬" : "", p.first.first,
+                        p.second.second ? "¬" : "", p.second.first);
+        AddLearnedClause(LiteralSet{p.first, p.second});
+      }
+    }
+  }
+}
+
 void QsoptexSatSolver::AddClause(const Formula& f) {
   DREAL_LOG_DEBUG("QsoptexSatSolver::AddClause({})", f);
   // Set up Variable ⇔ Literal (in SAT) map.
@@ -126,57 +155,23 @@ class SatSolverStat : public Stat {
     }
   }
 
-  int num_check_sat_{0};
-  Timer timer_check_sat_;
+  void increase_num_check_sat() { increase(&num_check_sat_); }
+
+  ConcurrentTimer timer_check_sat_;
+
+ private:
+  std::atomic<int> num_check_sat_{0};
 };
 }  // namespace
 
 // Collect active literals, removing those that are only required by learned
 // clauses.
-set<int> QsoptexSatSolver::GetMainActiveLiterals() const {
-    set<int> lits;
-    for (int i = 1; i <= picosat_variables(sat_); ++i) {
-      const int model_i{has_picosat_pop_used_ ? picosat_deref(sat_, i)
-                                              : picosat_deref_partial(sat_, i)};
-      if (model_i == 0) {
-        continue;
-      }
-      lits.insert(model_i * i);
-    }
-    for (auto it = lits.begin(); it != lits.end(); ) {
-      int i = *it;
-      int required = false;
-      // Determine whether literal `i' is required
-      auto c_it = main_clause_lookup_.find(i);
-      if (c_it != main_clause_lookup_.end()) {
-        for (int c : c_it->second) {
-          int count = 0;
-          size_t j;
-          for (j = c; j < main_clauses_copy_.size() &&
-                          main_clauses_copy_[j]; ++j) {
-            int k{main_clauses_copy_[j]};
-            if (lits.find(k) != lits.end()) {
-              ++count;
-            }
-          }
-          DREAL_ASSERT(j < main_clauses_copy_.size());  // Detect buffer overrun
-          DREAL_ASSERT(count > 0);  // Should contain at least `i'
-          if (count == 1) {
-            // `i' is the only active literal in clause `c'; hence, required.
-            required = true;
-            break;
-          }
-        }
-      }
-      if (!required) {
-        // There is more than one literal in every main (non-learned) clause
-        // containing literal `i'.  Hence, it is not required.
-        it = lits.erase(it);
-      } else {
-        ++it;
-      }
-    }
-    return lits;
+const vector<int>& QsoptexSatSolver::GetMainActiveLiterals() {
+  return main_clauses_.GetActiveLiterals(
+      picosat_variables(sat_), [this](const int i) {
+        return has_picosat_pop_used_ ? picosat_deref(sat_, i)
+                                     : picosat_deref_partial(sat_, i);
+      });
 }
 
 optional<QsoptexSatSolver::Model>
@@ -194,17 +189,27 @@ QsoptexSatSolver::CheckSat(const Box& box,
     ClearLinearObjective();
   }
 
-  stat.num_check_sat_++;
+  ImportSharedClauses();
+
+  // PicoSAT forgets the assumptions after each call, so they are given again.
+  failed_assumptions_.clear();
+  for (const Literal& l : assumptions_) {
+    MakeSatVar(l.first);
+    const int lit{to_sat_var_[l.first.get_id()]};
+    picosat_assume(sat_, l.second ? lit : -lit);
+  }
+
+  stat.increase_num_check_sat();
   // Call SAT solver.
-  TimerGuard check_sat_timer_guard(&stat.timer_check_sat_,
-                                   DREAL_LOG_INFO_ENABLED);
+  ConcurrentTimerGuard check_sat_timer_guard(&stat.timer_check_sat_,
+                                             DREAL_LOG_INFO_ENABLED);
   const int ret{picosat_sat(sat_, -1)};
   check_sat_timer_guard.pause();
 
   Model model;
   if (ret == PICOSAT_SATISFIABLE) {
     // SAT Case.
-    set<int> lits{GetMainActiveLiterals()};
+    const vector<int>& lits{GetMainActiveLiterals()};
     ResetLinearProblem(box);
     const auto& var_to_formula_map = predicate_abstractor_.var_to_formula_map();
     for (int i : lits) {
@@ -240,48 +245,185 @@ QsoptexSatSolver::CheckSat(const Box& box,
   } else if (ret == PICOSAT_UNSATISFIABLE) {
     DREAL_LOG_DEBUG("QsoptexSatSolver::CheckSat() No solution.");
     // UNSAT Case.
+    for (const Literal& l : assumptions_) {
+      const int lit{to_sat_var_[l.first.get_id()]};
+      if (picosat_failed_assumption(sat_, l.second ? lit : -lit)) {
+        failed_assumptions_.push_back(l);
+      }
+    }
     return {};
   } else {
     DREAL_ASSERT(ret == PICOSAT_UNKNOWN);
+    if (cancelled_ != nullptr && *cancelled_) {
+      DREAL_LOG_DEBUG("QsoptexSatSolver::CheckSat() Cancelled.");
+      throw DREAL_RUNTIME_ERROR("QsoptexSatSolver::CheckSat() was cancelled.");
+    }
     DREAL_LOG_CRITICAL("PICOSAT returns PICOSAT_UNKNOWN.");
     throw DREAL_RUNTIME_ERROR("PICOSAT returns PICOSAT_UNKNOWN.");
   }
 }
 
+void QsoptexSatSolver::SetAssumptions(const vector<Literal>& literals) {
+  DREAL_LOG_DEBUG("QsoptexSatSolver::SetAssumptions(#literals = {})",
+                  literals.size());
+  assumptions_ = literals;
+  failed_assumptions_.clear();
+}
+
+void QsoptexSatSolver::SetCancelFlag(const std::atomic<bool>* const cancelled) {
+  cancelled_ = cancelled;
+  // PicoSAT calls the callback from time to time during the search, and
+  // returns PICOSAT_UNKNOWN as soon as it yields a non-zero value.
+  if (cancelled != nullptr) {
+    picosat_set_interrupt(sat_, const_cast<std::atomic<bool>*>(cancelled),
+                          IsCancelled);
+  } else {
+    picosat_set_interrupt(sat_, nullptr, nullptr);
+  }
+}
+
+void QsoptexSatSolver::SetClauseExchange(ClauseExchange* const exchange,
+                                         const int worker) {
+  clause_exchange_ = exchange;
+  clause_exchange_worker_ = worker;
+  clause_exchange_cursor_ = 0;
+  // The ids are only valid in the exchange which gave them.
+  to_shared_atom_.clear();
+  from_shared_atom_.clear();
+}
+
+void QsoptexSatSolver::ShareLearnedClause(const LiteralSet& literals) {
+  if (clause_exchange_ == nullptr ||
+      static_cast<int>(literals.size()) > clause_exchange_->max_clause_size()) {
+    return;
+  }
+  const auto& var_to_formula_map = predicate_abstractor_.var_to_formula_map();
+  vector<int> clause;
+  clause.reserve(literals.size());
+  for (const Literal& l : literals) {
+    auto it = to_shared_atom_.find(l.first.get_id());
+    if (it == to_shared_atom_.end()) {
+      const auto atom_it = var_to_formula_map.find(l.first);
+      if (atom_it == var_to_formula_map.end()) {
+        // Not a theory atom, e.g. the guard of an assumption.
+        return;
+      }
+      const int id{clause_exchange_->AtomId(atom_it->second)};
+      it = to_shared_atom_.emplace(l.first.get_id(), id).first;
+      from_shared_atom_.emplace(id, l.first);
+    }
+    // The learned clause is the negation of the explanation.
+    clause.push_back(l.second ? -(it->second + 1) : it->second + 1);
+  }
+  clause_exchange_->Publish(clause_exchange_worker_, clause);
+}
+
+void QsoptexSatSolver::ImportSharedClauses() {
+  if (clause_exchange_ == nullptr) {
+    return;
+  }
+  const auto& formula_to_var_map = predicate_abstractor_.formula_to_var_map();
+  for (const vector<int>& clause : clause_exchange_->Collect(
+           clause_exchange_worker_, &clause_exchange_cursor_)) {
+    LiteralSet explanation;
+    for (const int lit : clause) {
+      const int id{abs(lit) - 1};
+      auto it = from_shared_atom_.find(id);
+      if (it == from_shared_atom_.end()) {
+        const auto var_it = formula_to_var_map.find(clause_exchange_->atom(id));
+        if (var_it == formula_to_var_map.end()) {
+          break;
+        }
+        it = from_shared_atom_.emplace(id, var_it->second).first;
+        to_shared_atom_.emplace(var_it->second.get_id(), id);
+      }
+      if (to_sat_var_.count(it->second.get_id()) == 0) {
+        break;
+      }
+      explanation.emplace(it->second, lit < 0);
+    }
+    // A clause on an atom which this worker doesn't know is dropped.
+    if (explanation.size() == clause.size()) {
+      DREAL_LOG_DEBUG("QsoptexSatSolver::ImportSharedClauses() #literals = {}",
+                      clause.size());
+      AddLearnedClause(explanation);
+    }
+  }
+}
+
 void QsoptexSatSolver::Pop() {
-  // FIXME: disabled for QSopt_ex changes
-  throw DREAL_RUNTIME_ERROR("QsoptexSatSolver::Pop() currently unsupported");
   DREAL_LOG_DEBUG("QsoptexSatSolver::Pop()");
+  if (scopes_.empty()) {
+    throw DREAL_RUNTIME_ERROR(
+        "QsoptexSatSolver cannot be popped because its scope is empty.");
+  }
+  const Scope& scope{scopes_.back()};
   cnf_variables_.pop();
+  cnfizer_.Pop();
   to_sym_var_.pop();
   to_sat_var_.pop();
+  bound_implicator_.Pop();
   picosat_pop(sat_);
   has_picosat_pop_used_ = true;
+
+  // Forget the main clauses added in this scope.
+  main_clauses_.Resize(scope.main_clauses);
+
+  // Remove the rows and columns created in this scope. They are always at
+  // the end of the LP.
+  const int qsx_rows{mpq_QSget_rowcount(qsx_prob_)};
+  if (qsx_rows > scope.rows) {
+    vector<int> rows;
+    for (int i = scope.rows; i < qsx_rows; ++i) {
+      rows.push_back(i);
+    }
+    mpq_QSdelete_rows(qsx_prob_, static_cast<int>(rows.size()), rows.data());
+    for (auto it = to_qsx_row_.begin(); it != to_qsx_row_.end();) {
+      it = it->second >= scope.rows ? to_qsx_row_.erase(it) : std::next(it);
+    }
+    from_qsx_row_.resize(scope.rows);
+    qsx_rhs_.resize(scope.rows);
+    qsx_sense_.resize(scope.rows);
+  }
+  const int qsx_cols{mpq_QSget_colcount(qsx_prob_)};
+  if (qsx_cols > scope.cols) {
+    vector<int> cols;
+    for (int i = scope.cols; i < qsx_cols; ++i) {
+      cols.push_back(i);
+    }
+    mpq_QSdelete_cols(qsx_prob_, static_cast<int>(cols.size()), cols.data());
+    for (auto it = to_qsx_col_.begin(); it != to_qsx_col_.end();) {
+      it = it->second >= scope.cols ? to_qsx_col_.erase(it) : std::next(it);
+    }
+    from_qsx_col_.erase(from_qsx_col_.lower_bound(scope.cols),
+                        from_qsx_col_.end());
+    qsx_lower_lit_.resize(scope.cols);
+    qsx_upper_lit_.resize(scope.cols);
+  }
+  scopes_.pop_back();
 }
 
 void QsoptexSatSolver::Push() {
-  // FIXME: disabled for QSopt_ex changes
-  throw DREAL_RUNTIME_ERROR("QsoptexSatSolver::Push() currently unsupported");
   DREAL_LOG_DEBUG("QsoptexSatSolver::Push()");
+  scopes_.push_back({mpq_QSget_rowcount(qsx_prob_),
+                     mpq_QSget_colcount(qsx_prob_), main_clauses_.size()});
   picosat_push(sat_);
+  bound_implicator_.Push();
   to_sat_var_.push();
   to_sym_var_.push();
   cnf_variables_.push();
+  cnfizer_.Push();
 }
 
-void QsoptexSatSolver::SetQSXVarCoef(int qsx_row, const Variable& var,
+void QsoptexSatSolver::SetQSXVarCoef(int qsx_row, int qsx_col,
                               const mpq_class& value) {
-  const auto it = to_qsx_col_.find(var.get_id());
-  if (it == to_qsx_col_.end()) {
-    throw DREAL_RUNTIME_ERROR("Variable undefined: {}", var);
-  }
   if (value <= mpq_ninfty() || value >= mpq_infty()) {
     throw DREAL_RUNTIME_ERROR("LP coefficient too large: {}", value);
   }
   mpq_t c_value;
   mpq_init(c_value);
   mpq_set(c_value, value.get_mpq_t());
-  mpq_QSchange_coef(qsx_prob_, qsx_row, it->second, c_value);
+  mpq_QSchange_coef(qsx_prob_, qsx_row, qsx_col, c_value);
   mpq_clear(c_value);
 }
 
@@ -301,12 +443,13 @@ void QsoptexSatSolver::SetQSXVarObjCoef(const Variable& var,
   mpq_clear(c_value);
 }
 
-void QsoptexSatSolver::SetQSXVarBound(const Variable& var, const char type,
-                               const mpq_class& value) {
+void QsoptexSatSolver::SetQSXVarBound(const Literal& lit, const Variable& var,
+                                      const char type,
+                                      const mpq_class& value) {
   if (type == 'B') {
     // Both
-    SetQSXVarBound(var, 'L', value);
-    SetQSXVarBound(var, 'U', value);
+    SetQSXVarBound(lit, var, 'L', value);
+    SetQSXVarBound(lit, var, 'U', value);
     return;
   }
   DREAL_ASSERT(type == 'L' || type == 'U');
@@ -324,6 +467,11 @@ void QsoptexSatSolver::SetQSXVarBound(const Variable& var, const char type,
   if ((type == 'L' && existing < value) || (type == 'U' && value < existing)) {
     mpq_set(c_value, value.get_mpq_t());
     mpq_QSchange_bound(qsx_prob_, it->second, type, c_value);
+    if (type == 'L') {
+      qsx_lower_lit_[it->second] = lit;
+    } else {
+      qsx_upper_lit_[it->second] = lit;
+    }
   }
   mpq_clear(c_value);
 }
@@ -351,6 +499,8 @@ void QsoptexSatSolver::ResetLinearProblem(const Box& box) {
       mpq_QSchange_bound(qsx_prob_, kv.first, 'L', mpq_NINFTY);
       mpq_QSchange_bound(qsx_prob_, kv.first, 'U', mpq_INFTY);
     }
+    qsx_lower_lit_[kv.first] = nullopt;
+    qsx_upper_lit_[kv.first] = nullopt;
   }
 }
 
@@ -392,12 +542,28 @@ static bool is_less_or_whatever(const Formula& formula, bool truth) {
   return is_greater_or_whatever(formula, !truth);
 }
 
+// Returns the sense of the (relaxed) negation of a row with sense @p sense.
+static char FlipSense(const char sense) {
+  DREAL_ASSERT(sense == 'L' || sense == 'G');
+  return sense == 'L' ? 'G' : 'L';
+}
+
 void QsoptexSatSolver::EnableLinearLiteral(const Variable& var, bool truth) {
-    const auto it_row = to_qsx_row_.find(make_pair(var.get_id(), truth));
+    const auto it_row = to_qsx_row_.find(var.get_id());
     if (it_row != to_qsx_row_.end()) {
       // A non-trivial linear literal from the input problem
       const int qsx_row = it_row->second;
-      mpq_QSchange_sense(qsx_prob_, qsx_row, qsx_sense_[qsx_row]);
+      const char sense{qsx_sense_[qsx_row]};
+      if (!truth && sense == 'E') {
+        // The negation of an equality, which is always delta-sat.
+        DREAL_LOG_TRACE(
+            "QsoptexSatSolver::EnableLinearLiteral: ignoring ({}, {})", var,
+            truth);
+        return;
+      }
+      from_qsx_row_[qsx_row] = Literal{var, truth};
+      mpq_QSchange_sense(qsx_prob_, qsx_row,
+                         truth ? sense : FlipSense(sense));
       mpq_QSchange_rhscoef(qsx_prob_, qsx_row, qsx_rhs_[qsx_row].get_mpq_t());
       DREAL_LOG_TRACE("QsoptexSatSolver::EnableLinearLiteral({})", qsx_row);
       return;
@@ -409,29 +575,30 @@ void QsoptexSatSolver::EnableLinearLiteral(const Variable& var, bool truth) {
       const Formula& formula{it->second};
       const Expression& lhs{get_lhs_expression(formula)};
       const Expression& rhs{get_rhs_expression(formula)};
+      const Literal lit{var, truth};
       DREAL_LOG_TRACE("QsoptexSatSolver::EnableLinearLiteral({}{})",
                       truth ? "" : "¬", formula);
       if (is_equal_or_whatever(formula, truth)) {
         if (is_variable(lhs) && is_constant(rhs)) {
-          SetQSXVarBound(get_variable(lhs), 'B', get_constant_value(rhs));
+          SetQSXVarBound(lit, get_variable(lhs), 'B', get_constant_value(rhs));
         } else if (is_constant(lhs) && is_variable(rhs)) {
-          SetQSXVarBound(get_variable(rhs), 'B', get_constant_value(lhs));
+          SetQSXVarBound(lit, get_variable(rhs), 'B', get_constant_value(lhs));
         } else {
           DREAL_UNREACHABLE();
         }
       } else if (is_greater_or_whatever(formula, truth)) {
         if (is_variable(lhs) && is_constant(rhs)) {
-          SetQSXVarBound(get_variable(lhs), 'L', get_constant_value(rhs));
+          SetQSXVarBound(lit, get_variable(lhs), 'L', get_constant_value(rhs));
         } else if (is_constant(lhs) && is_variable(rhs)) {
-          SetQSXVarBound(get_variable(rhs), 'U', get_constant_value(lhs));
+          SetQSXVarBound(lit, get_variable(rhs), 'U', get_constant_value(lhs));
         } else {
           DREAL_UNREACHABLE();
         }
       } else if (is_less_or_whatever(formula, truth)) {
         if (is_variable(lhs) && is_constant(rhs)) {
-          SetQSXVarBound(get_variable(lhs), 'U', get_constant_value(rhs));
+          SetQSXVarBound(lit, get_variable(lhs), 'U', get_constant_value(rhs));
         } else if (is_constant(lhs) && is_variable(rhs)) {
-          SetQSXVarBound(get_variable(rhs), 'L', get_constant_value(lhs));
+          SetQSXVarBound(lit, get_variable(rhs), 'L', get_constant_value(lhs));
         } else {
           DREAL_UNREACHABLE();
         }
@@ -456,9 +623,9 @@ void QsoptexSatSolver::AddLinearLiteral(const Variable& formulaVar, bool truth)
       // Boolean variable - no need to involve theory solver
       return;
     }
-    const auto it2 = to_qsx_row_.find(make_pair(formulaVar.get_id(), truth));
+    const auto it2 = to_qsx_row_.find(formulaVar.get_id());
     if (it2 != to_qsx_row_.end()) {
-      // Found.
+      // Found, possibly with the other polarity.
       return;
     }
     // Theory formula
@@ -467,21 +634,25 @@ void QsoptexSatSolver::AddLinearLiteral(const Variable& formulaVar, bool truth)
     for (const Variable& var : formula.GetFreeVariables()) {
       AddLinearVariable(var);
     }
+    // The row is shared by both polarities of the atom, and qsx_sense_ holds
+    // its sense when the atom is true. EnableLinearLiteral flips it when the
+    // atom is false, since the strict inequalities are relaxed.
+    char sense;
     if (is_equal_or_whatever(formula, truth)) {
       if (is_simple_bound(formula)) {
         return;  // Just create simple bound in LP
       }
-      qsx_sense_.push_back('E');
+      sense = 'E';
     } else if (is_greater_or_whatever(formula, truth)) {
       if (is_simple_bound(formula)) {
         return;
       }
-      qsx_sense_.push_back('G');
+      sense = 'G';
     } else if (is_less_or_whatever(formula, truth)) {
       if (is_simple_bound(formula)) {
         return;
       }
-      qsx_sense_.push_back('L');
+      sense = 'L';
     } else if (is_not_equal_or_whatever(formula, truth)) {
       // Nothing to do, because this constraint is always delta-sat for
       // delta > 0.
@@ -489,45 +660,29 @@ void QsoptexSatSolver::AddLinearLiteral(const Variable& formulaVar, bool truth)
     } else {
       throw DREAL_RUNTIME_ERROR("Formula {} not supported", formula);
     }
-    Expression expr;
-    expr = (get_lhs_expression(formula) - get_rhs_expression(formula)).Expand();
+    const Expression& lhs{get_lhs_expression(formula)};
+    const Expression& rhs{get_rhs_expression(formula)};
+    // Fall back to the expanded form for the atoms which are only linear
+    // once expanded, e.g. x * (y + 1) - x * y.
+    if (!linear_form_.Extract(lhs, rhs, to_qsx_col_) &&
+        !linear_form_.Extract((lhs - rhs).Expand(), to_qsx_col_)) {
+      throw DREAL_RUNTIME_ERROR("Expression {} not supported", lhs - rhs);
+    }
     const int qsx_row{mpq_QSget_rowcount(qsx_prob_)};
     mpq_QSnew_row(qsx_prob_, mpq_NINFTY, 'G', NULL);  // Inactive
-    DREAL_ASSERT(static_cast<size_t>(qsx_row) == qsx_sense_.size() - 1);
+    DREAL_ASSERT(static_cast<size_t>(qsx_row) == qsx_sense_.size());
+    qsx_sense_.push_back(truth ? sense : FlipSense(sense));
     DREAL_ASSERT(static_cast<size_t>(qsx_row) == qsx_rhs_.size());
-    qsx_rhs_.push_back(0);
-    if (is_constant(expr)) {
-      qsx_rhs_.back() = -get_constant_value(expr);
-    } else if (is_variable(expr)) {
-      SetQSXVarCoef(qsx_row, get_variable(expr), 1);
-    } else if (is_multiplication(expr)) {
-      std::map<Expression,Expression> map = get_base_to_exponent_map_in_multiplication(expr);
-      if (map.size() != 1
-       || !is_variable(map.begin()->first)
-       || !is_constant(map.begin()->second)
-       || get_constant_value(map.begin()->second) != 1) {
-        throw DREAL_RUNTIME_ERROR("Expression {} not supported", expr);
-      }
-      SetQSXVarCoef(qsx_row,
-                    get_variable(map.begin()->first),
-                    get_constant_in_multiplication(expr));
-    } else if (is_addition(expr)) {
-      const std::map<Expression,mpq_class>& map = get_expr_to_coeff_map_in_addition(expr);
-      for (const pair<Expression,mpq_class>& pair : map) {
-        if (!is_variable(pair.first)) {
-          throw DREAL_RUNTIME_ERROR("Expression {} not supported", expr);
-        }
-        SetQSXVarCoef(qsx_row, get_variable(pair.first), pair.second);
-      }
-      qsx_rhs_.back() = -get_constant_in_addition(expr);
-    } else {
-        throw DREAL_RUNTIME_ERROR("Expression {} not supported", expr);
+    for (size_t i = 0; i < linear_form_.columns().size(); ++i) {
+      SetQSXVarCoef(qsx_row, linear_form_.columns()[i],
+                    linear_form_.coefficients()[i]);
     }
+    qsx_rhs_.push_back(-linear_form_.constant());
     if (qsx_rhs_.back() <= mpq_ninfty() || qsx_rhs_.back() >= mpq_infty()) {
       throw DREAL_RUNTIME_ERROR("LP RHS value too large: {}", qsx_rhs_.back());
     }
     // Update indexes
-    to_qsx_row_.emplace(make_pair(make_pair(formulaVar.get_id(), truth), qsx_row));
+    to_qsx_row_.emplace(formulaVar.get_id(), qsx_row);
     DREAL_ASSERT(static_cast<size_t>(qsx_row) == from_qsx_row_.size());
     from_qsx_row_.push_back(make_pair(formulaVar, truth));
     DREAL_LOG_DEBUG("QsoptexSatSolver::AddLinearLiteral({}{} ↦ {})",
@@ -538,8 +693,7 @@ void QsoptexSatSolver::UpdateLookup(int lit, int learned) {
   if (learned) {
     learned_clause_lits_.insert(lit);
   } else {
-    main_clauses_copy_.push_back(lit);
-    main_clause_lookup_[lit].insert(cur_clause_start_);
+    main_clauses_.AddLiteral(lit);
   }
 }
 
@@ -580,7 +734,6 @@ void QsoptexSatSolver::AddLiteral(const Formula& f) {
 }
 
 void QsoptexSatSolver::DoAddClause(const Formula& f) {
-  cur_clause_start_ = main_clauses_copy_.size();
   if (is_disjunction(f)) {
     // f = l₁ ∨ ... ∨ lₙ
     for (const Formula& l : get_operands(f)) {
@@ -591,7 +744,7 @@ void QsoptexSatSolver::DoAddClause(const Formula& f) {
     AddLiteral(f);
   }
   picosat_add(sat_, 0);
-  main_clauses_copy_.push_back(0);
+  main_clauses_.EndClause();
 }
 
 void QsoptexSatSolver::MakeSatVar(const Variable& var) {
@@ -619,6 +772,8 @@ void QsoptexSatSolver::AddLinearVariable(const Variable& var) {
   DREAL_ASSERT(!status);
   to_qsx_col_.emplace(make_pair(var.get_id(), qsx_col));
   from_qsx_col_[qsx_col] = var;
+  qsx_lower_lit_.resize(qsx_col + 1);
+  qsx_upper_lit_.resize(qsx_col + 1);
   DREAL_LOG_DEBUG("QsoptexSatSolver::AddLinearVariable({} ↦ {})", var, qsx_col);
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <set>
 #include <map>
@@ -11,6 +12,10 @@
 
 #include "dreal/solver/config.h"
 #include "dreal/symbolic/symbolic.h"
+#include "dreal/util/bound_implicator.h"
+#include "dreal/util/clause_exchange.h"
+#include "dreal/util/linear_form.h"
+#include "dreal/util/main_clause_tracker.h"
 #include "dreal/util/optional.h"
 #include "dreal/util/predicate_abstractor.h"
 #include "dreal/util/scoped_unordered_map.h"
@@ -68,9 +73,39 @@ class QsoptexSatSolver {
   optional<Model> CheckSat(const Box& box,
                            const optional<Expression> obj_expr = optional<Expression>());
 
-  // TODO(soonho): Push/Pop cnfizer and predicate_abstractor?
+  /// Assumes @p literals in the following calls to CheckSat(), until this
+  /// function is called again.
+  void SetAssumptions(const std::vector<Literal>& literals);
+
+  /// Returns the assumptions which were used to show UNSAT in the last call
+  /// to CheckSat(). It is empty if the clauses are UNSAT on their own.
+  const std::vector<Literal>& GetFailedAssumptions() const {
+    return failed_assumptions_;
+  }
+
+  /// Makes CheckSat() give up, by throwing an exception, once @p cancelled
+  /// is raised by another thread. Pass nullptr to never give up.
+  void SetCancelFlag(const std::atomic<bool>* cancelled);
+
+  /// Shares learned clauses with the other workers of a portfolio through
+  /// @p exchange, where this solver is the worker @p worker. The clauses of
+  /// the other workers are added at the start of each CheckSat(). The ids
+  /// of the atoms cached for a previous exchange are dropped.
+  void SetClauseExchange(ClauseExchange* exchange, int worker);
+
+  /// Publishes the clause learned from the explanation @p literals, as given
+  /// to AddLearnedClause(), to the other workers. Nothing is shared unless
+  /// every literal is on a theory atom.
+  void ShareLearnedClause(const LiteralSet& literals);
+
+  /// Removes the clauses added since the matching Push(), together with the
+  /// LP rows and columns which were created for them.
+  ///
+  /// The predicate abstraction is kept: an atom which comes back later is
+  /// given the same Boolean variable.
   void Pop();
 
+  /// Opens a new scope of clauses.
   void Push();
 
   Formula theory_literal(const Variable& var) const {
@@ -81,6 +116,23 @@ class QsoptexSatSolver {
     return qsx_prob_;
   }
 
+  /// Returns, for each column, the literal which set its current lower bound
+  /// (or nullopt if the bound comes from the box).
+  const std::vector<optional<Literal>>& GetLowerBoundLiterals() const {
+    return qsx_lower_lit_;
+  }
+
+  /// Returns, for each column, the literal which set its current upper bound
+  /// (or nullopt if the bound comes from the box).
+  const std::vector<optional<Literal>>& GetUpperBoundLiterals() const {
+    return qsx_upper_lit_;
+  }
+
+  /// Returns the literal associated with each row of the LP.
+  const std::vector<Literal>& GetLinearRowMap() const {
+    return from_qsx_row_;
+  }
+
   const std::map<int, Variable>& GetLinearVarMap() const;
 
  private:
@@ -95,6 +147,13 @@ class QsoptexSatSolver {
   // @pre Each formula fᵢ ∈ formulas is a clause.
   void AddClauses(const std::vector<Formula>& formulas);
 
+  // Adds binary clauses between the theory atoms which appear in @p clauses
+  // and the atoms seen before, whenever the two can't hold at the same time
+  // (e.g. x ≤ 3 ⇒ x ≤ 5). See BoundImplicator.
+  //
+  // @pre The Boolean variables in @p clauses have SAT variables.
+  void AddBoundImplications(const std::vector<Formula>& clauses);
+
   // Returns a corresponding literal ID of @p var. It maintains two
   // maps `lit_to_var_` and `var_to_lit_` to keep track of the
   // relationship between Variable ⇔ Literal (in SAT).
@@ -128,27 +187,32 @@ class QsoptexSatSolver {
 
   // Set the variable's coefficient for the given constraint row in the linear
   // solver
-  void SetQSXVarCoef(int qsx_row, const Variable& var, const mpq_class& value);
+  void SetQSXVarCoef(int qsx_row, int qsx_col, const mpq_class& value);
 
   // Set the variable's coefficient for the objective function in the linear
   // solver
   void SetQSXVarObjCoef(const Variable& var, const mpq_class& value);
 
   // Set one of the variable's bounds ('L' - lower or 'U' - upper) in the
-  // linear solver, in addition to bounds already asserted.
-  void SetQSXVarBound(const Variable& var, const char type,
+  // linear solver, in addition to bounds already asserted. The literal @p lit
+  // is recorded as the reason for the bound, if it is tightened.
+  void SetQSXVarBound(const Literal& lit, const Variable& var, const char type,
                       const mpq_class& value);
 
   // Add a clause @p f to sat solver.
   void DoAddClause(const Formula& f);
 
+  // Adds the clauses learned by the other workers of the portfolio since the
+  // last call.
+  void ImportSharedClauses();
+
   // Update data structures used to remove literals that are only required by
   // learned clauses.
   void UpdateLookup(int lit, int learned);
 
   // Collect active literals, removing those that are only required by learned
-  // clauses.
-  std::set<int> GetMainActiveLiterals() const;
+  // clauses. The returned vector is reused by the next call.
+  const std::vector<int>& GetMainActiveLiterals();
 
   // Member variables
   // ----------------
@@ -156,6 +220,7 @@ class QsoptexSatSolver {
   PicoSAT* const sat_{};
   PlaistedGreenbaumCnfizer cnfizer_;
   PredicateAbstractor predicate_abstractor_;
+  BoundImplicator bound_implicator_;
 
   // Map symbolic::Variable → int (Variable type in PicoSat).
   ScopedUnorderedMap<Variable::Id, int> to_sat_var_;
@@ -165,10 +230,8 @@ class QsoptexSatSolver {
 
   // Data to help with removing literals that are only required by learned
   // clauses.
-  std::vector<int> main_clauses_copy_;
+  MainClauseTracker main_clauses_;
   std::set<int> learned_clause_lits_;
-  std::map<int, std::set<int>> main_clause_lookup_;
-  int cur_clause_start_;
 
   /// Set of temporary Boolean variables introduced by CNF
   /// transformations.
@@ -184,13 +247,48 @@ class QsoptexSatSolver {
   std::map<Variable::Id, int> to_qsx_col_;
   std::map<int, Variable> from_qsx_col_;
 
-  // Map (symbolic::Variable, bool) <-> int (row in QSopt_ex problem).
-  std::map<std::pair<Variable::Id, bool>, int> to_qsx_row_;
+  // Extracts the coefficients of the rows from the linear atoms.
+  LinearFormExtractor linear_form_;
+
+  // Map symbolic::Variable -> int (row in QSopt_ex problem). The two
+  // polarities of an atom share its row, whose sense in qsx_sense_ is the one
+  // of the positive literal. from_qsx_row_ gives the literal which last
+  // enabled each row.
+  std::map<Variable::Id, int> to_qsx_row_;
   std::vector<Literal> from_qsx_row_;
 
   std::vector<mpq_class> qsx_rhs_;
   std::vector<char> qsx_sense_;
 
+  // Literal responsible for the current lower/upper bound of each column.
+  std::vector<optional<Literal>> qsx_lower_lit_;
+  std::vector<optional<Literal>> qsx_upper_lit_;
+
+  // Literals assumed by CheckSat(), and those used by the last UNSAT answer.
+  std::vector<Literal> assumptions_;
+  std::vector<Literal> failed_assumptions_;
+
+  // Raised by another thread when the answer is not needed any more. See
+  // SetCancelFlag().
+  const std::atomic<bool>* cancelled_{nullptr};
+
+  // Clauses shared with the other workers of a portfolio. Atoms are
+  // identified by their id in clause_exchange_, which is mapped to the
+  // variables of this solver.
+  ClauseExchange* clause_exchange_{nullptr};
+  int clause_exchange_worker_{0};
+  uint64_t clause_exchange_cursor_{0};
+  std::unordered_map<Variable::Id, int> to_shared_atom_;
+  std::unordered_map<int, Variable> from_shared_atom_;
+
+  // Sizes of the LP and of main_clauses_ at each Push().
+  struct Scope {
+    int rows;
+    int cols;
+    size_t main_clauses;
+  };
+  std::vector<Scope> scopes_;
+
   /// @note We found an issue when picosat_deref_partial is used with
   /// picosat_pop. When this variable is true, we use `picosat_deref`
   /// instead.
@@ -3,6 +3,7 @@
 #include <atomic>
 #include <iostream>
 #include <limits>
+#include <tuple>
 
 #include "dreal/util/assert.h"
 #include "dreal/util/exception.h"
@@ -24,6 +25,7 @@ using std::numeric_limits;
 
 using qsopt_ex::mpq_QSprob;
 using qsopt_ex::MpqArray;
+using qsopt_ex::mpq_ILL_MINDOUBLE;  // mpq_NINFTY
 using dreal::util::mpq_infty;
 using dreal::util::mpq_ninfty;
 
@@ -47,15 +49,62 @@ class TheorySolverStat : public Stat {
       print(cout, "{:<45} @ {:<20} = {:>15f} sec\n",
             "Total time spent in CheckSat", "Theory level",
             timer_check_sat_.seconds());
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of explanations",
+            "Theory level", num_explanations_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of literals in conflicting models", "Theory level",
+            num_model_literals_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of literals in explanations", "Theory level",
+            num_explanation_literals_);
     }
   }
 
   void increase_num_check_sat() { increase(&num_check_sat_); }
 
-  Timer timer_check_sat_;
+  void add_explanation(const size_t explanation_size,
+                       const size_t model_size) {
+    if (enabled()) {
+      increase(&num_explanations_);
+      num_explanation_literals_ += explanation_size;
+      num_model_literals_ += model_size;
+    }
+  }
+
+  ConcurrentTimer timer_check_sat_;
 
  private:
   std::atomic<int> num_check_sat_{0};
+  std::atomic<int> num_explanations_{0};
+  std::atomic<size_t> num_explanation_literals_{0};
+  std::atomic<size_t> num_model_literals_{0};
+};
+
+// Appends the row `objective ≤ cutoff` to an LP, and removes it again when
+// it goes out of scope.
+class CutoffRow {
+ public:
+  CutoffRow(const mpq_QSprob prob, MpqArray& obj, const int colcount,
+            const mpq_class& cutoff)
+      : prob_{prob}, row_{mpq_QSget_rowcount(prob)} {
+    int status = mpq_QSnew_row(prob_, cutoff.get_mpq_t(), 'L', NULL);
+    DREAL_ASSERT(!status);
+    for (int j = 0; j < colcount; ++j) {
+      if (mpq_sgn(obj[j]) != 0) {
+        status = mpq_QSchange_coef(prob_, row_, j, obj[j]);
+        DREAL_ASSERT(!status);
+      }
+    }
+  }
+  CutoffRow(const CutoffRow&) = delete;
+  CutoffRow(CutoffRow&&) = delete;
+  CutoffRow& operator=(const CutoffRow&) = delete;
+  CutoffRow& operator=(CutoffRow&&) = delete;
+  ~CutoffRow() { mpq_QSdelete_rows(prob_, 1, &row_); }
+
+ private:
+  const mpq_QSprob prob_;
+  int row_;
 };
 
 }  // namespace
@@ -65,11 +114,15 @@ int QsoptexTheorySolver::CheckOpt(const Box& box,
                                   mpq_class* obj_up,
                                   const std::vector<Literal>& assertions,
                                   const mpq_QSprob prob,
-                                  const std::map<int, Variable>& var_map) {
+                                  const vector<Literal>& row_map,
+                                  const vector<optional<Literal>>& lower_lits,
+                                  const vector<optional<Literal>>& upper_lits,
+                                  const std::map<int, Variable>& var_map,
+                                  const optional<mpq_class>& obj_cutoff) {
   static TheorySolverStat stat{DREAL_LOG_INFO_ENABLED};
   stat.increase_num_check_sat();
-  TimerGuard check_sat_timer_guard(&stat.timer_check_sat_, stat.enabled(),
-                                   true /* start_timer */);
+  ConcurrentTimerGuard check_sat_timer_guard(&stat.timer_check_sat_,
+                                             stat.enabled());
 
   DREAL_LOG_TRACE("QsoptexTheorySolver::CheckOpt: Box = \n{}", box);
 
@@ -80,15 +133,11 @@ int QsoptexTheorySolver::CheckOpt(const Box& box,
 
   int rowcount = mpq_QSget_rowcount(prob);
   int colcount = mpq_QSget_colcount(prob);
-  // x: * must be allocated/deallocated using QSopt_ex.
-  //    * should have room for the (rowcount) "logical" variables, which come
-  //    after the (colcount) "structural" variables.
-  MpqArray x{colcount + rowcount};
-  MpqArray y{rowcount};
   MpqArray obj{colcount};
   mpq_QSget_obj(prob, obj);
 
-  model_ = box;
+  // Only the intervals which changed since the last call are copied.
+  model_.InplaceAssign(box);
   for (const pair<int, Variable>& kv : var_map) {
     if (!model_.has_variable(kv.second)) {
       // Variable should already be present
@@ -103,19 +152,33 @@ int QsoptexTheorySolver::CheckOpt(const Box& box,
   lp_status = LP_DELTA_OPTIMAL;
   mpq_t temp;
   mpq_init(temp);
+  // Reused for every column, so that their storage is only allocated once.
+  mpq_class lb, ub;
   for (const pair<int, Variable>& kv : var_map) {
     int res;
     res = mpq_QSget_bound(prob, kv.first, 'L', &temp);
     DREAL_ASSERT(!res);
-    mpq_class lb{temp};
+    mpq_set(lb.get_mpq_t(), temp);
     res = mpq_QSget_bound(prob, kv.first, 'U', &temp);
     DREAL_ASSERT(!res);
-    mpq_class ub{temp};
+    mpq_set(ub.get_mpq_t(), temp);
     if (lb > ub) {
       lp_status = LP_INFEASIBLE;
-      // Prevent the exact same LP from coming up again
       explanation_.clear();
-      explanation_.insert(assertions.begin(), assertions.end());
+      if (config_.lp_explanation() != Config::LPExplanation::Assertions) {
+        // Only the literals which set the two bounds are responsible.
+        if (lower_lits[kv.first]) {
+          explanation_.insert(*lower_lits[kv.first]);
+        }
+        if (upper_lits[kv.first]) {
+          explanation_.insert(*upper_lits[kv.first]);
+        }
+      }
+      if (explanation_.empty()) {
+        // Prevent the exact same LP from coming up again
+        explanation_.insert(assertions.begin(), assertions.end());
+      }
+      stat.add_explanation(explanation_.size(), assertions.size());
       break;
     }
     if (rowcount == 0) {
@@ -148,6 +211,21 @@ int QsoptexTheorySolver::CheckOpt(const Box& box,
     return lp_status;
   }
 
+  // The cutoff row only lives for the duration of this call.
+  optional<CutoffRow> cutoff_row;
+  if (obj_cutoff) {
+    DREAL_LOG_DEBUG("QsoptexTheorySolver::CheckOpt: objective cutoff = {}",
+                    *obj_cutoff);
+    cutoff_row.emplace(prob, obj, colcount, *obj_cutoff);
+  }
+
+  // x: * must be allocated/deallocated using QSopt_ex.
+  //    * should have room for the (rowcount) "logical" variables, which come
+  //    after the (colcount) "structural" variables.
+  rowcount = mpq_QSget_rowcount(prob);
+  MpqArray x{colcount + rowcount};
+  MpqArray y{rowcount};
+
   // Now we call the solver
   int qs_lp_status = -1;
   DREAL_LOG_DEBUG("QsoptexTheorySolver::CheckOpt: calling QSopt_ex (full LP solver)");
@@ -176,16 +254,20 @@ int QsoptexTheorySolver::CheckOpt(const Box& box,
   case QS_LP_DELTA_OPTIMAL:
     // Copy delta-optimal point from x into model_
     for (const pair<int, Variable>& kv : var_map) {
-      DREAL_ASSERT(model_[kv.second].lb() <= mpq_class(x[kv.first]) &&
-                   mpq_class(x[kv.first]) <= model_[kv.second].ub());
-      model_[kv.second] = x[kv.first];
+      Box::Interval& iv{model_[kv.second]};
+      DREAL_ASSERT(mpq_cmp(iv.lb().get_mpq_t(), x[kv.first]) <= 0 &&
+                   mpq_cmp(x[kv.first], iv.ub().get_mpq_t()) <= 0);
+      iv = x[kv.first];
     }
+    // This region has been fully explored
+    explanation_.clear();
+    explanation_.insert(assertions.begin(), assertions.end());
     lp_status = LP_DELTA_OPTIMAL;
     break;
   case QS_LP_INFEASIBLE:
-    // Prevent the exact same LP from coming up again
-    explanation_.clear();
-    explanation_.insert(assertions.begin(), assertions.end());
+    SetInfeasibleExplanation(box, assertions, prob, row_map, lower_lits,
+                             upper_lits, var_map);
+    stat.add_explanation(explanation_.size(), assertions.size());
     lp_status = LP_INFEASIBLE;
     break;
   case QS_LP_UNSOLVED:
@@ -227,12 +309,15 @@ void QsoptexCheckSatPartialSolution(dreal::qsopt_ex::mpq_QSdata const* /*prob*/,
 int QsoptexTheorySolver::CheckSat(const Box& box,
                                   const std::vector<Literal>& assertions,
                                   const mpq_QSprob prob,
+                                  const vector<Literal>& row_map,
+                                  const vector<optional<Literal>>& lower_lits,
+                                  const vector<optional<Literal>>& upper_lits,
                                   const std::map<int, Variable>& var_map,
                                   mpq_class* actual_precision) {
   static TheorySolverStat stat{DREAL_LOG_INFO_ENABLED};
   stat.increase_num_check_sat();
-  TimerGuard check_sat_timer_guard(&stat.timer_check_sat_, stat.enabled(),
-                                   true /* start_timer */);
+  ConcurrentTimerGuard check_sat_timer_guard(&stat.timer_check_sat_,
+                                             stat.enabled());
 
   DREAL_LOG_TRACE("QsoptexTheorySolver::CheckSat: Box = \n{}", box);
 
@@ -248,7 +333,8 @@ int QsoptexTheorySolver::CheckSat(const Box& box,
   //    after the (colcount) "structural" variables.
   MpqArray x{colcount + rowcount};
 
-  model_ = box;
+  // Only the intervals which changed since the last call are copied.
+  model_.InplaceAssign(box);
   for (const pair<int, Variable>& kv : var_map) {
     if (!model_.has_variable(kv.second)) {
       // Variable should already be present
@@ -263,19 +349,33 @@ int QsoptexTheorySolver::CheckSat(const Box& box,
   sat_status = SAT_DELTA_SATISFIABLE;
   mpq_t temp;
   mpq_init(temp);
+  // Reused for every column, so that their storage is only allocated once.
+  mpq_class lb, ub;
   for (const pair<int, Variable>& kv : var_map) {
     int res;
     res = mpq_QSget_bound(prob, kv.first, 'L', &temp);
     DREAL_ASSERT(!res);
-    mpq_class lb{temp};
+    mpq_set(lb.get_mpq_t(), temp);
     res = mpq_QSget_bound(prob, kv.first, 'U', &temp);
     DREAL_ASSERT(!res);
-    mpq_class ub{temp};
+    mpq_set(ub.get_mpq_t(), temp);
     if (lb > ub) {
       sat_status = SAT_UNSATISFIABLE;
-      // Prevent the exact same LP from coming up again
       explanation_.clear();
-      explanation_.insert(assertions.begin(), assertions.end());
+      if (config_.lp_explanation() != Config::LPExplanation::Assertions) {
+        // Only the literals which set the two bounds are responsible.
+        if (lower_lits[kv.first]) {
+          explanation_.insert(*lower_lits[kv.first]);
+        }
+        if (upper_lits[kv.first]) {
+          explanation_.insert(*upper_lits[kv.first]);
+        }
+      }
+      if (explanation_.empty()) {
+        // Prevent the exact same LP from coming up again
+        explanation_.insert(assertions.begin(), assertions.end());
+      }
+      stat.add_explanation(explanation_.size(), assertions.size());
       break;
     }
     if (rowcount == 0) {
@@ -347,13 +447,18 @@ int QsoptexTheorySolver::CheckSat(const Box& box,
   case SAT_DELTA_SATISFIABLE:
     // Copy delta-feasible point from x into model_
     for (const pair<int, Variable>& kv : var_map) {
-      DREAL_ASSERT(model_[kv.second].lb() <= mpq_class(x[kv.first]) &&
-                   mpq_class(x[kv.first]) <= model_[kv.second].ub());
-      model_[kv.second] = x[kv.first];
+      Box::Interval& iv{model_[kv.second]};
+      DREAL_ASSERT(mpq_cmp(iv.lb().get_mpq_t(), x[kv.first]) <= 0 &&
+                   mpq_cmp(x[kv.first], iv.ub().get_mpq_t()) <= 0);
+      iv = x[kv.first];
     }
     sat_status = SAT_DELTA_SATISFIABLE;
     break;
   case SAT_UNSATISFIABLE:
+    SetInfeasibleExplanation(box, assertions, prob, row_map, lower_lits,
+                             upper_lits, var_map);
+    stat.add_explanation(explanation_.size(), assertions.size());
+    break;
   case SAT_UNSOLVED:
     // Prevent the exact same LP from coming up again
     explanation_.clear();
@@ -366,6 +471,166 @@ int QsoptexTheorySolver::CheckSat(const Box& box,
   return sat_status;
 }
 
+void QsoptexTheorySolver::SetInfeasibleExplanation(
+    const Box& box, const vector<Literal>& assertions, const mpq_QSprob prob,
+    const vector<Literal>& row_map,
+    const vector<optional<Literal>>& lower_lits,
+    const vector<optional<Literal>>& upper_lits,
+    const std::map<int, Variable>& var_map) {
+  explanation_.clear();
+  if (config_.lp_explanation() != Config::LPExplanation::Assertions &&
+      SetFarkasExplanation(prob, row_map, lower_lits, upper_lits, var_map) &&
+      config_.lp_explanation() == Config::LPExplanation::Minimal) {
+    MinimizeExplanation(box, prob, row_map, lower_lits, upper_lits, var_map);
+  }
+  if (explanation_.empty()) {
+    // Prevent the exact same LP from coming up again
+    explanation_.insert(assertions.begin(), assertions.end());
+  }
+  DREAL_LOG_DEBUG("QsoptexTheorySolver: explanation has {} of {} literals",
+                  explanation_.size(), assertions.size());
+}
+
+bool QsoptexTheorySolver::SetFarkasExplanation(
+    const mpq_QSprob prob, const vector<Literal>& row_map,
+    const vector<optional<Literal>>& lower_lits,
+    const vector<optional<Literal>>& upper_lits,
+    const std::map<int, Variable>& var_map) {
+  const int rowcount = mpq_QSget_rowcount(prob);
+  DREAL_ASSERT(static_cast<size_t>(rowcount) >= row_map.size());
+  // y is a dual ray proving infeasibility. Rows with a zero multiplier can be
+  // dropped, and so can the bounds of columns with a zero entry in yᵀA. Rows
+  // past the end of row_map (the objective cutoff) have no literal.
+  MpqArray y{rowcount};
+  if (mpq_QSget_infeas_array(prob, y)) {
+    DREAL_LOG_DEBUG("QsoptexTheorySolver::SetFarkasExplanation: no certificate available");
+    return false;
+  }
+  explanation_.clear();
+  for (size_t i = 0; i < row_map.size(); ++i) {
+    if (mpq_sgn(y[i]) != 0) {
+      explanation_.insert(row_map[i]);
+    }
+  }
+  const vector<mpq_class> red_cost{qsopt_ex::TransposeTimes(prob, y)};
+  for (const pair<int, Variable>& kv : var_map) {
+    if (red_cost[kv.first] == 0) {
+      continue;
+    }
+    if (lower_lits[kv.first]) {
+      explanation_.insert(*lower_lits[kv.first]);
+    }
+    if (upper_lits[kv.first]) {
+      explanation_.insert(*upper_lits[kv.first]);
+    }
+  }
+  return true;
+}
+
+bool QsoptexTheorySolver::IsInfeasible(const mpq_QSprob prob) const {
+  int lp_status = -1;
+  const int status = qsopt_ex::QSexact_solver(prob, NULL, NULL, NULL,
+                                              DUAL_SIMPLEX, &lp_status);
+  if (status) {
+    throw DREAL_RUNTIME_ERROR("QSopt_ex returned {}", status);
+  }
+  return lp_status == QS_LP_INFEASIBLE;
+}
+
+void QsoptexTheorySolver::MinimizeExplanation(
+    const Box& box, const mpq_QSprob prob, const vector<Literal>& row_map,
+    const vector<optional<Literal>>& lower_lits,
+    const vector<optional<Literal>>& upper_lits,
+    const std::map<int, Variable>& var_map) {
+  auto box_lb = [&box](const Variable& var) {
+    return box.has_variable(var) ? box[var].lb() : mpq_ninfty();
+  };
+  auto box_ub = [&box](const Variable& var) {
+    return box.has_variable(var) ? box[var].ub() : mpq_infty();
+  };
+  auto in_explanation = [this](const optional<Literal>& lit) {
+    return lit && explanation_.count(*lit) > 0;
+  };
+  auto relax_row = [prob](const int i) {
+    mpq_QSchange_sense(prob, i, 'G');
+    mpq_QSchange_rhscoef(prob, i, mpq_NINFTY);
+  };
+  auto get_bound = [prob](const int col, const char type) {
+    mpq_t temp;
+    mpq_init(temp);
+    const int res = mpq_QSget_bound(prob, col, type, &temp);
+    DREAL_ASSERT(!res);
+    mpq_class value{temp};
+    mpq_clear(temp);
+    return value;
+  };
+
+  // Remember the active rows, then relax everything which is not part of the
+  // explanation, so that each deletion test below only depends on the
+  // remaining literals. Rows without a literal are left alone.
+  const int rowcount = static_cast<int>(row_map.size());
+  vector<char> sense(mpq_QSget_rowcount(prob));
+  MpqArray rhs{mpq_QSget_rowcount(prob)};
+  mpq_QSget_senses(prob, sense.data());
+  mpq_QSget_rhs(prob, rhs);
+  for (int i = 0; i < rowcount; ++i) {
+    if (explanation_.count(row_map[i]) == 0) {
+      relax_row(i);
+    }
+  }
+  for (const pair<int, Variable>& kv : var_map) {
+    if (lower_lits[kv.first] && !in_explanation(lower_lits[kv.first])) {
+      mpq_QSchange_bound(prob, kv.first, 'L', box_lb(kv.second).get_mpq_t());
+    }
+    if (upper_lits[kv.first] && !in_explanation(upper_lits[kv.first])) {
+      mpq_QSchange_bound(prob, kv.first, 'U', box_ub(kv.second).get_mpq_t());
+    }
+  }
+
+  const LiteralComparator less;
+  auto same = [&less](const Literal& a, const Literal& b) {
+    return !less(a, b) && !less(b, a);
+  };
+  const vector<Literal> candidates{explanation_.begin(), explanation_.end()};
+  for (const Literal& lit : candidates) {
+    // Relax every row and bound set by `lit`, remembering the old bounds.
+    vector<int> rows;
+    vector<std::tuple<int, char, mpq_class>> bounds;
+    for (int i = 0; i < rowcount; ++i) {
+      if (same(row_map[i], lit)) {
+        rows.push_back(i);
+        relax_row(i);
+      }
+    }
+    for (const pair<int, Variable>& kv : var_map) {
+      const optional<Literal>& lower_lit{lower_lits[kv.first]};
+      const optional<Literal>& upper_lit{upper_lits[kv.first]};
+      if (lower_lit && same(*lower_lit, lit)) {
+        bounds.emplace_back(kv.first, 'L', get_bound(kv.first, 'L'));
+        mpq_QSchange_bound(prob, kv.first, 'L', box_lb(kv.second).get_mpq_t());
+      }
+      if (upper_lit && same(*upper_lit, lit)) {
+        bounds.emplace_back(kv.first, 'U', get_bound(kv.first, 'U'));
+        mpq_QSchange_bound(prob, kv.first, 'U', box_ub(kv.second).get_mpq_t());
+      }
+    }
+    if (IsInfeasible(prob)) {
+      DREAL_LOG_TRACE("QsoptexTheorySolver::MinimizeExplanation: drop {}{}",
+                      lit.second ? "" : "¬", lit.first);
+      explanation_.erase(lit);
+    } else {
+      for (const int i : rows) {
+        mpq_QSchange_sense(prob, i, sense[i]);
+        mpq_QSchange_rhscoef(prob, i, rhs[i]);
+      }
+      for (const auto& bound : bounds) {
+        mpq_QSchange_bound(prob, std::get<0>(bound), std::get<1>(bound),
+                           std::get<2>(bound).get_mpq_t());
+      }
+    }
+  }
+}
+
 const Box& QsoptexTheorySolver::GetModel() const {
   DREAL_LOG_DEBUG("QsoptexTheorySolver::GetModel():\n{}", model_);
   return model_;
@@ -10,6 +10,7 @@
 #include "dreal/symbolic/symbolic.h"
 #include "dreal/util/box.h"
 #include "dreal/util/literal.h"
+#include "dreal/util/optional.h"
 #include "dreal/qsopt_ex.h"
 #include "dreal/gmp.h"
 
@@ -30,17 +31,35 @@ class QsoptexTheorySolver {
 
   /// Checks consistency. Returns true if there is a satisfying
   /// assignment. Otherwise, return false.
+  ///
+  /// @p row_map gives the literal of each LP row, and @p lower_lits and
+  /// @p upper_lits give the literal responsible for each column bound. They
+  /// are used to build small explanations when the LP is infeasible.
   int CheckSat(const Box& box, const std::vector<Literal>& assertions,
                const qsopt_ex::mpq_QSprob prob,
+               const std::vector<Literal>& row_map,
+               const std::vector<optional<Literal>>& lower_lits,
+               const std::vector<optional<Literal>>& upper_lits,
                const std::map<int, Variable>& var_map,
                mpq_class* actual_precision);
 
+  /// Minimizes the objective of @p prob, and returns one of the LP_* codes.
+  ///
+  /// If @p obj_cutoff is set, the row `objective ≤ *obj_cutoff` is added to
+  /// the LP for the duration of the call, so that LP_INFEASIBLE is returned
+  /// when the optimum of this region is above the cutoff. The row has no
+  /// literal, hence the explanation is only valid as long as the cutoff (or
+  /// a lower one) is in force.
   int CheckOpt(const Box& box,
                mpq_class* obj_lo,
                mpq_class* obj_up,
                const std::vector<Literal>& assertions,
                const qsopt_ex::mpq_QSprob prob,
-               const std::map<int, Variable>& var_map);
+               const std::vector<Literal>& row_map,
+               const std::vector<optional<Literal>>& lower_lits,
+               const std::vector<optional<Literal>>& upper_lits,
+               const std::map<int, Variable>& var_map,
+               const optional<mpq_class>& obj_cutoff);
 
   /// Gets a satisfying Model.
   const Box& GetModel() const;
@@ -49,6 +68,37 @@ class QsoptexTheorySolver {
   const LiteralSet& GetExplanation() const;
 
  private:
+  // Sets explanation_ for an infeasible @p prob, according to
+  // Config::lp_explanation(). Falls back to @p assertions when no smaller
+  // explanation is available.
+  void SetInfeasibleExplanation(const Box& box,
+                                const std::vector<Literal>& assertions,
+                                const qsopt_ex::mpq_QSprob prob,
+                                const std::vector<Literal>& row_map,
+                                const std::vector<optional<Literal>>& lower_lits,
+                                const std::vector<optional<Literal>>& upper_lits,
+                                const std::map<int, Variable>& var_map);
+
+  // Sets explanation_ to the literals whose rows or bounds have a nonzero
+  // multiplier in the infeasibility certificate of @p prob. Returns false if
+  // QSopt_ex does not provide a certificate.
+  bool SetFarkasExplanation(const qsopt_ex::mpq_QSprob prob,
+                            const std::vector<Literal>& row_map,
+                            const std::vector<optional<Literal>>& lower_lits,
+                            const std::vector<optional<Literal>>& upper_lits,
+                            const std::map<int, Variable>& var_map);
+
+  // Shrinks explanation_ by deletion: every literal is relaxed in turn, and
+  // dropped for good if @p prob remains infeasible without it.
+  void MinimizeExplanation(const Box& box, const qsopt_ex::mpq_QSprob prob,
+                           const std::vector<Literal>& row_map,
+                           const std::vector<optional<Literal>>& lower_lits,
+                           const std::vector<optional<Literal>>& upper_lits,
+                           const std::map<int, Variable>& var_map);
+
+  // Solves @p prob exactly and returns true if it is infeasible.
+  bool IsInfeasible(const qsopt_ex::mpq_QSprob prob) const;
+
   const Config& config_;
   Box model_;
   LiteralSet explanation_;
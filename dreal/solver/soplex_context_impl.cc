@@ -5,7 +5,7 @@
 
 #include <fmt/format.h>
 
-//#include "dreal/solver/filter_assertion.h"
+#include "dreal/solver/filter_assertion.h"
 #include "dreal/util/assert.h"
 #include "dreal/util/exception.h"
 #include "dreal/util/if_then_else_eliminator.h"
@@ -21,7 +21,15 @@ using std::vector;
 Context::SoplexImpl::SoplexImpl() : Context::SoplexImpl{Config{}} {}
 
 Context::SoplexImpl::SoplexImpl(Config config)
-    : Context::Impl{config}, sat_solver_{config_}, theory_solver_{config_} {}
+    : Context::Impl{config}, sat_solver_{config_}, theory_solver_{config_} {
+#if HAVE_CADICAL
+  if (config_.sat_solver() == Config::CADICAL) {
+    theory_propagator_ = std::make_unique<SoplexTheoryPropagator>(
+        config_, &sat_solver_, &theory_solver_);
+    sat_solver_.ConnectTheoryPropagator(theory_propagator_.get());
+  }
+#endif
+}
 
 void Context::SoplexImpl::Assert(const Formula& f) {
   if (is_true(f)) {
@@ -34,24 +42,24 @@ void Context::SoplexImpl::Assert(const Formula& f) {
     box().set_empty();
     return;
   }
-  //if (FilterAssertion(f, &box()) == FilterAssertionResult::NotFiltered) {
+  // A bound on a variable, e.g. `x <= 5`, is applied to the box, which is
+  // emptied if the bound is violated. It is not given to the SAT solver.
+  if (FilterAssertion(f, &box()) != FilterAssertionResult::NotFiltered) {
+    DREAL_LOG_DEBUG("Context::SoplexImpl::Assert: {} is not added.", f);
+    DREAL_LOG_DEBUG("Box=\n{}", box());
+    return;
+  }
   DREAL_LOG_DEBUG("Context::SoplexImpl::Assert: {} is added.", f);
-  IfThenElseEliminator ite_eliminator;
-  const Formula no_ite{ite_eliminator.Process(f)};
-  for (const Variable& ite_var : ite_eliminator.variables()) {
+  const Formula no_ite{ite_eliminator_.Process(f, box())};
+  for (const Variable& ite_var : ite_eliminator_.variables()) {
     // Note that the following does not mark `ite_var` as a model variable.
     AddToBox(ite_var);
   }
   stack_.push_back(no_ite);
   sat_solver_.AddFormula(no_ite);
-  return;
-#if 0
-  } else {
-    DREAL_LOG_DEBUG("Context::SoplexImpl::Assert: {} is not added.", f);
-    DREAL_LOG_DEBUG("Box=\n{}", box());
-    return;
+  for (const auto& instance : portfolio_) {
+    instance->Assert(no_ite);
   }
-#endif
 }  // namespace dreal
 
 optional<Box> Context::SoplexImpl::CheckSatCore(const ScopedVector<Formula>& stack,
@@ -59,6 +67,7 @@ optional<Box> Context::SoplexImpl::CheckSatCore(const ScopedVector<Formula>& sta
                                                 mpq_class* /*actual_precision*/) {
   DREAL_LOG_DEBUG("Context::SoplexImpl::CheckSatCore()");
   DREAL_LOG_TRACE("Context::SoplexImpl::CheckSat: Box =\n{}", box);
+  sat_solver_.SetAssumptions(assumptions_);
   if (box.empty()) {
     return {};
   }
@@ -68,8 +77,10 @@ optional<Box> Context::SoplexImpl::CheckSatCore(const ScopedVector<Formula>& sta
       return {};
     }
   }
-  // If stack = ∅ or stack = {true}, it's trivially SAT.
-  if (stack.empty() || (stack.size() == 1 && is_true(stack.first()))) {
+  // If stack = ∅ or stack = {true}, and nothing is assumed, it's trivially
+  // SAT.
+  if (assumptions_.empty() &&
+      (stack.empty() || (stack.size() == 1 && is_true(stack.first())))) {
     DREAL_LOG_DEBUG("Context::SoplexImpl::CheckSatCore() - Found Model\n{}", box);
     return box;
   }
@@ -83,6 +94,7 @@ optional<Box> Context::SoplexImpl::CheckSatCore(const ScopedVector<Formula>& sta
       throw std::runtime_error("KeyboardInterrupt(SIGINT) Detected.");
     }
 #endif
+    ThrowIfCancelled();
 
     // The box is passed in to the SAT solver solely to provide the LP solver
     // with initial bounds on the numerical variables.
@@ -104,6 +116,9 @@ optional<Box> Context::SoplexImpl::CheckSatCore(const ScopedVector<Formula>& sta
                                   sat_solver_.GetLinearSolverPtr(),
                                   sat_solver_.GetLowerBounds(),
                                   sat_solver_.GetUpperBounds(),
+                                  sat_solver_.GetLinearRowMap(),
+                                  sat_solver_.GetLowerBoundLiterals(),
+                                  sat_solver_.GetUpperBoundLiterals(),
                                   sat_solver_.GetLinearVarMap())};
         if (theory_result == SAT_DELTA_SATISFIABLE) {
           // SAT from TheorySolver.
@@ -126,6 +141,10 @@ optional<Box> Context::SoplexImpl::CheckSatCore(const ScopedVector<Formula>& sta
               "size = {}",
               explanation.size(), stack.get_vector().size());
           sat_solver_.AddLearnedClause(explanation);
+          if (theory_result == SAT_UNSATISFIABLE) {
+            // Only a proper conflict holds for the other workers as well.
+            sat_solver_.ShareLearnedClause(explanation);
+          }
         }
       } else {
         return box;
@@ -157,7 +176,12 @@ void Context::SoplexImpl::Pop() {
   DREAL_LOG_DEBUG("Context::SoplexImpl::Pop()");
   stack_.pop();
   boxes_.pop();
+  assumption_guards_.pop();
+  ite_eliminator_.Pop();
   sat_solver_.Pop();
+  for (const auto& instance : portfolio_) {
+    instance->Pop();
+  }
 }
 
 void Context::SoplexImpl::Push() {
@@ -165,7 +189,39 @@ void Context::SoplexImpl::Push() {
   sat_solver_.Push();
   boxes_.push();
   boxes_.push_back(boxes_.last());
+  assumption_guards_.push();
+  ite_eliminator_.Push();
   stack_.push();
+  for (const auto& instance : portfolio_) {
+    instance->Push();
+  }
+}
+
+void Context::SoplexImpl::SetCancelFlag(const std::atomic<bool>* const cancelled) {
+  Impl::SetCancelFlag(cancelled);
+  sat_solver_.SetCancelFlag(cancelled);
+}
+
+void Context::SoplexImpl::SetClauseExchange(ClauseExchange* const exchange,
+                                            const int worker) {
+  sat_solver_.SetClauseExchange(exchange, worker);
+}
+
+Context::Statistics Context::SoplexImpl::statistics() const {
+  Statistics result{Impl::statistics()};
+  result.num_simplex_iterations = theory_solver_.num_simplex_iterations();
+  result.num_cold_restarts = theory_solver_.num_cold_restarts();
+#if HAVE_CADICAL
+  if (theory_propagator_) {
+    result.num_partial_checks = theory_propagator_->num_partial_checks();
+    result.num_propagations = theory_propagator_->num_propagations();
+  }
+#endif
+  return result;
+}
+
+vector<Literal> Context::SoplexImpl::GetFailedAssumptions() const {
+  return sat_solver_.GetFailedAssumptions();
 }
 
 }  // namespace dreal
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <memory>
+
 #include "dreal/solver/context_impl.h"
 #include "dreal/solver/soplex_sat_solver.h"
 #include "dreal/solver/soplex_theory_solver.h"
+#if HAVE_CADICAL
+# include "dreal/solver/soplex_theory_propagator.h"
+#endif
 
 namespace dreal {
 
@@ -16,6 +21,11 @@ class Context::SoplexImpl : public Context::Impl {
   void Pop();
   void Push();
 
+  void SetCancelFlag(const std::atomic<bool>* cancelled) override;
+  void SetClauseExchange(ClauseExchange* exchange, int worker) override;
+
+  Statistics statistics() const override;
+
  protected:
   // Returns the current box in the stack.
   optional<Box> CheckSatCore(const ScopedVector<Formula>& stack, Box box, mpq_class* actual_precision);
@@ -23,8 +33,14 @@ class Context::SoplexImpl : public Context::Impl {
 
   void MinimizeCore(const Expression& obj_expr);
 
+  std::vector<Literal> GetFailedAssumptions() const;
+
   SoplexSatSolver sat_solver_;
   SoplexTheorySolver theory_solver_;
+#if HAVE_CADICAL
+  // Checks partial assignments during the search, with Config::CADICAL.
+  std::unique_ptr<SoplexTheoryPropagator> theory_propagator_;
+#endif
 };
 
 }  // namespace dreal
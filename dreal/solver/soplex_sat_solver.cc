@@ -1,5 +1,7 @@
 #include "dreal/solver/soplex_sat_solver.h"
 
+#include <atomic>
+#include <iterator>
 #include <ostream>
 #include <utility>
 #include <cmath>
@@ -9,11 +11,20 @@
 #include "dreal/util/logging.h"
 #include "dreal/util/stat.h"
 #include "dreal/util/timer.h"
+#if HAVE_CADICAL
+# include "dreal/solver/soplex_theory_propagator.h"
+#endif
 
 namespace dreal {
 
+namespace {
+// Interrupt callback of PicoSAT. @p state is the cancel flag.
+int IsCancelled(void* const state) {
+  return *static_cast<const std::atomic<bool>*>(state) ? 1 : 0;
+}
+}  // namespace
+
 using std::cout;
-using std::set;
 using std::vector;
 using std::pair;
 using std::make_pair;
@@ -27,7 +38,7 @@ using soplex::LPColRational;
 using dreal::gmp::to_mpq_t;
 
 SoplexSatSolver::SoplexSatSolver(const Config& config) : sat_{picosat_init()},
-    cur_clause_start_{0}, config_(config) {
+    config_(config) {
   // Enable partial checks via picosat_deref_partial. See the call-site in
   // SoplexSatSolver::CheckSat().
   picosat_save_original_clauses(sat_);
@@ -39,6 +50,23 @@ SoplexSatSolver::SoplexSatSolver(const Config& config) : sat_{picosat_init()},
       sat_, static_cast<int>(config.sat_default_phase()));
   DREAL_LOG_DEBUG("SoplexSatSolver::Set Default Phase {}",
                   config.sat_default_phase());
+  if (config.sat_solver() == Config::CADICAL) {
+#if HAVE_CADICAL
+    cadical_ = std::make_unique<CaDiCaL::Solver>();
+    if (config.random_seed() != 0) {
+      cadical_->set("seed", static_cast<int>(config.random_seed()));
+    }
+    if (config.sat_default_phase() == Config::SatDefaultPhase::False) {
+      cadical_->set("phase", 0);
+    } else if (config.sat_default_phase() == Config::SatDefaultPhase::True) {
+      cadical_->set("phase", 1);
+    }
+    DREAL_LOG_DEBUG("SoplexSatSolver::Using CaDiCaL {}",
+                    CaDiCaL::Solver::version());
+#else
+    throw DREAL_RUNTIME_ERROR("CaDiCaL not enabled at compile time");
+#endif
+  }
   spx_prob_.setRealParam(spx_prob_.FEASTOL, 0);
   spx_prob_.setRealParam(spx_prob_.OPTTOL, 0);
   spx_prob_.setBoolParam(spx_prob_.RATREC, false);
@@ -46,6 +74,13 @@ SoplexSatSolver::SoplexSatSolver(const Config& config) : sat_{picosat_init()},
   spx_prob_.setIntParam(spx_prob_.SOLVEMODE, spx_prob_.SOLVEMODE_RATIONAL);
   spx_prob_.setIntParam(spx_prob_.CHECKMODE, spx_prob_.CHECKMODE_RATIONAL);
   spx_prob_.setIntParam(spx_prob_.SYNCMODE, spx_prob_.SYNCMODE_AUTO);
+  // SoplexTheorySolver solves each LP in floating point first, and then
+  // exactly from the final basis. Factorizing that basis in exact arithmetic
+  // as soon as a refinement round needs no pivot certifies the answer at once
+  // when the floating-point basis is right, which is the common case. More
+  // refinement rounds, with pivots, only happen when it is not.
+  spx_prob_.setBoolParam(spx_prob_.RATFAC, true);
+  spx_prob_.setIntParam(spx_prob_.RATFAC_MINSTALLS, 0);
   spx_prob_.setIntParam(spx_prob_.VERBOSITY, config_.verbose_simplex());
   // Default is maximize.
   spx_prob_.setIntParam(spx_prob_.OBJSENSE, spx_prob_.OBJSENSE_MINIMIZE);
@@ -71,6 +106,7 @@ void SoplexSatSolver::AddFormula(const Formula& f) {
     clause = predicate_abstractor_.Convert(clause);
   }
   AddClauses(clauses);
+  AddBoundImplications(clauses);
 }
 
 void SoplexSatSolver::AddFormulas(const vector<Formula>& formulas) {
@@ -83,7 +119,7 @@ void SoplexSatSolver::AddLearnedClause(const LiteralSet& literals) {
   for (const Literal& l : literals) {
       AddLiteral(make_pair(l.first, !(l.second)), true);
   }
-  picosat_add(sat_, 0);
+  SatAdd(0);
 }
 
 void SoplexSatSolver::AddClauses(const vector<Formula>& formulas) {
@@ -92,6 +128,24 @@ void SoplexSatSolver::AddClauses(const vector<Formula>& formulas) {
   }
 }
 
+void SoplexSatSolver::AddBoundImplications(const vector<Formula>& clauses) {
+  const auto& var_to_formula_map = predicate_abstractor_.var_to_formula_map();
+  for (const Formula& clause : clauses) {
+    for (const Variable& var : clause.GetFreeVariables()) {
+      const auto it = var_to_formula_map.find(var);
+      if (it == var_to_formula_map.end()) {
+        continue;
+      }
+      for (const auto& p : bound_implicator_.Add(var, it->second)) {
+        DREAL_LOG_DEBUG("SoplexSatSolver::AddBoundImplications({}{} ∨ {}{})",
+                        p.first.second ? "¬" : "", p.first.first,
+                        p.second.second ? "¬" : "", p.second.first);
+        AddLearnedClause(LiteralSet{p.first, p.second});
+      }
+    }
+  }
+}
+
 void SoplexSatSolver::AddClause(const Formula& f) {
   DREAL_LOG_DEBUG("SoplexSatSolver::AddClause({})", f);
   // Set up Variable ⇔ Literal (in SAT) map.
@@ -121,75 +175,50 @@ class SoplexSatSolverStat : public Stat {
     }
   }
 
-  int num_check_sat_{0};
-  Timer timer_check_sat_;
+  void increase_num_check_sat() { increase(&num_check_sat_); }
+
+  ConcurrentTimer timer_check_sat_;
+
+ private:
+  std::atomic<int> num_check_sat_{0};
 };
 }  // namespace
 
 // Collect active literals, removing those that are only required by learned
 // clauses.
-set<int> SoplexSatSolver::GetMainActiveLiterals() const {
-    set<int> lits;
-    for (int i = 1; i <= picosat_variables(sat_); ++i) {
-      const int model_i{has_picosat_pop_used_ ? picosat_deref(sat_, i)
-                                              : picosat_deref_partial(sat_, i)};
-      if (model_i == 0) {
-        continue;
-      }
-      lits.insert(model_i * i);
-    }
-    for (auto it = lits.begin(); it != lits.end(); ) {
-      int i = *it;
-      int required = false;
-      // Determine whether literal `i' is required
-      auto c_it = main_clause_lookup_.find(i);
-      if (c_it != main_clause_lookup_.end()) {
-        for (int c : c_it->second) {
-          int count = 0;
-          size_t j;
-          for (j = c; j < main_clauses_copy_.size() &&
-                          main_clauses_copy_[j]; ++j) {
-            int k{main_clauses_copy_[j]};
-            if (lits.find(k) != lits.end()) {
-              ++count;
-            }
-          }
-          DREAL_ASSERT(j < main_clauses_copy_.size());  // Detect buffer overrun
-          DREAL_ASSERT(count > 0);  // Should contain at least `i'
-          if (count == 1) {
-            // `i' is the only active literal in clause `c'; hence, required.
-            required = true;
-            break;
-          }
-        }
-      }
-      if (!required) {
-        // There is more than one literal in every main (non-learned) clause
-        // containing literal `i'.  Hence, it is not required.
-        it = lits.erase(it);
-      } else {
-        ++it;
-      }
-    }
-    return lits;
+const vector<int>& SoplexSatSolver::GetMainActiveLiterals() {
+  return main_clauses_.GetActiveLiterals(
+      SatVariables(), [this](const int i) { return SatDeref(i); });
 }
 
 optional<SoplexSatSolver::Model> SoplexSatSolver::CheckSat(const Box& box) {
   static SoplexSatSolverStat stat{DREAL_LOG_INFO_ENABLED};
-  DREAL_LOG_DEBUG("SoplexSatSolver::CheckSat(#vars = {}, #clauses = {})",
-                  picosat_variables(sat_),
-                  picosat_added_original_clauses(sat_));
-  stat.num_check_sat_++;
+  DREAL_LOG_DEBUG("SoplexSatSolver::CheckSat(#vars = {})", SatVariables());
+  stat.increase_num_check_sat();
+#if HAVE_CADICAL
+  if (theory_propagator_) {
+    theory_propagator_->Reset(box);
+  }
+#endif
+  ImportSharedClauses();
+
+  // The SAT solvers forget the assumptions after each call, so they are
+  // given again.
+  failed_assumptions_.clear();
+  for (const Literal& l : assumptions_) {
+    MakeSatVar(l.first);
+    SatAssume(GetSatLiteral(l));
+  }
   // Call SAT solver.
-  TimerGuard check_sat_timer_guard(&stat.timer_check_sat_,
-                                   DREAL_LOG_INFO_ENABLED);
-  const int ret{picosat_sat(sat_, -1)};
+  ConcurrentTimerGuard check_sat_timer_guard(&stat.timer_check_sat_,
+                                             DREAL_LOG_INFO_ENABLED);
+  const int ret{SatSolve()};
   check_sat_timer_guard.pause();
 
   Model model;
   if (ret == PICOSAT_SATISFIABLE) {
     // SAT Case.
-    set<int> lits{GetMainActiveLiterals()};
+    const vector<int>& lits{GetMainActiveLiterals()};
     ResetLinearProblem(box);
     const auto& var_to_formula_map = predicate_abstractor_.var_to_formula_map();
     for (int i : lits) {
@@ -220,55 +249,451 @@ optional<SoplexSatSolver::Model> SoplexSatSolver::CheckSat(const Box& box) {
             i > 0 ? "" : "¬", var);
       }
     }
+    DisableUnusedRows();
     DREAL_LOG_DEBUG("SoplexSatSolver::CheckSat() Found a model.");
     return model;
   } else if (ret == PICOSAT_UNSATISFIABLE) {
     DREAL_LOG_DEBUG("SoplexSatSolver::CheckSat() No solution.");
     // UNSAT Case.
+    for (const Literal& l : assumptions_) {
+      if (SatFailed(GetSatLiteral(l))) {
+        failed_assumptions_.push_back(l);
+      }
+    }
     return {};
   } else {
     DREAL_ASSERT(ret == PICOSAT_UNKNOWN);
+    if (cancelled_ != nullptr && *cancelled_) {
+      DREAL_LOG_DEBUG("SoplexSatSolver::CheckSat() Cancelled.");
+      throw DREAL_RUNTIME_ERROR("SoplexSatSolver::CheckSat() was cancelled.");
+    }
     DREAL_LOG_CRITICAL("PICOSAT returns PICOSAT_UNKNOWN.");
     throw DREAL_RUNTIME_ERROR("PICOSAT returns PICOSAT_UNKNOWN.");
   }
 }
 
+void SoplexSatSolver::EnableTheoryLiterals(const Box& box,
+                                           const vector<Literal>& literals) {
+  ResetLinearProblem(box);
+  const auto& var_to_formula_map = predicate_abstractor_.var_to_formula_map();
+  for (const Literal& literal : literals) {
+    if (var_to_formula_map.count(literal.first) > 0) {
+      EnableLinearLiteral(literal.first, literal.second);
+    }
+  }
+  DisableUnusedRows();
+}
+
+vector<pair<Literal, vector<Literal>>> SoplexSatSolver::GetImpliedLiterals()
+    const {
+  const auto& var_to_formula_map = predicate_abstractor_.var_to_formula_map();
+  const Rational ninfty{-soplex::infinity};
+  const Rational infty{soplex::infinity};
+  auto is_infinite = [&ninfty, &infty](const Rational& bound) {
+    return bound <= ninfty || infty <= bound;
+  };
+  vector<pair<Literal, vector<Literal>>> implied;
+  for (size_t spx_row = 0; spx_row < from_spx_row_.size(); ++spx_row) {
+    // The range of the row activity over the column bounds, and the literals
+    // of the bounds which give each end of it.
+    Rational min_activity{0};
+    Rational max_activity{0};
+    bool has_min{true};
+    bool has_max{true};
+    vector<Literal> min_reason;
+    vector<Literal> max_reason;
+    const soplex::SVectorRational& row{
+        spx_prob_.rowVectorRational(static_cast<int>(spx_row))};
+    for (int k = 0; k < row.size() && (has_min || has_max); ++k) {
+      const int spx_col{row.index(k)};
+      if (from_spx_col_.count(spx_col) == 0) {
+        // An artificial variable of phase two, which is not part of the atom.
+        continue;
+      }
+      const Rational& coeff{row.value(k)};
+      const bool positive{coeff > 0};
+      const Rational& min_bound{positive ? spx_lower_[spx_col]
+                                         : spx_upper_[spx_col]};
+      const Rational& max_bound{positive ? spx_upper_[spx_col]
+                                         : spx_lower_[spx_col]};
+      const optional<Literal>& min_lit{positive ? spx_lower_lit_[spx_col]
+                                                : spx_upper_lit_[spx_col]};
+      const optional<Literal>& max_lit{positive ? spx_upper_lit_[spx_col]
+                                                : spx_lower_lit_[spx_col]};
+      if (is_infinite(min_bound)) {
+        has_min = false;
+      } else if (has_min) {
+        min_activity += coeff * min_bound;
+        if (min_lit) {
+          min_reason.push_back(*min_lit);
+        }
+      }
+      if (is_infinite(max_bound)) {
+        has_max = false;
+      } else if (has_max) {
+        max_activity += coeff * max_bound;
+        if (max_lit) {
+          max_reason.push_back(*max_lit);
+        }
+      }
+    }
+    if (!has_min && !has_max) {
+      continue;
+    }
+    // The bounds of the strict literals are relaxed in the LP, so the range
+    // may be wider than the true one, but never narrower. The implications
+    // below are therefore valid, as long as the strictness of the atom
+    // itself is taken into account.
+    const Variable& var{from_spx_row_[spx_row].first};
+    const Formula& formula{var_to_formula_map.at(var)};
+    const bool strict{is_less_than(formula) || is_greater_than(formula)};
+    const Rational rhs{to_mpq_t(spx_rhs_[spx_row])};
+    switch (spx_sense_[spx_row]) {
+      case 'L':
+        if (has_max && (strict ? max_activity < rhs : max_activity <= rhs)) {
+          implied.emplace_back(Literal{var, true}, max_reason);
+        } else if (has_min &&
+                   (strict ? rhs <= min_activity : rhs < min_activity)) {
+          implied.emplace_back(Literal{var, false}, min_reason);
+        }
+        break;
+      case 'G':
+        if (has_min && (strict ? rhs < min_activity : rhs <= min_activity)) {
+          implied.emplace_back(Literal{var, true}, min_reason);
+        } else if (has_max &&
+                   (strict ? max_activity <= rhs : max_activity < rhs)) {
+          implied.emplace_back(Literal{var, false}, max_reason);
+        }
+        break;
+      case 'E':
+        if (has_min && has_max && min_activity == rhs &&
+            max_activity == rhs) {
+          min_reason.insert(min_reason.end(), max_reason.begin(),
+                            max_reason.end());
+          implied.emplace_back(Literal{var, true}, min_reason);
+        } else if (has_min && rhs < min_activity) {
+          implied.emplace_back(Literal{var, false}, min_reason);
+        } else if (has_max && max_activity < rhs) {
+          implied.emplace_back(Literal{var, false}, max_reason);
+        }
+        break;
+      default:
+        DREAL_UNREACHABLE();
+    }
+  }
+  return implied;
+}
+
+optional<Literal> SoplexSatSolver::GetTheoryLiteral(const int lit) const {
+  const auto it_var = to_sym_var_.find(abs(lit));
+  if (it_var == to_sym_var_.end()) {
+    return nullopt;
+  }
+  const Variable& var{it_var->second};
+  if (predicate_abstractor_.var_to_formula_map().count(var) == 0) {
+    return nullopt;
+  }
+  return Literal{var, lit > 0};
+}
+
+int SoplexSatSolver::GetSatLiteral(const Literal& literal) const {
+  const auto it = to_sat_var_.find(literal.first.get_id());
+  DREAL_ASSERT(it != to_sat_var_.end());
+  return literal.second ? it->second : -it->second;
+}
+
+#if HAVE_CADICAL
+void SoplexSatSolver::ConnectTheoryPropagator(
+    SoplexTheoryPropagator* const propagator) {
+  DREAL_ASSERT(propagator != nullptr);
+  if (!cadical_) {
+    throw DREAL_RUNTIME_ERROR(
+        "SoplexSatSolver::ConnectTheoryPropagator() requires CaDiCaL");
+  }
+  theory_propagator_ = propagator;
+  cadical_->connect_external_propagator(propagator);
+  // Observe the theory atoms which already have a SAT variable. The others
+  // are observed as they are created, in MakeSatVar().
+  const auto& var_to_formula_map = predicate_abstractor_.var_to_formula_map();
+  for (const auto& p : to_sat_var_) {
+    const auto it = to_sym_var_.find(p.second);
+    if (it != to_sym_var_.end() && var_to_formula_map.count(it->second) > 0) {
+      cadical_->add_observed_var(p.second);
+    }
+  }
+}
+#endif
+
+void SoplexSatSolver::SatPush() {
+#if HAVE_CADICAL
+  if (cadical_) {
+    // CaDiCaL has no push/pop: the clauses of a scope are guarded by a
+    // selector variable, which is assumed while the scope is open.
+    cadical_scopes_.push_back(++cadical_max_var_);
+    return;
+  }
+#endif
+  picosat_push(sat_);
+}
+
+void SoplexSatSolver::SatPop() {
+#if HAVE_CADICAL
+  if (cadical_) {
+    // Disable the clauses of the scope for good.
+    cadical_->add(-cadical_scopes_.back());
+    cadical_->add(0);
+    cadical_scopes_.pop_back();
+    return;
+  }
+#endif
+  picosat_pop(sat_);
+  has_picosat_pop_used_ = true;
+}
+
+int SoplexSatSolver::SatNewVar() {
+#if HAVE_CADICAL
+  if (cadical_) {
+    return ++cadical_max_var_;
+  }
+#endif
+  return picosat_inc_max_var(sat_);
+}
+
+void SoplexSatSolver::SatAdd(const int lit) {
+#if HAVE_CADICAL
+  if (cadical_) {
+    if (lit == 0 && !cadical_scopes_.empty()) {
+      cadical_->add(-cadical_scopes_.back());
+    }
+    cadical_->add(lit);
+    return;
+  }
+#endif
+  picosat_add(sat_, lit);
+}
+
+void SoplexSatSolver::SatAssume(const int lit) {
+#if HAVE_CADICAL
+  if (cadical_) {
+    cadical_->assume(lit);
+    return;
+  }
+#endif
+  picosat_assume(sat_, lit);
+}
+
+int SoplexSatSolver::SatSolve() {
+#if HAVE_CADICAL
+  if (cadical_) {
+    // CaDiCaL follows the same convention as PicoSAT: 10 for SAT, 20 for
+    // UNSAT and 0 for unknown.
+    for (const int selector : cadical_scopes_) {
+      cadical_->assume(selector);
+    }
+    return cadical_->solve();
+  }
+#endif
+  return picosat_sat(sat_, -1);
+}
+
+bool SoplexSatSolver::SatFailed(const int lit) const {
+#if HAVE_CADICAL
+  if (cadical_) {
+    return cadical_->failed(lit);
+  }
+#endif
+  return picosat_failed_assumption(sat_, lit) != 0;
+}
+
+int SoplexSatSolver::SatDeref(const int var) const {
+#if HAVE_CADICAL
+  if (cadical_) {
+    return cadical_->val(var) > 0 ? 1 : -1;
+  }
+#endif
+  return has_picosat_pop_used_ ? picosat_deref(sat_, var)
+                               : picosat_deref_partial(sat_, var);
+}
+
+int SoplexSatSolver::SatVariables() const {
+#if HAVE_CADICAL
+  if (cadical_) {
+    return cadical_max_var_;
+  }
+#endif
+  return picosat_variables(sat_);
+}
+
+void SoplexSatSolver::SetAssumptions(const vector<Literal>& literals) {
+  DREAL_LOG_DEBUG("SoplexSatSolver::SetAssumptions(#literals = {})",
+                  literals.size());
+  assumptions_ = literals;
+  failed_assumptions_.clear();
+}
+
+void SoplexSatSolver::SetCancelFlag(const std::atomic<bool>* const cancelled) {
+  cancelled_ = cancelled;
+  // PicoSAT calls the callback from time to time during the search, and
+  // returns PICOSAT_UNKNOWN as soon as it yields a non-zero value.
+  if (cancelled != nullptr) {
+    picosat_set_interrupt(sat_, const_cast<std::atomic<bool>*>(cancelled),
+                          IsCancelled);
+  } else {
+    picosat_set_interrupt(sat_, nullptr, nullptr);
+  }
+#if HAVE_CADICAL
+  if (cadical_) {
+    if (cadical_terminator_) {
+      cadical_->disconnect_terminator();
+      cadical_terminator_.reset();
+    }
+    if (cancelled != nullptr) {
+      cadical_terminator_ = std::make_unique<CancelTerminator>(cancelled);
+      cadical_->connect_terminator(cadical_terminator_.get());
+    }
+  }
+#endif
+}
+
+void SoplexSatSolver::SetClauseExchange(ClauseExchange* const exchange,
+                                        const int worker) {
+  clause_exchange_ = exchange;
+  clause_exchange_worker_ = worker;
+  clause_exchange_cursor_ = 0;
+  // The ids are only valid in the exchange which gave them.
+  to_shared_atom_.clear();
+  from_shared_atom_.clear();
+}
+
+void SoplexSatSolver::ShareLearnedClause(const LiteralSet& literals) {
+  if (clause_exchange_ == nullptr ||
+      static_cast<int>(literals.size()) > clause_exchange_->max_clause_size()) {
+    return;
+  }
+  const auto& var_to_formula_map = predicate_abstractor_.var_to_formula_map();
+  vector<int> clause;
+  clause.reserve(literals.size());
+  for (const Literal& l : literals) {
+    auto it = to_shared_atom_.find(l.first.get_id());
+    if (it == to_shared_atom_.end()) {
+      const auto atom_it = var_to_formula_map.find(l.first);
+      if (atom_it == var_to_formula_map.end()) {
+        // Not a theory atom, e.g. the guard of an assumption.
+        return;
+      }
+      const int id{clause_exchange_->AtomId(atom_it->second)};
+      it = to_shared_atom_.emplace(l.first.get_id(), id).first;
+      from_shared_atom_.emplace(id, l.first);
+    }
+    // The learned clause is the negation of the explanation.
+    clause.push_back(l.second ? -(it->second + 1) : it->second + 1);
+  }
+  clause_exchange_->Publish(clause_exchange_worker_, clause);
+}
+
+void SoplexSatSolver::ImportSharedClauses() {
+  if (clause_exchange_ == nullptr) {
+    return;
+  }
+  const auto& formula_to_var_map = predicate_abstractor_.formula_to_var_map();
+  for (const vector<int>& clause : clause_exchange_->Collect(
+           clause_exchange_worker_, &clause_exchange_cursor_)) {
+    LiteralSet explanation;
+    for (const int lit : clause) {
+      const int id{abs(lit) - 1};
+      auto it = from_shared_atom_.find(id);
+      if (it == from_shared_atom_.end()) {
+        const auto var_it = formula_to_var_map.find(clause_exchange_->atom(id));
+        if (var_it == formula_to_var_map.end()) {
+          break;
+        }
+        it = from_shared_atom_.emplace(id, var_it->second).first;
+        to_shared_atom_.emplace(var_it->second.get_id(), id);
+      }
+      if (to_sat_var_.count(it->second.get_id()) == 0) {
+        break;
+      }
+      explanation.emplace(it->second, lit < 0);
+    }
+    // A clause on an atom which this worker doesn't know is dropped.
+    if (explanation.size() == clause.size()) {
+      DREAL_LOG_DEBUG("SoplexSatSolver::ImportSharedClauses() #literals = {}",
+                      clause.size());
+      AddLearnedClause(explanation);
+    }
+  }
+}
+
 void SoplexSatSolver::Pop() {
-  // FIXME: disabled for QSopt_ex changes
-  throw DREAL_RUNTIME_ERROR("SoplexSatSolver::Pop() currently unsupported");
   DREAL_LOG_DEBUG("SoplexSatSolver::Pop()");
+  if (scopes_.empty()) {
+    throw DREAL_RUNTIME_ERROR(
+        "SoplexSatSolver cannot be popped because its scope is empty.");
+  }
+  const Scope& scope{scopes_.back()};
   cnf_variables_.pop();
+  cnfizer_.Pop();
   to_sym_var_.pop();
   to_sat_var_.pop();
-  picosat_pop(sat_);
-  has_picosat_pop_used_ = true;
+  bound_implicator_.Pop();
+  SatPop();
+
+  // Forget the main clauses added in this scope.
+  main_clauses_.Resize(scope.main_clauses);
+
+  // Remove the rows and columns created in this scope (including artificial
+  // columns). They are always at the end of the LP.
+  const int spx_rows{spx_prob_.numRowsRational()};
+  if (spx_rows > scope.rows) {
+    spx_prob_.removeRowRangeRational(scope.rows, spx_rows - 1);
+    for (auto it = to_spx_row_.begin(); it != to_spx_row_.end();) {
+      it = it->second >= scope.rows ? to_spx_row_.erase(it) : std::next(it);
+    }
+    from_spx_row_.resize(scope.rows);
+    spx_rhs_.resize(scope.rows);
+    spx_sense_.resize(scope.rows);
+    spx_row_active_.resize(scope.rows);
+    spx_row_used_.resize(scope.rows);
+  }
+  const int spx_cols{spx_prob_.numColsRational()};
+  if (spx_cols > scope.cols) {
+    spx_prob_.removeColRangeRational(scope.cols, spx_cols - 1);
+    for (auto it = to_spx_col_.begin(); it != to_spx_col_.end();) {
+      it = it->second >= scope.cols ? to_spx_col_.erase(it) : std::next(it);
+    }
+    from_spx_col_.erase(from_spx_col_.lower_bound(scope.cols),
+                        from_spx_col_.end());
+    spx_lower_.reDim(scope.cols);
+    spx_upper_.reDim(scope.cols);
+    spx_lower_lit_.resize(scope.cols);
+    spx_upper_lit_.resize(scope.cols);
+  }
+  scopes_.pop_back();
 }
 
 void SoplexSatSolver::Push() {
-  // FIXME: disabled for QSopt_ex changes
-  throw DREAL_RUNTIME_ERROR("SoplexSatSolver::Push() currently unsupported");
   DREAL_LOG_DEBUG("SoplexSatSolver::Push()");
-  picosat_push(sat_);
+  scopes_.push_back({spx_prob_.numRowsRational(), spx_prob_.numColsRational(),
+                     main_clauses_.size()});
+  SatPush();
+  bound_implicator_.Push();
   to_sat_var_.push();
   to_sym_var_.push();
   cnf_variables_.push();
+  cnfizer_.Push();
 }
 
-void SoplexSatSolver::SetSPXVarCoef(DSVectorRational* coeffs, const Variable& var,
+void SoplexSatSolver::SetSPXVarCoef(DSVectorRational* coeffs, const int spx_col,
                                     const mpq_class& value) {
   DREAL_ASSERT(coeffs != nullptr);
-  const auto it = to_spx_col_.find(var.get_id());
-  if (it == to_spx_col_.end()) {
-    throw DREAL_RUNTIME_ERROR("Variable undefined: {}", var);
-  }
   if (value <= -soplex::infinity || value >= soplex::infinity) {
     throw DREAL_RUNTIME_ERROR("LP coefficient too large: {}", value);
   }
-  coeffs->add(it->second, to_mpq_t(value));
+  coeffs->add(spx_col, to_mpq_t(value));
 }
 
-void SoplexSatSolver::SetSPXVarBound(const Variable& var, const char type,
-                                     const mpq_class& value) {
+void SoplexSatSolver::SetSPXVarBound(const Literal& lit, const Variable& var,
+                                     const char type, const mpq_class& value) {
   DREAL_ASSERT(type == 'L' || type == 'U' || type == 'B');
   const auto it = to_spx_col_.find(var.get_id());
   if (it == to_spx_col_.end()) {
@@ -280,6 +705,7 @@ void SoplexSatSolver::SetSPXVarBound(const Variable& var, const char type,
   if (type == 'L' || type == 'B') {
     if (to_mpq_t(value) > spx_lower_[it->second]) {
       spx_lower_[it->second] = to_mpq_t(value);
+      spx_lower_lit_[it->second] = lit;
       DREAL_LOG_TRACE("SoplexSatSolver::SetSPXVarBound ('{}'): set lower bound of {} to {}",
                       type, var, spx_lower_[it->second]);
     }
@@ -287,6 +713,7 @@ void SoplexSatSolver::SetSPXVarBound(const Variable& var, const char type,
   if (type == 'U' || type == 'B') {
     if (to_mpq_t(value) < spx_upper_[it->second]) {
       spx_upper_[it->second] = to_mpq_t(value);
+      spx_upper_lit_[it->second] = lit;
       DREAL_LOG_TRACE("SoplexSatSolver::SetSPXVarBound ('{}'): set upper bound of {} to {}",
                       type, var, spx_upper_[it->second]);
     }
@@ -295,13 +722,18 @@ void SoplexSatSolver::SetSPXVarBound(const Variable& var, const char type,
 
 void SoplexSatSolver::ResetLinearProblem(const Box& box) {
   DREAL_LOG_TRACE("SoplexSatSolver::ResetLinearProblem(): Box =\n{}", box);
-  // Omitting to do this seems to cause problems in soplex
-  spx_prob_.clearBasis();
-  // Clear constraint bounds
+  const bool warm_start{config_.simplex_warm_start()};
   const int spx_rows{spx_prob_.numRowsRational()};
   DREAL_ASSERT(static_cast<size_t>(spx_rows) == from_spx_row_.size());
-  for (int i = 0; i < spx_rows; i++) {
-    spx_prob_.changeRangeRational(i, -soplex::infinity, soplex::infinity);
+  spx_row_used_.assign(spx_rows, false);
+  if (!warm_start) {
+    // Omitting to do this seems to cause problems in soplex
+    spx_prob_.clearBasis();
+    // Clear constraint bounds
+    for (int i = 0; i < spx_rows; i++) {
+      spx_prob_.changeRangeRational(i, -soplex::infinity, soplex::infinity);
+    }
+    spx_row_active_.assign(spx_rows, false);
   }
   // Clear variable bounds
   const int spx_cols{spx_prob_.numColsRational()};
@@ -319,7 +751,22 @@ void SoplexSatSolver::ResetLinearProblem(const Box& box) {
       spx_lower_[kv.first] = -soplex::infinity;
       spx_upper_[kv.first] = soplex::infinity;
     }
-    spx_prob_.changeBoundsRational(kv.first, -soplex::infinity, soplex::infinity);
+    spx_lower_lit_[kv.first] = nullopt;
+    spx_upper_lit_[kv.first] = nullopt;
+    if (!warm_start) {
+      spx_prob_.changeBoundsRational(kv.first, -soplex::infinity, soplex::infinity);
+    }
+  }
+}
+
+void SoplexSatSolver::DisableUnusedRows() {
+  const int spx_rows{spx_prob_.numRowsRational()};
+  for (int i = 0; i < spx_rows; i++) {
+    if (spx_row_active_[i] && !spx_row_used_[i]) {
+      spx_prob_.changeRangeRational(i, -soplex::infinity, soplex::infinity);
+      spx_row_active_[i] = false;
+      DREAL_LOG_TRACE("SoplexSatSolver::DisableUnusedRows({})", i);
+    }
   }
 }
 
@@ -361,16 +808,37 @@ static bool is_less_or_whatever(const Formula& formula, bool truth) {
   return is_greater_or_whatever(formula, !truth);
 }
 
+// Returns the sense of the (relaxed) negation of a row with sense @p sense.
+static char FlipSense(const char sense) {
+  DREAL_ASSERT(sense == 'L' || sense == 'G');
+  return sense == 'L' ? 'G' : 'L';
+}
+
 void SoplexSatSolver::EnableLinearLiteral(const Variable& var, bool truth) {
-    const auto it_row = to_spx_row_.find(make_pair(var.get_id(), truth));
+    const auto it_row = to_spx_row_.find(var.get_id());
     if (it_row != to_spx_row_.end()) {
       // A non-trivial linear literal from the input problem
       const int spx_row = it_row->second;
-      const char sense{spx_sense_[spx_row]};
+      if (!truth && spx_sense_[spx_row] == 'E') {
+        // The negation of an equality, which is always delta-sat.
+        DREAL_LOG_TRACE(
+            "SoplexSatSolver::EnableLinearLiteral: ignoring ({}, {})", var,
+            truth);
+        return;
+      }
+      spx_row_used_[spx_row] = true;
+      if (spx_row_active_[spx_row] && from_spx_row_[spx_row].second == truth) {
+        // Still enabled from the previous check
+        return;
+      }
+      from_spx_row_[spx_row] = Literal{var, truth};
+      const char sense{truth ? spx_sense_[spx_row]
+                             : FlipSense(spx_sense_[spx_row])};
       const mpq_class& rhs{spx_rhs_[spx_row]};
       spx_prob_.changeRangeRational(spx_row,
         sense == 'G' || sense == 'E' ? Rational(to_mpq_t(rhs)) : Rational(-soplex::infinity),
         sense == 'L' || sense == 'E' ? Rational(to_mpq_t(rhs)) : Rational(soplex::infinity));
+      spx_row_active_[spx_row] = true;
       DREAL_LOG_TRACE("SoplexSatSolver::EnableLinearLiteral({})", spx_row);
       return;
     }
@@ -381,29 +849,30 @@ void SoplexSatSolver::EnableLinearLiteral(const Variable& var, bool truth) {
       const Formula& formula{it->second};
       const Expression& lhs{get_lhs_expression(formula)};
       const Expression& rhs{get_rhs_expression(formula)};
+      const Literal lit{var, truth};
       DREAL_LOG_TRACE("SoplexSatSolver::EnableLinearLiteral({}{})",
                       truth ? "" : "¬", formula);
       if (is_equal_or_whatever(formula, truth)) {
         if (is_variable(lhs) && is_constant(rhs)) {
-          SetSPXVarBound(get_variable(lhs), 'B', get_constant_value(rhs));
+          SetSPXVarBound(lit, get_variable(lhs), 'B', get_constant_value(rhs));
         } else if (is_constant(lhs) && is_variable(rhs)) {
-          SetSPXVarBound(get_variable(rhs), 'B', get_constant_value(lhs));
+          SetSPXVarBound(lit, get_variable(rhs), 'B', get_constant_value(lhs));
         } else {
           DREAL_UNREACHABLE();
         }
       } else if (is_greater_or_whatever(formula, truth)) {
         if (is_variable(lhs) && is_constant(rhs)) {
-          SetSPXVarBound(get_variable(lhs), 'L', get_constant_value(rhs));
+          SetSPXVarBound(lit, get_variable(lhs), 'L', get_constant_value(rhs));
         } else if (is_constant(lhs) && is_variable(rhs)) {
-          SetSPXVarBound(get_variable(rhs), 'U', get_constant_value(lhs));
+          SetSPXVarBound(lit, get_variable(rhs), 'U', get_constant_value(lhs));
         } else {
           DREAL_UNREACHABLE();
         }
       } else if (is_less_or_whatever(formula, truth)) {
         if (is_variable(lhs) && is_constant(rhs)) {
-          SetSPXVarBound(get_variable(lhs), 'U', get_constant_value(rhs));
+          SetSPXVarBound(lit, get_variable(lhs), 'U', get_constant_value(rhs));
         } else if (is_constant(lhs) && is_variable(rhs)) {
-          SetSPXVarBound(get_variable(rhs), 'L', get_constant_value(lhs));
+          SetSPXVarBound(lit, get_variable(rhs), 'L', get_constant_value(lhs));
         } else {
           DREAL_UNREACHABLE();
         }
@@ -428,9 +897,9 @@ void SoplexSatSolver::AddLinearLiteral(const Variable& formulaVar, bool truth) {
       // Boolean variable - no need to involve theory solver
       return;
     }
-    const auto it2 = to_spx_row_.find(make_pair(formulaVar.get_id(), truth));
+    const auto it2 = to_spx_row_.find(formulaVar.get_id());
     if (it2 != to_spx_row_.end()) {
-      // Found.
+      // Found, possibly with the other polarity.
       return;
     }
     // Theory formula
@@ -439,21 +908,25 @@ void SoplexSatSolver::AddLinearLiteral(const Variable& formulaVar, bool truth) {
     for (const Variable& var : formula.GetFreeVariables()) {
       AddLinearVariable(var);
     }
+    // The row is shared by both polarities of the atom, and spx_sense_ holds
+    // its sense when the atom is true. EnableLinearLiteral flips it when the
+    // atom is false, since the strict inequalities are relaxed.
+    char sense;
     if (is_equal_or_whatever(formula, truth)) {
       if (is_simple_bound(formula)) {
         return;  // Just create simple bound in LP
       }
-      spx_sense_.push_back('E');
+      sense = 'E';
     } else if (is_greater_or_whatever(formula, truth)) {
       if (is_simple_bound(formula)) {
         return;
       }
-      spx_sense_.push_back('G');
+      sense = 'G';
     } else if (is_less_or_whatever(formula, truth)) {
       if (is_simple_bound(formula)) {
         return;
       }
-      spx_sense_.push_back('L');
+      sense = 'L';
     } else if (is_not_equal_or_whatever(formula, truth)) {
       // Nothing to do, because this constraint is always delta-sat for
       // delta > 0.
@@ -461,50 +934,36 @@ void SoplexSatSolver::AddLinearLiteral(const Variable& formulaVar, bool truth) {
     } else {
       throw DREAL_RUNTIME_ERROR("Formula {} not supported", formula);
     }
-    Expression expr;
-    expr = (get_lhs_expression(formula) - get_rhs_expression(formula)).Expand();
+    const Expression& lhs{get_lhs_expression(formula)};
+    const Expression& rhs{get_rhs_expression(formula)};
+    // Fall back to the expanded form for the atoms which are only linear
+    // once expanded, e.g. x * (y + 1) - x * y.
+    if (!linear_form_.Extract(lhs, rhs, to_spx_col_) &&
+        !linear_form_.Extract((lhs - rhs).Expand(), to_spx_col_)) {
+      throw DREAL_RUNTIME_ERROR("Expression {} not supported", lhs - rhs);
+    }
     const int spx_row{spx_prob_.numRowsRational()};
-    DSVectorRational coeffs;
-    DREAL_ASSERT(static_cast<size_t>(spx_row) == spx_sense_.size() - 1);
+    DSVectorRational coeffs(linear_form_.columns().size());
+    DREAL_ASSERT(static_cast<size_t>(spx_row) == spx_sense_.size());
+    spx_sense_.push_back(truth ? sense : FlipSense(sense));
     DREAL_ASSERT(static_cast<size_t>(spx_row) == spx_rhs_.size());
-    spx_rhs_.push_back(0);
-    if (is_constant(expr)) {
-      spx_rhs_.back() = -get_constant_value(expr);
-    } else if (is_variable(expr)) {
-      SetSPXVarCoef(&coeffs, get_variable(expr), 1);
-    } else if (is_multiplication(expr)) {
-      std::map<Expression,Expression> map = get_base_to_exponent_map_in_multiplication(expr);
-      if (map.size() != 1
-       || !is_variable(map.begin()->first)
-       || !is_constant(map.begin()->second)
-       || get_constant_value(map.begin()->second) != 1) {
-        throw DREAL_RUNTIME_ERROR("Expression {} not supported", expr);
-      }
-      SetSPXVarCoef(&coeffs,
-                    get_variable(map.begin()->first),
-                    get_constant_in_multiplication(expr));
-    } else if (is_addition(expr)) {
-      const std::map<Expression,mpq_class>& map = get_expr_to_coeff_map_in_addition(expr);
-      for (const pair<Expression,mpq_class>& pair : map) {
-        if (!is_variable(pair.first)) {
-          throw DREAL_RUNTIME_ERROR("Expression {} not supported", expr);
-        }
-        SetSPXVarCoef(&coeffs, get_variable(pair.first), pair.second);
-      }
-      spx_rhs_.back() = -get_constant_in_addition(expr);
-    } else {
-        throw DREAL_RUNTIME_ERROR("Expression {} not supported", expr);
+    for (size_t i = 0; i < linear_form_.columns().size(); ++i) {
+      SetSPXVarCoef(&coeffs, linear_form_.columns()[i],
+                    linear_form_.coefficients()[i]);
     }
+    spx_rhs_.push_back(-linear_form_.constant());
     if (spx_rhs_.back() <= -soplex::infinity || spx_rhs_.back() >= soplex::infinity) {
       throw DREAL_RUNTIME_ERROR("LP RHS value too large: {}", spx_rhs_.back());
     }
     // Inactive
     spx_prob_.addRowRational(LPRowRational(-soplex::infinity, coeffs, soplex::infinity));
+    spx_row_active_.push_back(false);
+    spx_row_used_.push_back(false);
     if (2 == config_.simplex_sat_phase()) {
       CreateArtificials(spx_row);
     }
     // Update indexes
-    to_spx_row_.emplace(make_pair(make_pair(formulaVar.get_id(), truth), spx_row));
+    to_spx_row_.emplace(formulaVar.get_id(), spx_row);
     DREAL_ASSERT(static_cast<size_t>(spx_row) == from_spx_row_.size());
     from_spx_row_.push_back(make_pair(formulaVar, truth));
     DREAL_LOG_DEBUG("SoplexSatSolver::AddLinearLiteral({}{} ↦ {})",
@@ -518,6 +977,8 @@ void SoplexSatSolver::CreateArtificials(const int spx_row) {
   spx_upper_.reDim(spx_cols + 2, false);
   spx_upper_[spx_cols] = soplex::infinity;  // Set upper bounds to infinity
   spx_upper_[spx_cols + 1] = soplex::infinity;
+  spx_lower_lit_.resize(spx_cols + 2);
+  spx_upper_lit_.resize(spx_cols + 2);
   DSVectorRational coeffsPos;
   coeffsPos.add(spx_row, 1);
   spx_prob_.addColRational(LPColRational(1, coeffsPos, soplex::infinity, 0));
@@ -532,8 +993,7 @@ void SoplexSatSolver::UpdateLookup(int lit, int learned) {
   if (learned) {
     learned_clause_lits_.insert(lit);
   } else {
-    main_clauses_copy_.push_back(lit);
-    main_clause_lookup_[lit].insert(cur_clause_start_);
+    main_clauses_.AddLiteral(lit);
   }
 }
 
@@ -544,7 +1004,7 @@ void SoplexSatSolver::AddLiteral(const Literal& l, bool learned) {
     DREAL_ASSERT(var.get_type() == Variable::Type::BOOLEAN);
     // Add l = b
     int lit{to_sat_var_[var.get_id()]};
-    picosat_add(sat_, lit);
+    SatAdd(lit);
     UpdateLookup(lit, learned);
     if (!learned) {
       AddLinearLiteral(var, true);
@@ -555,7 +1015,7 @@ void SoplexSatSolver::AddLiteral(const Literal& l, bool learned) {
     DREAL_ASSERT(var.get_type() == Variable::Type::BOOLEAN);
     // Add l = ¬b
     int lit{-to_sat_var_[var.get_id()]};
-    picosat_add(sat_, lit);
+    SatAdd(lit);
     UpdateLookup(lit, learned);
     if (!learned) {
       AddLinearLiteral(var, false);
@@ -574,7 +1034,6 @@ void SoplexSatSolver::AddLiteral(const Formula& f) {
 }
 
 void SoplexSatSolver::DoAddClause(const Formula& f) {
-  cur_clause_start_ = main_clauses_copy_.size();
   if (is_disjunction(f)) {
     // f = l₁ ∨ ... ∨ lₙ
     for (const Formula& l : get_operands(f)) {
@@ -584,8 +1043,8 @@ void SoplexSatSolver::DoAddClause(const Formula& f) {
     // f = b or f = ¬b.
     AddLiteral(f);
   }
-  picosat_add(sat_, 0);
-  main_clauses_copy_.push_back(0);
+  SatAdd(0);
+  main_clauses_.EndClause();
 }
 
 void SoplexSatSolver::MakeSatVar(const Variable& var) {
@@ -595,9 +1054,15 @@ void SoplexSatSolver::MakeSatVar(const Variable& var) {
     return;
   }
   // It's not in the maps, let's make one and add it.
-  const int sat_var{picosat_inc_max_var(sat_)};
+  const int sat_var{SatNewVar()};
   to_sat_var_.insert(var.get_id(), sat_var);
   to_sym_var_.insert(sat_var, var);
+#if HAVE_CADICAL
+  if (theory_propagator_ &&
+      predicate_abstractor_.var_to_formula_map().count(var) > 0) {
+    cadical_->add_observed_var(sat_var);
+  }
+#endif
   DREAL_LOG_DEBUG("SoplexSatSolver::MakeSatVar({} ↦ {})", var, sat_var);
 }
 
@@ -612,6 +1077,8 @@ void SoplexSatSolver::AddLinearVariable(const Variable& var) {
   spx_upper_.reDim(spx_col + 1, false);
   spx_lower_[spx_col] = -soplex::infinity;  // Set unbounded
   spx_upper_[spx_col] = soplex::infinity;
+  spx_lower_lit_.resize(spx_col + 1);
+  spx_upper_lit_.resize(spx_col + 1);
   // obj, coeffs, upper, lower
   spx_prob_.addColRational(LPColRational(0, DSVectorRational(),
                                          soplex::infinity, -soplex::infinity));
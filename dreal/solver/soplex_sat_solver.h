@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <set>
 #include <map>
@@ -11,6 +12,10 @@
 
 #include "dreal/solver/config.h"
 #include "dreal/symbolic/symbolic.h"
+#include "dreal/util/bound_implicator.h"
+#include "dreal/util/clause_exchange.h"
+#include "dreal/util/linear_form.h"
+#include "dreal/util/main_clause_tracker.h"
 #include "dreal/util/optional.h"
 #include "dreal/util/predicate_abstractor.h"
 #include "dreal/util/scoped_unordered_map.h"
@@ -19,9 +24,14 @@
 #include "dreal/util/literal.h"
 #include "dreal/gmp.h"
 #include "dreal/soplex.h"
+#if HAVE_CADICAL
+# include "dreal/cadical.h"
+#endif
 
 namespace dreal {
 
+class SoplexTheoryPropagator;
+
 class SoplexSatSolver {
  public:
   // Boolean model + Theory model.
@@ -67,9 +77,39 @@ class SoplexSatSolver {
   /// @returns nullopt if UNSAT.
   optional<Model> CheckSat(const Box& box);
 
-  // TODO(soonho): Push/Pop cnfizer and predicate_abstractor?
+  /// Assumes @p literals in the following calls to CheckSat(), until this
+  /// function is called again.
+  void SetAssumptions(const std::vector<Literal>& literals);
+
+  /// Returns the assumptions which were used to show UNSAT in the last call
+  /// to CheckSat(). It is empty if the clauses are UNSAT on their own.
+  const std::vector<Literal>& GetFailedAssumptions() const {
+    return failed_assumptions_;
+  }
+
+  /// Makes CheckSat() give up, by throwing an exception, once @p cancelled
+  /// is raised by another thread. Pass nullptr to never give up.
+  void SetCancelFlag(const std::atomic<bool>* cancelled);
+
+  /// Shares learned clauses with the other workers of a portfolio through
+  /// @p exchange, where this solver is the worker @p worker. The clauses of
+  /// the other workers are added at the start of each CheckSat(). The ids
+  /// of the atoms cached for a previous exchange are dropped.
+  void SetClauseExchange(ClauseExchange* exchange, int worker);
+
+  /// Publishes the clause learned from the explanation @p literals, as given
+  /// to AddLearnedClause(), to the other workers. Nothing is shared unless
+  /// every literal is on a theory atom.
+  void ShareLearnedClause(const LiteralSet& literals);
+
+  /// Removes the clauses added since the matching Push(), together with the
+  /// LP rows and columns which were created for them.
+  ///
+  /// The predicate abstraction is kept: an atom which comes back later is
+  /// given the same Boolean variable.
   void Pop();
 
+  /// Opens a new scope of clauses.
   void Push();
 
   Formula theory_literal(const Variable& var) const {
@@ -88,8 +128,51 @@ class SoplexSatSolver {
     return spx_upper_;
   }
 
+  /// Returns, for each column, the literal which set its current lower bound
+  /// (or nullopt if the bound comes from the box).
+  const std::vector<optional<Literal>>& GetLowerBoundLiterals() const {
+    return spx_lower_lit_;
+  }
+
+  /// Returns, for each column, the literal which set its current upper bound
+  /// (or nullopt if the bound comes from the box).
+  const std::vector<optional<Literal>>& GetUpperBoundLiterals() const {
+    return spx_upper_lit_;
+  }
+
+  /// Returns the literal associated with each row of the LP.
+  const std::vector<Literal>& GetLinearRowMap() const {
+    return from_spx_row_;
+  }
+
   const std::map<int, Variable>& GetLinearVarMap() const;
 
+  /// Enables the theory literals in @p literals in the linear solver, on top
+  /// of the bounds given by @p box, and disables all the other rows. Literals
+  /// on Boolean variables are ignored.
+  void EnableTheoryLiterals(const Box& box,
+                            const std::vector<Literal>& literals);
+
+  /// Returns the literals on the atoms of the LP rows which follow from the
+  /// column bounds set by the last call to EnableTheoryLiterals(), each with
+  /// the literals which set the bounds used to derive it. Bounds which come
+  /// from the box have no literal.
+  std::vector<std::pair<Literal, std::vector<Literal>>> GetImpliedLiterals()
+      const;
+
+  /// Returns the theory literal which corresponds to the SAT literal @p lit,
+  /// or nullopt if @p lit is not on a theory atom.
+  optional<Literal> GetTheoryLiteral(int lit) const;
+
+  /// Returns the SAT literal which corresponds to @p literal.
+  int GetSatLiteral(const Literal& literal) const;
+
+#if HAVE_CADICAL
+  /// Lets @p propagator check the theory atoms during the search of the SAT
+  /// solver. Only allowed with Config::CADICAL as the SAT solver.
+  void ConnectTheoryPropagator(SoplexTheoryPropagator* propagator);
+#endif
+
  private:
   // Adds a formula @p f to the solver.
   //
@@ -102,15 +185,42 @@ class SoplexSatSolver {
   // @pre Each formula fᵢ ∈ formulas is a clause.
   void AddClauses(const std::vector<Formula>& formulas);
 
+  // Adds binary clauses between the theory atoms which appear in @p clauses
+  // and the atoms seen before, whenever the two can't hold at the same time
+  // (e.g. x ≤ 3 ⇒ x ≤ 5). See BoundImplicator.
+  //
+  // @pre The Boolean variables in @p clauses have SAT variables.
+  void AddBoundImplications(const std::vector<Formula>& clauses);
+
   // Returns a corresponding literal ID of @p var. It maintains two
   // maps `lit_to_var_` and `var_to_lit_` to keep track of the
   // relationship between Variable ⇔ Literal (in SAT).
   void MakeSatVar(const Variable& var);
 
+  // Thin wrappers around the SAT solver in use (PicoSAT or CaDiCaL), with
+  // PicoSAT semantics.
+  int SatNewVar();
+  void SatAdd(int lit);
+  void SatPush();
+  void SatPop();
+  void SatAssume(int lit);
+  int SatSolve();
+  bool SatFailed(int lit) const;
+  int SatDeref(int var) const;
+  int SatVariables() const;
+
   // Disable all literals in the linear solver, restricting variables to the
   // given @p box only.
+  //
+  // With Config::simplex_warm_start(), rows are only marked as unused here,
+  // so that the basis survives; DisableUnusedRows() relaxes the rows which
+  // were not enabled again by EnableLinearLiteral().
   void ResetLinearProblem(const Box& box);
 
+  // Relax the rows which are still active in the linear solver but were not
+  // enabled since the last call to ResetLinearProblem().
+  void DisableUnusedRows();
+
   // Add a symbolic formula @p f to @p clause.
   //
   // @pre @p f is either a Boolean variable or a negation of Boolean
@@ -132,24 +242,29 @@ class SoplexSatSolver {
 
   // Set the variable's coefficient for the given constraint row in the linear
   // solver
-  void SetSPXVarCoef(soplex::DSVectorRational* coeffs, const Variable& var,
+  void SetSPXVarCoef(soplex::DSVectorRational* coeffs, int spx_col,
                      const mpq_class& value);
 
   // Set one of the variable's bounds ('L' - lower or 'U' - upper) in the
-  // linear solver, in addition to bounds already asserted.
-  void SetSPXVarBound(const Variable& var, const char type,
+  // linear solver, in addition to bounds already asserted. The literal @p lit
+  // is recorded as the reason for the bound, if it is tightened.
+  void SetSPXVarBound(const Literal& lit, const Variable& var, const char type,
                       const mpq_class& value);
 
   // Add a clause @p f to sat solver.
   void DoAddClause(const Formula& f);
 
+  // Adds the clauses learned by the other workers of the portfolio since the
+  // last call.
+  void ImportSharedClauses();
+
   // Update data structures used to remove literals that are only required by
   // learned clauses.
   void UpdateLookup(int lit, int learned);
 
   // Collect active literals, removing those that are only required by learned
-  // clauses.
-  std::set<int> GetMainActiveLiterals() const;
+  // clauses. The returned vector is reused by the next call.
+  const std::vector<int>& GetMainActiveLiterals();
 
   // Member variables
   // ----------------
@@ -157,6 +272,7 @@ class SoplexSatSolver {
   PicoSAT* const sat_{};
   PlaistedGreenbaumCnfizer cnfizer_;
   PredicateAbstractor predicate_abstractor_;
+  BoundImplicator bound_implicator_;
 
   // Map symbolic::Variable → int (Variable type in PicoSat).
   ScopedUnorderedMap<Variable::Id, int> to_sat_var_;
@@ -166,10 +282,8 @@ class SoplexSatSolver {
 
   // Data to help with removing literals that are only required by learned
   // clauses.
-  std::vector<int> main_clauses_copy_;
+  MainClauseTracker main_clauses_;
   std::set<int> learned_clause_lits_;
-  std::map<int, std::set<int>> main_clause_lookup_;
-  int cur_clause_start_;
 
   /// Set of temporary Boolean variables introduced by CNF
   /// transformations.
@@ -179,6 +293,8 @@ class SoplexSatSolver {
   soplex::SoPlex spx_prob_;
   soplex::VectorRational spx_lower_;
   soplex::VectorRational spx_upper_;
+  std::vector<optional<Literal>> spx_lower_lit_;
+  std::vector<optional<Literal>> spx_upper_lit_;
 
   // Map symbolic::Variable <-> int (column in SoPlex problem).
   // We don't used the scoped version because we'd like to be sure that we
@@ -187,13 +303,68 @@ class SoplexSatSolver {
   std::map<Variable::Id, int> to_spx_col_;
   std::map<int, Variable> from_spx_col_;
 
-  // Map (symbolic::Variable, bool) <-> int (row in SoPlex problem).
-  std::map<std::pair<Variable::Id, bool>, int> to_spx_row_;
+  // Extracts the coefficients of the rows from the linear atoms.
+  LinearFormExtractor linear_form_;
+
+  // Map symbolic::Variable -> int (row in SoPlex problem). The two
+  // polarities of an atom share its row, whose sense in spx_sense_ is the one
+  // of the positive literal. from_spx_row_ gives the literal which last
+  // enabled each row.
+  std::map<Variable::Id, int> to_spx_row_;
   std::vector<Literal> from_spx_row_;
 
   std::vector<mpq_class> spx_rhs_;
   std::vector<char> spx_sense_;
 
+  // Whether each row is currently enabled in spx_prob_, and whether it has
+  // been enabled since the last call to ResetLinearProblem().
+  std::vector<bool> spx_row_active_;
+  std::vector<bool> spx_row_used_;
+
+#if HAVE_CADICAL
+  // CaDiCaL, which replaces PicoSAT when Config::sat_solver() is CADICAL.
+  std::unique_ptr<CaDiCaL::Solver> cadical_;
+  int cadical_max_var_{0};
+  // Selector variable of each open scope.
+  std::vector<int> cadical_scopes_;
+  SoplexTheoryPropagator* theory_propagator_{nullptr};
+#endif
+
+  // Literals assumed by CheckSat(), and those used by the last UNSAT answer.
+  std::vector<Literal> assumptions_;
+  std::vector<Literal> failed_assumptions_;
+
+  // Raised by another thread when the answer is not needed any more. See
+  // SetCancelFlag().
+  const std::atomic<bool>* cancelled_{nullptr};
+
+  // Clauses shared with the other workers of a portfolio. Atoms are
+  // identified by their id in clause_exchange_, which is mapped to the
+  // variables of this solver.
+  ClauseExchange* clause_exchange_{nullptr};
+  int clause_exchange_worker_{0};
+  uint64_t clause_exchange_cursor_{0};
+  std::unordered_map<Variable::Id, int> to_shared_atom_;
+  std::unordered_map<int, Variable> from_shared_atom_;
+
+#if HAVE_CADICAL
+  // Stops the search of CaDiCaL once the cancel flag is raised.
+  struct CancelTerminator : public CaDiCaL::Terminator {
+    explicit CancelTerminator(const std::atomic<bool>* flag) : cancelled{flag} {}
+    bool terminate() override { return *cancelled; }
+    const std::atomic<bool>* cancelled;
+  };
+  std::unique_ptr<CancelTerminator> cadical_terminator_;
+#endif
+
+  // Sizes of the LP and of main_clauses_ at each Push().
+  struct Scope {
+    int rows;
+    int cols;
+    size_t main_clauses;
+  };
+  std::vector<Scope> scopes_;
+
   /// @note We found an issue when picosat_deref_partial is used with
   /// picosat_pop. When this variable is true, we use `picosat_deref`
   /// instead.
@@ -0,0 +1,281 @@
+#include "dreal/solver/soplex_theory_propagator.h"
+
+#include <atomic>
+#include <iostream>
+#include <unordered_set>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "dreal/solver/context.h"
+#include "dreal/util/assert.h"
+#include "dreal/util/logging.h"
+#include "dreal/util/stat.h"
+#include "dreal/util/timer.h"
+
+namespace dreal {
+
+using std::cout;
+using std::pair;
+using std::unordered_set;
+using std::vector;
+
+namespace {
+class SoplexTheoryPropagatorStat : public Stat {
+ public:
+  explicit SoplexTheoryPropagatorStat(const bool enabled) : Stat{enabled} {};
+  SoplexTheoryPropagatorStat(const SoplexTheoryPropagatorStat&) = default;
+  SoplexTheoryPropagatorStat(SoplexTheoryPropagatorStat&&) = default;
+  SoplexTheoryPropagatorStat& operator=(const SoplexTheoryPropagatorStat&) =
+      delete;
+  SoplexTheoryPropagatorStat& operator=(SoplexTheoryPropagatorStat&&) = delete;
+  ~SoplexTheoryPropagatorStat() override {
+    if (enabled()) {
+      using fmt::print;
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of partial checks", "Theory propagator",
+            num_partial_checks_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of partial conflicts", "Theory propagator",
+            num_partial_conflicts_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of model checks", "Theory propagator",
+            num_model_checks_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of model conflicts", "Theory propagator",
+            num_model_conflicts_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of propagated literals", "Theory propagator",
+            num_propagations_);
+      print(cout, "{:<45} @ {:<20} = {:>15f} sec\n",
+            "Total time spent in theory checks", "Theory propagator",
+            timer_check_.seconds());
+    }
+  }
+
+  void increase_num_partial_checks() { increase(&num_partial_checks_); }
+  void increase_num_partial_conflicts() {
+    increase(&num_partial_conflicts_);
+  }
+  void increase_num_model_checks() { increase(&num_model_checks_); }
+  void increase_num_model_conflicts() { increase(&num_model_conflicts_); }
+  void add_propagations(const int propagations) {
+    if (enabled()) {
+      num_propagations_ += propagations;
+    }
+  }
+
+  ConcurrentTimer timer_check_;
+
+ private:
+  std::atomic<int> num_partial_checks_{0};
+  std::atomic<int> num_partial_conflicts_{0};
+  std::atomic<int> num_model_checks_{0};
+  std::atomic<int> num_model_conflicts_{0};
+  std::atomic<int> num_propagations_{0};
+};
+
+SoplexTheoryPropagatorStat& propagator_stat(const Config& config) {
+  static SoplexTheoryPropagatorStat stat{DREAL_LOG_INFO_ENABLED ||
+                                         config.with_timings()};
+  return stat;
+}
+}  // namespace
+
+SoplexTheoryPropagator::SoplexTheoryPropagator(
+    const Config& config, SoplexSatSolver* const sat_solver,
+    SoplexTheorySolver* const theory_solver)
+    : config_{config}, sat_solver_{sat_solver}, theory_solver_{theory_solver} {
+  DREAL_ASSERT(sat_solver_ != nullptr);
+  DREAL_ASSERT(theory_solver_ != nullptr);
+}
+
+void SoplexTheoryPropagator::Reset(const Box& box) {
+  box_ = box;
+  trail_.clear();
+  level_start_.clear();
+  checked_size_ = 0;
+  clause_.clear();
+  clause_pos_ = 0;
+  has_clause_ = false;
+  propagated_size_ = nullopt;
+  propagations_.clear();
+  propagation_pos_ = 0;
+  reasons_.clear();
+  reason_pos_ = 0;
+}
+
+void SoplexTheoryPropagator::notify_assignment(const vector<int>& lits) {
+  for (const int lit : lits) {
+    const optional<Literal> literal{sat_solver_->GetTheoryLiteral(lit)};
+    if (literal) {
+      trail_.push_back(*literal);
+    }
+  }
+}
+
+void SoplexTheoryPropagator::notify_new_decision_level() {
+  level_start_.push_back(trail_.size());
+}
+
+void SoplexTheoryPropagator::notify_backtrack(const size_t new_level) {
+  // Literals fixed at a level above new_level are dropped as well. This only
+  // makes the partial checks weaker, since complete models are checked in
+  // cb_check_found_model().
+  if (new_level < level_start_.size()) {
+    trail_.resize(level_start_[new_level]);
+    level_start_.resize(new_level);
+  }
+  if (checked_size_ > trail_.size()) {
+    checked_size_ = trail_.size();
+  }
+  if (propagated_size_ && *propagated_size_ > trail_.size()) {
+    propagated_size_ = trail_.size();
+  }
+  // The literals still waiting were found from bounds which may be gone.
+  propagations_.clear();
+  propagation_pos_ = 0;
+}
+
+bool SoplexTheoryPropagator::cb_check_found_model(const vector<int>& model) {
+  vector<Literal> literals;
+  for (const int lit : model) {
+    const optional<Literal> literal{sat_solver_->GetTheoryLiteral(lit)};
+    if (literal) {
+      literals.push_back(*literal);
+    }
+  }
+  auto& s = propagator_stat(config_);
+  s.increase_num_model_checks();
+  if (CheckTheory(literals)) {
+    return true;
+  }
+  s.increase_num_model_conflicts();
+  // Keep the clause, so that the same model is not found again.
+  clause_is_forgettable_ = false;
+  return false;
+}
+
+bool SoplexTheoryPropagator::cb_has_external_clause(bool& is_forgettable) {
+  if (!has_clause_) {
+    const int period{config_.online_check_period()};
+    if (period <= 0 || trail_.size() == checked_size_ ||
+        level_start_.size() % period != 0) {
+      return false;
+    }
+    checked_size_ = trail_.size();
+    auto& s = propagator_stat(config_);
+    s.increase_num_partial_checks();
+    ++num_partial_checks_;
+    if (CheckTheory(trail_)) {
+      return false;
+    }
+    s.increase_num_partial_conflicts();
+    // The clause is implied by the theory, so CaDiCaL may drop it later.
+    clause_is_forgettable_ = true;
+  }
+  is_forgettable = clause_is_forgettable_;
+  return true;
+}
+
+int SoplexTheoryPropagator::cb_add_external_clause_lit() {
+  DREAL_ASSERT(has_clause_);
+  if (clause_pos_ < clause_.size()) {
+    return clause_[clause_pos_++];
+  }
+  // End of clause.
+  clause_.clear();
+  clause_pos_ = 0;
+  has_clause_ = false;
+  return 0;
+}
+
+int SoplexTheoryPropagator::cb_propagate() {
+  if (propagation_pos_ == propagations_.size()) {
+    propagations_.clear();
+    propagation_pos_ = 0;
+    const int period{config_.online_check_period()};
+    if (period <= 0 ||
+        (propagated_size_ && trail_.size() == *propagated_size_) ||
+        level_start_.size() % period != 0) {
+      return 0;
+    }
+    propagated_size_ = trail_.size();
+    Propagate();
+  }
+  if (propagation_pos_ < propagations_.size()) {
+    return propagations_[propagation_pos_++];
+  }
+  return 0;
+}
+
+int SoplexTheoryPropagator::cb_add_reason_clause_lit(
+    const int propagated_lit) {
+  const auto it = reasons_.find(propagated_lit);
+  DREAL_ASSERT(it != reasons_.end());
+  const vector<int>& reason{it->second};
+  if (reason_pos_ < reason.size()) {
+    return reason[reason_pos_++];
+  }
+  // End of clause.
+  reason_pos_ = 0;
+  return 0;
+}
+
+void SoplexTheoryPropagator::Propagate() {
+  SoplexTheoryPropagatorStat& stat{propagator_stat(config_)};
+  ConcurrentTimerGuard check_timer_guard(&stat.timer_check_, stat.enabled());
+  sat_solver_->EnableTheoryLiterals(box_, trail_);
+  unordered_set<Variable::Id> assigned;
+  for (const Literal& literal : trail_) {
+    assigned.insert(literal.first.get_id());
+  }
+  for (const pair<Literal, vector<Literal>>& p :
+       sat_solver_->GetImpliedLiterals()) {
+    if (assigned.count(p.first.first.get_id()) > 0) {
+      continue;
+    }
+    const int lit{sat_solver_->GetSatLiteral(p.first)};
+    vector<int>& reason{reasons_[lit]};
+    reason.clear();
+    reason.push_back(lit);
+    for (const Literal& literal : p.second) {
+      reason.push_back(-sat_solver_->GetSatLiteral(literal));
+    }
+    propagations_.push_back(lit);
+  }
+  DREAL_LOG_DEBUG("SoplexTheoryPropagator::Propagate: {} literals implied",
+                  propagations_.size());
+  num_propagations_ += static_cast<int>(propagations_.size());
+  stat.add_propagations(static_cast<int>(propagations_.size()));
+}
+
+bool SoplexTheoryPropagator::CheckTheory(const vector<Literal>& literals) {
+  DREAL_LOG_DEBUG("SoplexTheoryPropagator::CheckTheory(#literals = {})",
+                  literals.size());
+  SoplexTheoryPropagatorStat& stat{propagator_stat(config_)};
+  ConcurrentTimerGuard check_timer_guard(&stat.timer_check_, stat.enabled());
+  sat_solver_->EnableTheoryLiterals(box_, literals);
+  const int theory_result{theory_solver_->CheckSat(
+      box_, literals, sat_solver_->GetLinearSolverPtr(),
+      sat_solver_->GetLowerBounds(), sat_solver_->GetUpperBounds(),
+      sat_solver_->GetLinearRowMap(), sat_solver_->GetLowerBoundLiterals(),
+      sat_solver_->GetUpperBoundLiterals(), sat_solver_->GetLinearVarMap())};
+  if (theory_result != SAT_UNSATISFIABLE) {
+    // delta-SAT, or unsolved. In both cases, the lazy loop in
+    // Context::SoplexImpl::CheckSatCore() has the final word on the model.
+    return true;
+  }
+  const LiteralSet& explanation{theory_solver_->GetExplanation()};
+  DREAL_LOG_DEBUG("SoplexTheoryPropagator::CheckTheory: conflict of size {}",
+                  explanation.size());
+  clause_.clear();
+  for (const Literal& literal : explanation) {
+    clause_.push_back(-sat_solver_->GetSatLiteral(literal));
+  }
+  clause_pos_ = 0;
+  has_clause_ = true;
+  return false;
+}
+
+}  // namespace dreal
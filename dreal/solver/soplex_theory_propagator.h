@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "dreal/solver/config.h"
+#include "dreal/solver/soplex_sat_solver.h"
+#include "dreal/solver/soplex_theory_solver.h"
+#include "dreal/util/box.h"
+#include "dreal/util/literal.h"
+#include "dreal/util/optional.h"
+#include "dreal/cadical.h"
+
+namespace dreal {
+
+/// Runs the SoPlex theory solver from within the search of CaDiCaL, through
+/// its IPASIR-UP interface.
+///
+/// The theory atoms assigned by CaDiCaL are tracked on a trail which follows
+/// its decision levels. Every Config::online_check_period() decision levels,
+/// the partial assignment is checked by the LP solver once propagation
+/// reaches a fixpoint; complete models are always checked. When the LP is
+/// infeasible, the explanation of the theory solver is handed back to
+/// CaDiCaL as a clause, so that it backjumps right away.
+///
+/// At the same decision levels, the atoms of the LP rows which are decided
+/// by the bounds on the trail alone are propagated, e.g. ¬(x + y ≤ 1) from
+/// x ≥ 2 and y ≥ 0. Implications between bounds on the same variable are
+/// not propagated from here: the binary clauses added by
+/// SoplexSatSolver::AddFormula already let CaDiCaL derive them.
+class SoplexTheoryPropagator : public CaDiCaL::ExternalPropagator {
+ public:
+  SoplexTheoryPropagator(const Config& config, SoplexSatSolver* sat_solver,
+                         SoplexTheorySolver* theory_solver);
+
+  /// Deleted copy constructor.
+  SoplexTheoryPropagator(const SoplexTheoryPropagator&) = delete;
+
+  /// Deleted move constructor.
+  SoplexTheoryPropagator(SoplexTheoryPropagator&&) = delete;
+
+  /// Deleted copy-assignment operator.
+  SoplexTheoryPropagator& operator=(const SoplexTheoryPropagator&) = delete;
+
+  /// Deleted move-assignment operator.
+  SoplexTheoryPropagator& operator=(SoplexTheoryPropagator&&) = delete;
+
+  ~SoplexTheoryPropagator() override = default;
+
+  /// Prepares for a new call to the SAT solver, where the theory checks use
+  /// @p box for the bounds on the numerical variables.
+  void Reset(const Box& box);
+
+  /// @name CaDiCaL::ExternalPropagator interface.
+  /// @{
+  void notify_assignment(const std::vector<int>& lits) override;
+  void notify_new_decision_level() override;
+  void notify_backtrack(size_t new_level) override;
+  bool cb_check_found_model(const std::vector<int>& model) override;
+  bool cb_has_external_clause(bool& is_forgettable) override;
+  int cb_add_external_clause_lit() override;
+  int cb_propagate() override;
+  int cb_add_reason_clause_lit(int propagated_lit) override;
+  /// @}
+
+  /// Returns the number of partial assignments checked so far.
+  int num_partial_checks() const { return num_partial_checks_; }
+
+  /// Returns the number of theory literals propagated so far.
+  int num_propagations() const { return num_propagations_; }
+
+ private:
+  // Checks the theory literals in @p literals with the LP solver. If they
+  // are infeasible, stores the negation of the explanation in clause_ and
+  // returns false.
+  bool CheckTheory(const std::vector<Literal>& literals);
+
+  // Finds the unassigned theory literals implied by the bounds on the trail,
+  // and stores them in propagations_, with their reasons in reasons_.
+  void Propagate();
+
+  const Config& config_;
+  SoplexSatSolver* const sat_solver_;
+  SoplexTheorySolver* const theory_solver_;
+  Box box_;
+
+  // Theory literals assigned by CaDiCaL, in assignment order, and the size
+  // of trail_ at the start of each decision level.
+  std::vector<Literal> trail_;
+  std::vector<size_t> level_start_;
+  // Size of trail_ at the last partial check.
+  size_t checked_size_{0};
+
+  // The clause waiting to be added to CaDiCaL, and the position of the next
+  // literal to hand out.
+  std::vector<int> clause_;
+  size_t clause_pos_{0};
+  bool has_clause_{false};
+  bool clause_is_forgettable_{false};
+
+  // Size of trail_ at the last propagation (nullopt before the first one, so
+  // that the atoms decided by the box alone are propagated too), the literals
+  // found by it which are waiting to be handed out, and the position of the
+  // next one.
+  optional<size_t> propagated_size_;
+  std::vector<int> propagations_;
+  size_t propagation_pos_{0};
+  // The reason clause of each propagated literal, which starts with the
+  // literal itself, and the position of the next literal to hand out.
+  std::unordered_map<int, std::vector<int>> reasons_;
+  size_t reason_pos_{0};
+
+  int num_partial_checks_{0};
+  int num_propagations_{0};
+};
+
+}  // namespace dreal
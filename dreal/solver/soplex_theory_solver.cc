@@ -2,6 +2,7 @@
 
 #include <atomic>
 #include <iostream>
+#include <tuple>
 
 #include "dreal/util/assert.h"
 #include "dreal/util/exception.h"
@@ -24,7 +25,6 @@ using soplex::LPColRational;
 using soplex::Rational;
 
 using dreal::gmp::to_mpq_t;
-using dreal::gmp::to_mpq_class;
 
 SoplexTheorySolver::SoplexTheorySolver(const Config& config)
     : config_{config} {
@@ -46,15 +46,61 @@ class TheorySolverStat : public Stat {
       print(cout, "{:<45} @ {:<20} = {:>15f} sec\n",
             "Total time spent in CheckSat", "Theory level",
             timer_check_sat_.seconds());
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of simplex iterations", "Theory level",
+            num_simplex_iterations_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of simplex cold restarts", "Theory level",
+            num_cold_restarts_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of floating-point bases repaired", "Theory level",
+            num_basis_repairs_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of explanations",
+            "Theory level", num_explanations_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of literals in conflicting models", "Theory level",
+            num_model_literals_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n",
+            "Total # of literals in explanations", "Theory level",
+            num_explanation_literals_);
     }
   }
 
   void increase_num_check_sat() { increase(&num_check_sat_); }
 
-  Timer timer_check_sat_;
+  void add_simplex_iterations(const int iterations) {
+    if (enabled()) {
+      num_simplex_iterations_ += iterations;
+    }
+  }
+
+  void increase_num_cold_restarts() { increase(&num_cold_restarts_); }
+
+  void add_basis_repairs(const int repairs) {
+    if (enabled()) {
+      num_basis_repairs_ += repairs;
+    }
+  }
+
+  void add_explanation(const size_t explanation_size,
+                       const size_t model_size) {
+    if (enabled()) {
+      increase(&num_explanations_);
+      num_explanation_literals_ += explanation_size;
+      num_model_literals_ += model_size;
+    }
+  }
+
+  ConcurrentTimer timer_check_sat_;
 
  private:
   std::atomic<int> num_check_sat_{0};
+  std::atomic<long> num_simplex_iterations_{0};
+  std::atomic<int> num_cold_restarts_{0};
+  std::atomic<int> num_basis_repairs_{0};
+  std::atomic<int> num_explanations_{0};
+  std::atomic<size_t> num_explanation_literals_{0};
+  std::atomic<size_t> num_model_literals_{0};
 };
 
 }  // namespace
@@ -64,12 +110,15 @@ int SoplexTheorySolver::CheckSat(const Box& box,
                                  SoPlex* prob,
                                  const VectorRational& lower,
                                  const VectorRational& upper,
+                                 const vector<Literal>& row_map,
+                                 const vector<optional<Literal>>& lower_lits,
+                                 const vector<optional<Literal>>& upper_lits,
                                  const std::map<int, Variable>& var_map) {
   DREAL_ASSERT(prob != nullptr);
-  static TheorySolverStat stat{DREAL_LOG_INFO_ENABLED};
+  static TheorySolverStat stat{DREAL_LOG_INFO_ENABLED || config_.with_timings()};
   stat.increase_num_check_sat();
-  TimerGuard check_sat_timer_guard(&stat.timer_check_sat_, stat.enabled(),
-                                   true /* start_timer */);
+  ConcurrentTimerGuard check_sat_timer_guard(&stat.timer_check_sat_,
+                                             stat.enabled());
 
   DREAL_LOG_TRACE("SoplexTheorySolver::CheckSat: Box = \n{}", box);
 
@@ -82,7 +131,8 @@ int SoplexTheorySolver::CheckSat(const Box& box,
   int colcount = prob->numColsRational();
   VectorRational x;
 
-  model_ = box;
+  // Only the intervals which changed since the last call are copied.
+  model_.InplaceAssign(box);
   for (const pair<int, Variable>& kv : var_map) {
     if (!model_.has_variable(kv.second)) {
       // Variable should already be present
@@ -102,9 +152,21 @@ int SoplexTheorySolver::CheckSat(const Box& box,
       DREAL_LOG_DEBUG("SoplexTheorySolver::CheckSat: variable {} has invalid bounds [{}, {}]",
                       kv.second, lb, ub);
       sat_status = SAT_UNSATISFIABLE;
-      // Prevent the exact same LP from coming up again
       explanation_.clear();
-      explanation_.insert(assertions.begin(), assertions.end());
+      if (config_.lp_explanation() != Config::LPExplanation::Assertions) {
+        // Only the literals which set the two bounds are responsible.
+        if (lower_lits[kv.first]) {
+          explanation_.insert(*lower_lits[kv.first]);
+        }
+        if (upper_lits[kv.first]) {
+          explanation_.insert(*upper_lits[kv.first]);
+        }
+      }
+      if (explanation_.empty()) {
+        // Prevent the exact same LP from coming up again
+        explanation_.insert(assertions.begin(), assertions.end());
+      }
+      stat.add_explanation(explanation_.size(), assertions.size());
       break;
     }
     if (rowcount == 0) {
@@ -126,22 +188,55 @@ int SoplexTheorySolver::CheckSat(const Box& box,
     return sat_status;
   }
 
-  prob->changeLowerRational(lower);
-  prob->changeUpperRational(upper);
+  const bool warm_start{config_.simplex_warm_start()};
+  if (warm_start) {
+    // Only touch the bounds which changed, so that the basis can be reused.
+    for (int i = 0; i < colcount; ++i) {
+      if (prob->lowerRational(i) != lower[i]) {
+        prob->changeLowerRational(i, lower[i]);
+      }
+      if (prob->upperRational(i) != upper[i]) {
+        prob->changeUpperRational(i, upper[i]);
+      }
+    }
+  } else {
+    prob->changeLowerRational(lower);
+    prob->changeUpperRational(upper);
+  }
 
   // Now we call the solver
   sat_status = SAT_UNSOLVED;
   DREAL_LOG_DEBUG("SoplexTheorySolver::CheckSat: calling SoPlex (phase {})",
                   1 == config_.simplex_sat_phase() ? "one" : "two");
 
+  auto is_expected_status = [this](const SPxSolver::Status s) {
+    if (2 == config_.simplex_sat_phase()) {
+      return s == SPxSolver::Status::OPTIMAL;
+    }
+    return s == SPxSolver::Status::OPTIMAL ||
+           s == SPxSolver::Status::UNBOUNDED ||
+           s == SPxSolver::Status::INFEASIBLE;
+  };
+
   mpq_class actual_precision{precision_};
-  status = prob->optimize();
+  int iterations{0};
+  const int num_basis_repairs{num_basis_repairs_};
+  status = Optimize(prob, &iterations);
+  if (warm_start && !is_expected_status(status)) {
+    // The old basis got SoPlex into trouble; solve again from scratch.
+    DREAL_LOG_DEBUG("SoplexTheorySolver::CheckSat: SoPlex returned {} from a warm start, "
+                    "retrying from a cold start", status);
+    stat.increase_num_cold_restarts();
+    ++num_cold_restarts_;
+    prob->clearBasis();
+    status = Optimize(prob, &iterations);
+  }
+  stat.add_simplex_iterations(iterations);
+  num_simplex_iterations_ += iterations;
+  stat.add_basis_repairs(num_basis_repairs_ - num_basis_repairs);
   actual_precision = 0;  // Because we always solve exactly, at present
 
-  if ((2 == config_.simplex_sat_phase() && status != SPxSolver::Status::OPTIMAL) ||
-      (status != SPxSolver::Status::OPTIMAL &&
-       status != SPxSolver::Status::UNBOUNDED &&
-       status != SPxSolver::Status::INFEASIBLE)) {
+  if (!is_expected_status(status)) {
     throw DREAL_RUNTIME_ERROR("SoPlex returned {}", status);
   } else {
     DREAL_LOG_DEBUG("SoplexTheorySolver::CheckSat: SoPlex has returned with precision = {}",
@@ -201,15 +296,30 @@ int SoplexTheorySolver::CheckSat(const Box& box,
     if (haveSoln) {
     // Copy delta-feasible point from x into model_
       for (const pair<int, Variable>& kv : var_map) {
-        DREAL_ASSERT(model_[kv.second].lb() <= to_mpq_class(x[kv.first].getMpqRef()) &&
-                     to_mpq_class(x[kv.first].getMpqRef()) <= model_[kv.second].ub());
-        model_[kv.second] = x[kv.first].getMpqRef();
+        Box::Interval& iv{model_[kv.second]};
+        DREAL_ASSERT(mpq_cmp(iv.lb().get_mpq_t(), x[kv.first].getMpqRef()) <= 0 &&
+                     mpq_cmp(x[kv.first].getMpqRef(), iv.ub().get_mpq_t()) <= 0);
+        iv = x[kv.first].getMpqRef();
       }
     } else {
       throw DREAL_RUNTIME_ERROR("delta-sat but no solution available");
     }
     break;
   case SAT_UNSATISFIABLE:
+    explanation_.clear();
+    if (config_.lp_explanation() != Config::LPExplanation::Assertions &&
+        SetFarkasExplanation(prob, row_map, lower_lits, upper_lits, var_map) &&
+        config_.lp_explanation() == Config::LPExplanation::Minimal) {
+      MinimizeExplanation(box, prob, row_map, lower_lits, upper_lits, var_map);
+    }
+    if (explanation_.empty()) {
+      // Prevent the exact same LP from coming up again
+      explanation_.insert(assertions.begin(), assertions.end());
+    }
+    DREAL_LOG_DEBUG("SoplexTheorySolver::CheckSat: explanation has {} of {} literals",
+                    explanation_.size(), assertions.size());
+    stat.add_explanation(explanation_.size(), assertions.size());
+    break;
   case SAT_UNSOLVED:
     // Prevent the exact same LP from coming up again
     explanation_.clear();
@@ -222,6 +332,191 @@ int SoplexTheorySolver::CheckSat(const Box& box,
   return sat_status;
 }
 
+bool SoplexTheorySolver::SetFarkasExplanation(
+    SoPlex* prob, const vector<Literal>& row_map,
+    const vector<optional<Literal>>& lower_lits,
+    const vector<optional<Literal>>& upper_lits,
+    const std::map<int, Variable>& var_map) {
+  const int rowcount = prob->numRowsRational();
+  const int colcount = prob->numColsRational();
+  DREAL_ASSERT(static_cast<size_t>(rowcount) == row_map.size());
+  // In phase one, SoPlex proves infeasibility with a dual Farkas ray. In phase
+  // two, the LP is always feasible, and the optimal dual solution certifies
+  // that the sum of the artificial variables can't be brought down to zero.
+  // In both cases, rows with a zero multiplier can be dropped, and so can the
+  // bounds of columns with a zero (Farkas) reduced cost.
+  VectorRational y;
+  y.reDim(rowcount);
+  const bool have_ray{1 == config_.simplex_sat_phase()
+                          ? prob->getDualFarkasRational(y)
+                          : prob->getDualRational(y)};
+  if (!have_ray) {
+    DREAL_LOG_DEBUG("SoplexTheorySolver::SetFarkasExplanation: no certificate available");
+    return false;
+  }
+  VectorRational red_cost;
+  red_cost.reDim(colcount);
+  explanation_.clear();
+  for (int i = 0; i < rowcount; ++i) {
+    if (y[i] == 0) {
+      continue;
+    }
+    explanation_.insert(row_map[i]);
+    const soplex::SVectorRational& row{prob->rowVectorRational(i)};
+    for (int k = 0; k < row.size(); ++k) {
+      red_cost[row.index(k)] += y[i] * row.value(k);
+    }
+  }
+  for (const pair<int, Variable>& kv : var_map) {
+    if (red_cost[kv.first] == 0) {
+      continue;
+    }
+    if (lower_lits[kv.first]) {
+      explanation_.insert(*lower_lits[kv.first]);
+    }
+    if (upper_lits[kv.first]) {
+      explanation_.insert(*upper_lits[kv.first]);
+    }
+  }
+  return true;
+}
+
+SPxSolver::Status SoplexTheorySolver::Optimize(SoPlex* prob,
+                                               int* const iterations) {
+  // Most LPs are clearly feasible or clearly infeasible, and a floating-point
+  // simplex finds the right basis for them at a fraction of the cost of an
+  // exact one. It works with the floating-point tolerances, since it would
+  // not terminate reliably with the zero tolerances of the exact solve.
+  prob->setIntParam(prob->SOLVEMODE, prob->SOLVEMODE_REAL);
+  prob->setRealParam(prob->FEASTOL, prob->realParam(prob->FPFEASTOL));
+  prob->setRealParam(prob->OPTTOL, prob->realParam(prob->FPOPTTOL));
+  const SPxSolver::Status real_status{prob->optimize()};
+  *iterations += prob->numIterations();
+
+  // The exact solve starts from the final floating-point basis. As RATFAC is
+  // set, SoPlex factorizes that basis in rational arithmetic first, which
+  // certifies the answer when the basis is right. It only pivots further when
+  // it is not. The status, the solution and the certificates are all those
+  // of the exact solve, so the result is as exact as before.
+  prob->setIntParam(prob->SOLVEMODE, prob->SOLVEMODE_RATIONAL);
+  prob->setRealParam(prob->FEASTOL, 0);
+  prob->setRealParam(prob->OPTTOL, 0);
+  const SPxSolver::Status status{prob->optimize()};
+  *iterations += prob->numIterations();
+  if (prob->numIterations() > 0) {
+    DREAL_LOG_DEBUG("SoplexTheorySolver::Optimize: the floating-point basis "
+                    "({}) needed {} more pivots",
+                    real_status, prob->numIterations());
+    ++num_basis_repairs_;
+  }
+  return status;
+}
+
+bool SoplexTheorySolver::IsInfeasible(SoPlex* prob) {
+  int iterations{0};
+  const SPxSolver::Status status{Optimize(prob, &iterations)};
+  if (1 == config_.simplex_sat_phase()) {
+    return status == SPxSolver::Status::INFEASIBLE;
+  }
+  return status == SPxSolver::Status::OPTIMAL && prob->objValueRational() > 0;
+}
+
+void SoplexTheorySolver::MinimizeExplanation(
+    const Box& box, SoPlex* prob, const vector<Literal>& row_map,
+    const vector<optional<Literal>>& lower_lits,
+    const vector<optional<Literal>>& upper_lits,
+    const std::map<int, Variable>& var_map) {
+  const Rational ninfty{-soplex::infinity};
+  const Rational infty{soplex::infinity};
+  auto box_lb = [&box, &ninfty](const Variable& var) {
+    return box.has_variable(var) ? Rational(to_mpq_t(box[var].lb())) : ninfty;
+  };
+  auto box_ub = [&box, &infty](const Variable& var) {
+    return box.has_variable(var) ? Rational(to_mpq_t(box[var].ub())) : infty;
+  };
+  auto in_explanation = [this](const optional<Literal>& lit) {
+    return lit && explanation_.count(*lit) > 0;
+  };
+
+  // Relax everything which is not part of the explanation, so that each
+  // deletion test below only depends on the remaining literals. The rows are
+  // restored at the end, since the SAT solver keeps track of which rows are
+  // enabled.
+  const int rowcount = prob->numRowsRational();
+  vector<pair<Rational, Rational>> ranges;
+  ranges.reserve(rowcount);
+  for (int i = 0; i < rowcount; ++i) {
+    ranges.emplace_back(prob->lhsRational(i), prob->rhsRational(i));
+  }
+  for (int i = 0; i < rowcount; ++i) {
+    if (explanation_.count(row_map[i]) == 0) {
+      prob->changeRangeRational(i, ninfty, infty);
+    }
+  }
+  for (const pair<int, Variable>& kv : var_map) {
+    if (lower_lits[kv.first] && !in_explanation(lower_lits[kv.first])) {
+      prob->changeLowerRational(kv.first, box_lb(kv.second));
+    }
+    if (upper_lits[kv.first] && !in_explanation(upper_lits[kv.first])) {
+      prob->changeUpperRational(kv.first, box_ub(kv.second));
+    }
+  }
+
+  const LiteralComparator less;
+  auto same = [&less](const Literal& a, const Literal& b) {
+    return !less(a, b) && !less(b, a);
+  };
+  const vector<Literal> candidates{explanation_.begin(), explanation_.end()};
+  for (const Literal& lit : candidates) {
+    // Relax every row and bound set by `lit`, remembering the old values.
+    vector<std::tuple<int, Rational, Rational>> rows;
+    vector<std::tuple<int, Rational, Rational>> cols;
+    for (int i = 0; i < rowcount; ++i) {
+      if (same(row_map[i], lit)) {
+        rows.emplace_back(i, prob->lhsRational(i), prob->rhsRational(i));
+        prob->changeRangeRational(i, ninfty, infty);
+      }
+    }
+    for (const pair<int, Variable>& kv : var_map) {
+      const optional<Literal>& lower_lit{lower_lits[kv.first]};
+      const optional<Literal>& upper_lit{upper_lits[kv.first]};
+      const bool relax_lower{lower_lit && same(*lower_lit, lit)};
+      const bool relax_upper{upper_lit && same(*upper_lit, lit)};
+      if (relax_lower || relax_upper) {
+        cols.emplace_back(kv.first, prob->lowerRational(kv.first),
+                          prob->upperRational(kv.first));
+        if (relax_lower) {
+          prob->changeLowerRational(kv.first, box_lb(kv.second));
+        }
+        if (relax_upper) {
+          prob->changeUpperRational(kv.first, box_ub(kv.second));
+        }
+      }
+    }
+    if (IsInfeasible(prob)) {
+      DREAL_LOG_TRACE("SoplexTheorySolver::MinimizeExplanation: drop {}{}",
+                      lit.second ? "" : "¬", lit.first);
+      explanation_.erase(lit);
+    } else {
+      for (const auto& row : rows) {
+        prob->changeRangeRational(std::get<0>(row), std::get<1>(row),
+                                  std::get<2>(row));
+      }
+      for (const auto& col : cols) {
+        prob->changeBoundsRational(std::get<0>(col), std::get<1>(col),
+                                   std::get<2>(col));
+      }
+    }
+  }
+
+  for (int i = 0; i < rowcount; ++i) {
+    if (prob->lhsRational(i) != ranges[i].first ||
+        prob->rhsRational(i) != ranges[i].second) {
+      prob->changeRangeRational(i, ranges[i].first, ranges[i].second);
+    }
+  }
+}
+
 const Box& SoplexTheorySolver::GetModel() const {
   DREAL_LOG_DEBUG("SoplexTheorySolver::GetModel():\n{}", model_);
   return model_;
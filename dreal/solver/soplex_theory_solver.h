@@ -10,6 +10,7 @@
 #include "dreal/symbolic/symbolic.h"
 #include "dreal/util/box.h"
 #include "dreal/util/literal.h"
+#include "dreal/util/optional.h"
 #include "dreal/gmp.h"
 #include "dreal/soplex.h"
 
@@ -23,10 +24,17 @@ class SoplexTheorySolver {
 
   /// Checks consistency. Returns true if there is a satisfying
   /// assignment. Otherwise, return false.
+  ///
+  /// @p row_map gives the literal of each LP row, and @p lower_lits and
+  /// @p upper_lits give the literal responsible for each column bound. They
+  /// are used to build small explanations when the LP is infeasible.
   int CheckSat(const Box& box, const std::vector<Literal>& assertions,
                soplex::SoPlex* prob,
                const soplex::VectorRational& lower,
                const soplex::VectorRational& upper,
+               const std::vector<Literal>& row_map,
+               const std::vector<optional<Literal>>& lower_lits,
+               const std::vector<optional<Literal>>& upper_lits,
                const std::map<int, Variable>& var_map);
 
   /// Gets a satisfying Model.
@@ -35,11 +43,50 @@ class SoplexTheorySolver {
   /// Gets a list of used constraints.
   const LiteralSet& GetExplanation() const;
 
+  /// Returns the number of simplex iterations made by CheckSat() so far.
+  long num_simplex_iterations() const { return num_simplex_iterations_; }
+
+  /// Returns the number of times CheckSat() has given up a warm start and
+  /// solved again from scratch.
+  int num_cold_restarts() const { return num_cold_restarts_; }
+
+  /// Returns the number of times the exact solve of CheckSat() has had to
+  /// pivot away from the basis found in floating point.
+  int num_basis_repairs() const { return num_basis_repairs_; }
+
  private:
+  // Sets explanation_ to the literals whose rows or bounds have a nonzero
+  // multiplier in the certificate of infeasibility of @p prob. Returns false
+  // if SoPlex does not provide a certificate.
+  bool SetFarkasExplanation(soplex::SoPlex* prob,
+                            const std::vector<Literal>& row_map,
+                            const std::vector<optional<Literal>>& lower_lits,
+                            const std::vector<optional<Literal>>& upper_lits,
+                            const std::map<int, Variable>& var_map);
+
+  // Shrinks explanation_ by deletion: every literal is relaxed in turn, and
+  // dropped for good if @p prob remains infeasible without it.
+  void MinimizeExplanation(const Box& box, soplex::SoPlex* prob,
+                           const std::vector<Literal>& row_map,
+                           const std::vector<optional<Literal>>& lower_lits,
+                           const std::vector<optional<Literal>>& upper_lits,
+                           const std::map<int, Variable>& var_map);
+
+  // Solves @p prob and returns true if it is found to be infeasible.
+  bool IsInfeasible(soplex::SoPlex* prob);
+
+  // Solves @p prob in floating point, and then solves it exactly from the
+  // final basis. Returns the status of the exact solve, and adds the simplex
+  // iterations of both solves to @p iterations.
+  soplex::SPxSolver::Status Optimize(soplex::SoPlex* prob, int* iterations);
+
   const Config& config_;
   Box model_;
   LiteralSet explanation_;
   mpq_class precision_;
+  long num_simplex_iterations_{0};
+  int num_cold_restarts_{0};
+  int num_basis_repairs_{0};
 };
 
 }  // namespace dreal
@@ -1,6 +1,8 @@
 #include "dreal/solver/context.h"
 
 #include <memory>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "dreal/symbolic/symbolic.h"
@@ -28,6 +30,34 @@ class ContextTest : public ::testing::Test {
     context_->DeclareVariable(x_);
   }
 
+  // Checks a problem where each branch enables a different set of rows, so
+  // that the LP has to be updated between theory checks. The formulas added
+  // between the checks are rows as well, not bounds which would be moved
+  // into the box.
+  void CheckBranches(Context* context) const {
+    const Variable y{"y"};
+    const Variable b1{"b1", Variable::Type::BOOLEAN};
+    const Variable b2{"b2", Variable::Type::BOOLEAN};
+    context->DeclareVariable(x_);
+    context->DeclareVariable(y);
+    context->Assert(x_ + y <= 4);
+    context->Assert((x_ - y >= 3 && b1) || (x_ - y <= -3 && !b1));
+    context->Assert((x_ + 2 * y >= 5 && b2) || (2 * x_ + y >= 5 && !b2));
+    context->Assert(y >= 0);
+    mpq_class actual_precision;
+    const optional<Box> result{context->CheckSat(&actual_precision)};
+    ASSERT_TRUE(result);
+    EXPECT_TRUE(context->get_model() == *result);
+    const size_t num_assertions{context->assertions().size()};
+    context->Assert(x_ - 2 * y >= -6);
+    EXPECT_TRUE(context->CheckSat(&actual_precision));
+    // x + y >= 3 with b1, and x + y >= 7/3 with !b1, which needs b2.
+    context->Assert(x_ + y <= 2);
+    EXPECT_FALSE(context->CheckSat(&actual_precision));
+    EXPECT_TRUE(context->get_model().empty());
+    EXPECT_EQ(context->assertions().size(), num_assertions + 2);
+  }
+
   const Variable x_{"x"};
   Config config_;
   unique_ptr<Context> context_;
@@ -43,28 +73,278 @@ DREAL_TEST_F_PHASES(ContextTest, MultipleCheckSat) {
   EXPECT_TRUE(result2);
 }
 
-// QSopt_ex changes: assertions don't modify the Box any more
-#if 0
-TEST_F(ContextTest, AssertionsAndBox) {
+DREAL_TEST_F_PHASES(ContextTest, LPExplanations) {
+  const Variable y{"y"};
+  const Variable z{"z"};
+  const Variable b{"b", Variable::Type::BOOLEAN};
+  for (const Config::LPExplanation lp_explanation :
+       {Config::LPExplanation::Assertions, Config::LPExplanation::Farkas,
+        Config::LPExplanation::Minimal}) {
+    config_.mutable_lp_explanation() = lp_explanation;
+    Context context{config_};
+    context.DeclareVariable(x_);
+    context.DeclareVariable(y);
+    context.DeclareVariable(z);
+    // The rows involving z are not needed to refute either branch.
+    context.Assert(z >= 0 && z <= 10);
+    context.Assert(x_ + y <= 1);
+    context.Assert(x_ >= 0 && y >= 0);
+    context.Assert(x_ >= 2 || b);
+    context.Assert(x_ - z <= -2 || !b);
+    mpq_class actual_precision;
+    EXPECT_TRUE(context.CheckSat(&actual_precision));
+    context.Assert(y >= 2 || !b);
+    EXPECT_FALSE(context.CheckSat(&actual_precision));
+  }
+}
+
+DREAL_TEST_F_PHASES(ContextTest, SimplexWarmStart) {
+  Context::Statistics cold_start;
+  for (const bool warm_start : {false, true}) {
+    config_.mutable_simplex_warm_start() = warm_start;
+    Context context{config_};
+    CheckBranches(&context);
+    const Context::Statistics stats{context.statistics()};
+    if (!warm_start) {
+      EXPECT_EQ(stats.num_cold_restarts, 0);
+      cold_start = stats;
+    } else {
+      // Starting from the previous basis does not take more iterations
+      // than starting from scratch every time.
+      EXPECT_LE(stats.num_simplex_iterations,
+                cold_start.num_simplex_iterations);
+    }
+  }
+}
+
+DREAL_TEST_F_PHASES(ContextTest, OnlineSatSolver) {
+  config_.mutable_sat_solver() = Config::CADICAL;
+#if HAVE_CADICAL
+  if (config_.lp_solver() == Config::QSOPTEX) {
+    EXPECT_THROW(Context{config_}, std::runtime_error);
+    return;
+  }
+  for (const int period : {0, 1, 2}) {
+    config_.mutable_online_check_period() = period;
+    Context context{config_};
+    CheckBranches(&context);
+    // With a period of 0, only the complete models are checked.
+    if (period == 0) {
+      EXPECT_EQ(context.statistics().num_partial_checks, 0);
+    } else {
+      EXPECT_GT(context.statistics().num_partial_checks, 0);
+    }
+  }
+#else
+  EXPECT_THROW(Context{config_}, std::runtime_error);
+#endif
+}
+
+DREAL_TEST_F_PHASES(ContextTest, TheoryPropagation) {
+  config_.mutable_sat_solver() = Config::CADICAL;
+#if HAVE_CADICAL
+  if (config_.lp_solver() == Config::QSOPTEX) {
+    return;
+  }
+  const Variable y{"y"};
+  const Variable b{"b", Variable::Type::BOOLEAN};
+  for (const int period : {0, 1}) {
+    config_.mutable_online_check_period() = period;
+    Context context{config_};
+    context.DeclareVariable(x_);
+    context.DeclareVariable(y);
+    // x + y ≤ 1 is false within the bounds, so b has to hold.
+    context.Assert(x_ >= 2);
+    context.Assert(y >= 0);
+    context.Assert(x_ + y <= 1 || b);
+    mpq_class actual_precision;
+    EXPECT_TRUE(context.CheckSat(&actual_precision));
+    if (period == 0) {
+      EXPECT_EQ(context.statistics().num_propagations, 0);
+    } else {
+      EXPECT_GT(context.statistics().num_propagations, 0);
+    }
+  }
+#endif
+}
+
+DREAL_TEST_F_PHASES(ContextTest, PushPop) {
+  const Variable y{"y"};
+  const Variable b{"b", Variable::Type::BOOLEAN};
+  mpq_class actual_precision;
+  context_->DeclareVariable(y);
+  context_->Assert(x_ + y <= 4);
+  context_->Assert(x_ >= 0 && y >= 0);
+  EXPECT_TRUE(context_->CheckSat(&actual_precision));
+
+  context_->Push(1);
+  context_->Assert(x_ - y >= 5 || b);
+  context_->Assert(!b);
+  EXPECT_FALSE(context_->CheckSat(&actual_precision));
+  context_->Push(1);
+  context_->Assert(y >= 1);
+  EXPECT_FALSE(context_->CheckSat(&actual_precision));
+  context_->Pop(2);
+  EXPECT_TRUE(context_->CheckSat(&actual_precision));
+
+  // The atoms of the popped scope come back, this time without a conflict.
+  context_->Push(1);
+  context_->Assert(x_ - y >= 3 || b);
+  context_->Assert(!b);
+  EXPECT_TRUE(context_->CheckSat(&actual_precision));
+  context_->Pop(1);
+  context_->Assert(x_ - y >= 5);
+  EXPECT_FALSE(context_->CheckSat(&actual_precision));
+}
+
+DREAL_TEST_F_PHASES(ContextTest, CheckSatAssuming) {
+  const Variable y{"y"};
+  const Variable b{"b", Variable::Type::BOOLEAN};
+  mpq_class actual_precision;
+  context_->DeclareVariable(y);
+  context_->DeclareVariable(b);
+  context_->Assert(x_ + y <= 4);
+  context_->Assert(x_ >= 0 && y >= 0);
+  context_->Assert(imply(b, x_ >= 3));
+
+  const Formula y_ge_2{y >= 2};
+  EXPECT_FALSE(context_->CheckSatAssuming({Formula{b}, y_ge_2},
+                                          &actual_precision));
+  const std::vector<Formula>& core{context_->GetUnsatAssumptions()};
+  ASSERT_EQ(core.size(), 2);
+  EXPECT_TRUE(core[0].EqualTo(Formula{b}));
+  EXPECT_TRUE(core[1].EqualTo(y_ge_2));
+
+  // Dropping either assumption makes it SAT again, and the assumptions do
+  // not outlive the call.
+  EXPECT_TRUE(context_->CheckSatAssuming({!b, y_ge_2}, &actual_precision));
+  EXPECT_TRUE(context_->GetUnsatAssumptions().empty());
+  EXPECT_TRUE(context_->CheckSatAssuming({Formula{b}}, &actual_precision));
+  EXPECT_TRUE(context_->CheckSat(&actual_precision));
+
+  EXPECT_FALSE(context_->CheckSatAssuming({!b, y >= 5, y_ge_2 || b},
+                                          &actual_precision));
+  ASSERT_EQ(context_->GetUnsatAssumptions().size(), 1);
+  EXPECT_TRUE(context_->GetUnsatAssumptions()[0].EqualTo(y >= 5));
+
+  // A guard created within a scope goes away with it.
+  context_->Push(1);
+  EXPECT_FALSE(context_->CheckSatAssuming({x_ >= 5}, &actual_precision));
+  context_->Pop(1);
+  EXPECT_FALSE(context_->CheckSatAssuming({x_ >= 5}, &actual_precision));
+  EXPECT_TRUE(context_->CheckSatAssuming({x_ >= 4}, &actual_precision));
+}
+
+DREAL_TEST_F_PHASES(ContextTest, ObjectiveCutoff) {
+  if (config_.lp_solver() == Config::SOPLEX) {
+    EXPECT_THROW(context_->Minimize(x_), std::runtime_error);
+    return;
+  }
+  const Variable y{"y"};
+  const Variable b1{"b1", Variable::Type::BOOLEAN};
+  const Variable b2{"b2", Variable::Type::BOOLEAN};
+  for (const bool objective_cutoff : {false, true}) {
+    config_.mutable_objective_cutoff() = objective_cutoff;
+    Context context{config_};
+    context.DeclareVariable(x_);
+    context.DeclareVariable(y);
+    context.Assert(x_ + y >= 2);
+    // Four regions, of which (b1, b2) alone reaches the optimum x = -1, at
+    // y = 3. The others can't go below x = 2.
+    context.Assert((x_ - y >= -4 && b1) || (x_ >= 3 && !b1));
+    context.Assert((y <= 5 && b2) || (y >= 6 && !b2));
+    context.Minimize(x_);
+    mpq_class obj_lo, obj_up;
+    Box model;
+    ASSERT_EQ(context.CheckOpt(&obj_lo, &obj_up, &model), LP_DELTA_OPTIMAL);
+    EXPECT_LE(obj_lo, -1);
+    EXPECT_GE(obj_up, -1);
+    EXPECT_LE(obj_up - obj_lo, 2 * config_.precision());
+    EXPECT_LE(model[x_].lb(), obj_up);
+  }
+}
+
+DREAL_TEST_F_PHASES(ContextTest, Portfolio) {
+  const int jobs{4};
+  config_.mutable_number_of_jobs() = jobs;
+  // Without and with sharing of the learned clauses.
+  for (const int max_shared_clause_size : {0, 8}) {
+    config_.mutable_max_shared_clause_size() = max_shared_clause_size;
+    Context context{config_};
+    // The instances which lose a check are cancelled, and still have to
+    // answer the next ones.
+    CheckBranches(&context);
+    const int winner{context.statistics().portfolio_winner};
+    EXPECT_GE(winner, 0);
+    EXPECT_LT(winner, jobs);
+
+    // The answer of an empty box does not involve the other instances.
+    context.Assert(x_ <= -1);
+    context.Assert(x_ >= 1);
+    mpq_class actual_precision;
+    EXPECT_FALSE(context.CheckSat(&actual_precision));
+    EXPECT_EQ(context.statistics().portfolio_winner, 0);
+  }
+}
+
+DREAL_TEST_F_PHASES(ContextTest, AssertionsAndBox) {
+  const Variable y{"y"};
+  context_->DeclareVariable(y);
   const Formula f1{x_ >= 0};
   const Formula f2{x_ <= 5};
-  const Formula f3{sin(x_) == 1.0};
-  const Formula f4{cos(x_) == 0.0};
+  const Formula f3{x_ + y == 1};
+  const Formula f4{x_ - y <= 2};
   context_->Assert(f1);
   context_->Assert(f2);
   context_->Assert(f3);
   context_->Assert(f4);
 
+  // The bounds go to the box, the other atoms to the assertions.
   const auto& assertions{context_->assertions()};
-  EXPECT_EQ(assertions.size(), 2);
+  ASSERT_EQ(assertions.size(), 2);
   EXPECT_TRUE(assertions[0].EqualTo(f3));
   EXPECT_TRUE(assertions[1].EqualTo(f4));
 
   const auto& box{context_->box()};
-  EXPECT_EQ(box[x_].lb(), 0.0);
-  EXPECT_EQ(box[x_].ub(), 5.0);
+  EXPECT_EQ(box[x_].lb(), 0);
+  EXPECT_EQ(box[x_].ub(), 5);
+}
+
+DREAL_TEST_F_PHASES(ContextTest, BoundsArePopped) {
+  const Variable y{"y"};
+  mpq_class actual_precision;
+  context_->DeclareVariable(y);
+  context_->Assert(x_ >= 0);
+  context_->Assert(x_ + y >= 2);
+  const Box::Interval before{context_->box()[x_]};
+
+  context_->Push(1);
+  context_->Assert(x_ <= 1);
+  EXPECT_EQ(context_->box()[x_].ub(), 1);
+  EXPECT_TRUE(context_->CheckSat(&actual_precision));
+  context_->Assert(y <= 0);
+  EXPECT_FALSE(context_->CheckSat(&actual_precision));
+  context_->Pop(1);
+
+  EXPECT_EQ(context_->box()[x_].lb(), before.lb());
+  EXPECT_EQ(context_->box()[x_].ub(), before.ub());
+  EXPECT_EQ(context_->assertions().size(), 1);
+  context_->Assert(y <= 0);
+  EXPECT_TRUE(context_->CheckSat(&actual_precision));
+}
+
+DREAL_TEST_F_PHASES(ContextTest, ContradictoryBounds) {
+  const Variable y{"y"};
+  mpq_class actual_precision;
+  context_->DeclareVariable(y);
+  context_->Assert(x_ + y <= 4);
+  context_->Assert(x_ >= 3);
+  EXPECT_FALSE(context_->box().empty());
+  context_->Assert(x_ <= 1);
+  EXPECT_TRUE(context_->box().empty());
+  EXPECT_FALSE(context_->CheckSat(&actual_precision));
+  EXPECT_TRUE(context_->get_model().empty());
 }
-#endif
 
 }  // namespace
 }  // namespace dreal
@@ -3,11 +3,14 @@
 #include <gtest/gtest.h>
 
 #include "dreal/symbolic/symbolic.h"
+#include "dreal/symbolic/symbolic_test_util.h"
 
 namespace dreal {
 namespace {
 
 class FilterAssertionTest : public ::testing::Test {
+  DrakeSymbolicGuard guard_;
+
  protected:
   void SetUp() override { box_[z_] = Box::Interval(-100, 100); }
   const Variable z_{"z"};
@@ -20,7 +23,7 @@ TEST_F(FilterAssertionTest, FilteredWithChange1) {
   const Box old_box{box_};
   const auto result = FilterAssertion(z_ < 50, &box_);
   EXPECT_EQ(result, FilterAssertionResult::FilteredWithChange);
-  EXPECT_LT(box_[z_].ub(), 50);
+  EXPECT_EQ(box_[z_].ub(), 50);
   // No change on z.lb().
   EXPECT_EQ(box_[z_].lb(), old_box[z_].lb());
 }
@@ -50,7 +53,7 @@ TEST_F(FilterAssertionTest, FilteredWithChange4) {
   const Box old_box{box_};
   const auto result = FilterAssertion(!(z_ <= 50), &box_);
   EXPECT_EQ(result, FilterAssertionResult::FilteredWithChange);
-  EXPECT_GT(box_[z_].lb(), 50);
+  EXPECT_EQ(box_[z_].lb(), 50);
   // No change on z.ub().
   EXPECT_EQ(box_[z_].ub(), old_box[z_].ub());
 }
@@ -60,7 +63,7 @@ TEST_F(FilterAssertionTest, FilteredWithChange5) {
   const Box old_box{box_};
   const auto result = FilterAssertion(z_ > 50, &box_);
   EXPECT_EQ(result, FilterAssertionResult::FilteredWithChange);
-  EXPECT_GT(box_[z_].lb(), 50);
+  EXPECT_EQ(box_[z_].lb(), 50);
   // No change on z.ub().
   EXPECT_EQ(box_[z_].ub(), old_box[z_].ub());
 }
@@ -90,7 +93,7 @@ TEST_F(FilterAssertionTest, FilteredWithChange8) {
   const Box old_box{box_};
   const auto result = FilterAssertion(!(z_ >= 50), &box_);
   EXPECT_EQ(result, FilterAssertionResult::FilteredWithChange);
-  EXPECT_LT(box_[z_].ub(), 50);
+  EXPECT_EQ(box_[z_].ub(), 50);
   // No change on z.lb().
   EXPECT_EQ(box_[z_].lb(), old_box[z_].lb());
 }
@@ -217,5 +220,25 @@ TEST_F(FilterAssertionTest, NotFiltered) {
   EXPECT_EQ(old_box, box_);
 }
 
+TEST_F(FilterAssertionTest, ExactBounds) {
+  // The bounds are not rounded.
+  const mpq_class one_third{1, 3};
+  EXPECT_EQ(FilterAssertion(z_ <= Expression{one_third}, &box_),
+            FilterAssertionResult::FilteredWithChange);
+  EXPECT_EQ(box_[z_].ub(), one_third);
+  EXPECT_EQ(FilterAssertion(Expression{one_third} <= z_, &box_),
+            FilterAssertionResult::FilteredWithChange);
+  EXPECT_EQ(box_[z_].lb(), one_third);
+  EXPECT_FALSE(box_.empty());
+}
+
+TEST_F(FilterAssertionTest, NotInBox) {
+  // x is not a variable of the box.
+  const Box old_box{box_};
+  const auto result = FilterAssertion(x_ <= 10, &box_);
+  EXPECT_EQ(result, FilterAssertionResult::NotFiltered);
+  EXPECT_EQ(old_box, box_);
+}
+
 }  // namespace
 }  // namespace dreal
@@ -7,6 +7,7 @@
 #include <gtest/gtest.h>
 
 #include "dreal/solver/config.h"
+#include "dreal/util/clause_exchange.h"
 #include "dreal/symbolic/symbolic.h"
 #include "dreal/symbolic/symbolic_test_util.h"
 
@@ -177,5 +178,88 @@ DREAL_TEST_F_SATSOLVERS(SatSolverTest, UNSAT2) {
   EXPECT_FALSE(sat_.CheckSat(box_));
 }
 
+
+// Returns the variable of the atom @p atom in the theory model of @p model.
+template <typename SatSolver>
+Variable FindAtom(const SatSolver& sat_solver, const Model& model,
+                  const Formula& atom) {
+  for (const Literal& l : model.second) {
+    if (sat_solver.theory_literal(l.first).EqualTo(atom)) {
+      return l.first;
+    }
+  }
+  throw std::runtime_error("atom not found");
+}
+
+// Two workers of a portfolio share a clause in each of two checks, with a
+// new exchange each time. An atom of the first check and a different atom of
+// the second one are given the same id by their exchanges.
+template <typename SatSolver>
+void CheckSharingAcrossChecks(const Config& config) {
+  const Variable x{"x"};
+  const Variable y{"y"};
+  const Formula p{x - y >= 1};
+  const Formula q{x + y >= 1};
+  const Formula r{x + y <= -1};
+  const Box box{{x, y}};
+  SatSolver a{config};
+  SatSolver b{config};
+  a.AddFormula(p);
+  a.AddFormula(q || r);
+  b.AddFormula(q);
+
+  ClauseExchange first{16, 4};
+  a.SetClauseExchange(&first, 0);
+  b.SetClauseExchange(&first, 1);
+  const optional<Model> model_a{a.CheckSat(box)};
+  ASSERT_TRUE(model_a);
+  // p is the atom 0 of the first exchange. b does not know it.
+  a.ShareLearnedClause({{FindAtom(a, *model_a, p), true}});
+  const optional<Model> model_b{b.CheckSat(box)};
+  ASSERT_TRUE(model_b);
+  a.SetClauseExchange(nullptr, 0);
+  b.SetClauseExchange(nullptr, 0);
+
+  ClauseExchange second{16, 4};
+  a.SetClauseExchange(&second, 0);
+  b.SetClauseExchange(&second, 1);
+  // q is the atom 0 of the second exchange, so a has to learn ¬q, not ¬p.
+  b.ShareLearnedClause({{FindAtom(b, *model_b, q), true}});
+  const optional<Model> again{a.CheckSat(box)};
+  ASSERT_TRUE(again);
+  for (const Literal& l : again->second) {
+    if (a.theory_literal(l.first).EqualTo(q)) {
+      EXPECT_FALSE(l.second);
+    }
+    if (a.theory_literal(l.first).EqualTo(r)) {
+      EXPECT_TRUE(l.second);
+    }
+  }
+}
+
+template <Config::LPSolver lp_solver>
+class ClauseSharingTest : public ::testing::Test {
+  DrakeSymbolicGuard guard_{lp_solver};
+
+ protected:
+  ClauseSharingTest() { config_.mutable_lp_solver() = lp_solver; }
+
+  Config config_;
+};
+
+using QsoptexClauseSharingTest = ClauseSharingTest<Config::QSOPTEX>;
+
+TEST_F(QsoptexClauseSharingTest, ExchangePerCheck) {
+  CheckSharingAcrossChecks<QsoptexSatSolver>(config_);
+}
+
+#if HAVE_SOPLEX
+using SoplexClauseSharingTest = ClauseSharingTest<Config::SOPLEX>;
+
+TEST_F(SoplexClauseSharingTest, ExchangePerCheck) {
+  CheckSharingAcrossChecks<SoplexSatSolver>(config_);
+}
+#endif
+
 }  // namespace
 }  // namespace dreal
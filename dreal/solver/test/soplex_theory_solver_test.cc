@@ -0,0 +1,130 @@
+#if HAVE_SOPLEX
+# include "dreal/solver/soplex_theory_solver.h"
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dreal/solver/config.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/symbolic/symbolic_test_util.h"
+
+#if HAVE_SOPLEX
+# include "dreal/solver/context.h"
+# include "dreal/solver/soplex_sat_solver.h"
+#endif
+
+namespace dreal {
+namespace {
+
+#if HAVE_SOPLEX
+
+class SoplexTheorySolverTest : public ::testing::Test {
+  DrakeSymbolicGuard guard_{Config::SOPLEX};
+
+ protected:
+  void SetUp() override {
+    ::testing::Test::SetUp();
+    config_.mutable_lp_solver() = Config::SOPLEX;
+    sat_solver_.reset(new SoplexSatSolver{config_});
+    theory_solver_.reset(new SoplexTheorySolver{config_});
+  }
+
+  // Checks the theory literals of @p model with the explanation
+  // @p lp_explanation, and returns the explanation of the theory solver. The
+  // solvers keep a reference to config_, so that the LP is the same for
+  // every kind of explanation.
+  LiteralSet Explain(const std::vector<Literal>& model,
+                     const Config::LPExplanation lp_explanation) {
+    config_.mutable_lp_explanation() = lp_explanation;
+    EXPECT_EQ(Check(model), SAT_UNSATISFIABLE);
+    return theory_solver_->GetExplanation();
+  }
+
+  // Checks the theory literals of @p model, and returns the result of the
+  // theory solver.
+  int Check(const std::vector<Literal>& model) {
+    return theory_solver_->CheckSat(
+        box_, model, sat_solver_->GetLinearSolverPtr(),
+        sat_solver_->GetLowerBounds(), sat_solver_->GetUpperBounds(),
+        sat_solver_->GetLinearRowMap(), sat_solver_->GetLowerBoundLiterals(),
+        sat_solver_->GetUpperBoundLiterals(), sat_solver_->GetLinearVarMap());
+  }
+
+  // Returns true if one of the atoms of @p literals is on z.
+  bool HasZ(const LiteralSet& literals) const {
+    return std::any_of(literals.begin(), literals.end(),
+                       [this](const Literal& l) {
+                         return sat_solver_->theory_literal(l.first)
+                             .GetFreeVariables()
+                             .include(z_);
+                       });
+  }
+
+  static bool Includes(const LiteralSet& s1, const LiteralSet& s2) {
+    return std::includes(s1.begin(), s1.end(), s2.begin(), s2.end(),
+                         LiteralComparator{});
+  }
+
+  const Variable x_{"x"};
+  const Variable y_{"y"};
+  const Variable z_{"z"};
+  const Box box_{Box({x_, y_, z_})};
+  Config config_;
+  std::unique_ptr<SoplexSatSolver> sat_solver_;
+  std::unique_ptr<SoplexTheorySolver> theory_solver_;
+};
+
+TEST_F(SoplexTheorySolverTest, Explanations) {
+  // x + y <= 1, x >= 2 and y >= 0 are infeasible. The atoms on z hold
+  // whatever x and y are.
+  sat_solver_->AddFormula(x_ + y_ <= 1);
+  sat_solver_->AddFormula(x_ >= 2);
+  sat_solver_->AddFormula(y_ >= 0);
+  sat_solver_->AddFormula(z_ >= 0);
+  sat_solver_->AddFormula(x_ - z_ <= 3);
+  sat_solver_->AddFormula(y_ + z_ >= -1);
+  const optional<SoplexSatSolver::Model> model{sat_solver_->CheckSat(box_)};
+  ASSERT_TRUE(model);
+  const std::vector<Literal>& literals{model->second};
+
+  const LiteralSet assertions{
+      Explain(literals, Config::LPExplanation::Assertions)};
+  EXPECT_EQ(assertions.size(),
+            LiteralSet(literals.begin(), literals.end()).size());
+  EXPECT_TRUE(HasZ(assertions));
+
+  const LiteralSet farkas{Explain(literals, Config::LPExplanation::Farkas)};
+  EXPECT_FALSE(farkas.empty());
+  EXPECT_FALSE(HasZ(farkas));
+  EXPECT_TRUE(Includes(assertions, farkas));
+
+  // Each of x + y <= 1, x >= 2 and y >= 0 is needed.
+  const LiteralSet minimal{Explain(literals, Config::LPExplanation::Minimal)};
+  EXPECT_EQ(minimal.size(), 3);
+  EXPECT_FALSE(HasZ(minimal));
+  EXPECT_TRUE(Includes(farkas, minimal));
+}
+
+TEST_F(SoplexTheorySolverTest, ExactModel) {
+  // The only solution, x = y = 1/3, has no floating-point representation, so
+  // the model has to come from the exact solve.
+  sat_solver_->AddFormula(x_ + 2 * y_ == 1);
+  sat_solver_->AddFormula(x_ - y_ == 0);
+  const optional<SoplexSatSolver::Model> model{sat_solver_->CheckSat(box_)};
+  ASSERT_TRUE(model);
+  ASSERT_EQ(Check(model->second), SAT_DELTA_SATISFIABLE);
+  const Box& solution{theory_solver_->GetModel()};
+  EXPECT_EQ(solution[x_].lb(), mpq_class(1, 3));
+  EXPECT_EQ(solution[x_].ub(), mpq_class(1, 3));
+  EXPECT_EQ(solution[y_].lb(), mpq_class(1, 3));
+  EXPECT_EQ(solution[y_].ub(), mpq_class(1, 3));
+}
+
+#endif
+
+}  // namespace
+}  // namespace dreal
@@ -0,0 +1,109 @@
+// Measures the overhead of QsoptexTheorySolver::CheckSat() on an LP which is
+// already feasible, so that the time goes into setting up the model rather
+// than into the simplex:
+//
+//   bazel run //dreal/solver:theory_solver_benchmark -- [#vars] [#checks]
+//
+// The LP has one column per variable, bounded by 0 ≤ xᵢ ≤ 10, and a row
+// xᵢ + xᵢ₊₁ ≤ 15 for every other variable. Each variable also has a Boolean
+// companion in the box, as the SAT solver would add. For comparison, the time
+// of a full copy of the box, which each check used to make, is reported too.
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "dreal/qsopt_ex.h"
+#include "dreal/solver/config.h"
+#include "dreal/solver/context.h"
+#include "dreal/solver/qsoptex_sat_solver.h"
+#include "dreal/solver/qsoptex_theory_solver.h"
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+#include "dreal/util/infty.h"
+#include "dreal/util/timer.h"
+
+namespace dreal {
+namespace {
+
+using std::cerr;
+using std::cout;
+using std::vector;
+
+int Run(const int num_vars, const int num_checks) {
+  const Config config;
+  vector<Variable> vars;
+  for (int i = 0; i < num_vars; ++i) {
+    vars.emplace_back(fmt::format("x{}", i));
+    vars.emplace_back(fmt::format("b{}", i), Variable::Type::BOOLEAN);
+  }
+  Box box{vars};
+
+  QsoptexSatSolver sat_solver{config};
+  vector<Formula> formulas;
+  for (int i = 0; i < num_vars; ++i) {
+    const Variable& x{vars[2 * i]};
+    formulas.push_back(0 <= x);
+    formulas.push_back(x <= 10);
+    if (i % 2 == 0 && i + 1 < num_vars) {
+      formulas.push_back(x + vars[2 * (i + 1)] <= 15);
+    }
+  }
+  sat_solver.AddFormulas(formulas);
+  const auto model = sat_solver.CheckSat(box);
+  if (!model) {
+    cerr << "The SAT solver found no model.\n";
+    return 1;
+  }
+
+  QsoptexTheorySolver theory_solver{config};
+  mpq_class actual_precision;
+  Timer check_timer;
+  for (int i = 0; i < num_checks; ++i) {
+    check_timer.resume();
+    const int result{theory_solver.CheckSat(
+        box, model->second, sat_solver.GetLinearSolver(),
+        sat_solver.GetLinearRowMap(), sat_solver.GetLowerBoundLiterals(),
+        sat_solver.GetUpperBoundLiterals(), sat_solver.GetLinearVarMap(),
+        &actual_precision)};
+    check_timer.pause();
+    if (result != SAT_DELTA_SATISFIABLE) {
+      cerr << "The LP is not feasible.\n";
+      return 1;
+    }
+  }
+
+  Timer copy_timer;
+  for (int i = 0; i < num_checks; ++i) {
+    copy_timer.resume();
+    const Box copy{box};
+    copy_timer.pause();
+  }
+
+  fmt::print(cout, "{:<30} = {:>12}\n", "#variables", num_vars);
+  fmt::print(cout, "{:<30} = {:>12}\n", "#checks", num_checks);
+  fmt::print(cout, "{:<30} = {:>12.6f} sec\n", "CheckSat (per call)",
+             check_timer.seconds() / num_checks);
+  fmt::print(cout, "{:<30} = {:>12.6f} sec\n", "Box copy (per call)",
+             copy_timer.seconds() / num_checks);
+  return 0;
+}
+
+}  // namespace
+}  // namespace dreal
+
+int main(int argc, char* argv[]) {
+  const int num_vars{argc > 1 ? std::atoi(argv[1]) : 20000};
+  const int num_checks{argc > 2 ? std::atoi(argv[2]) : 100};
+  dreal::qsopt_ex::QSXStart();
+  dreal::util::InftyStart(dreal::qsopt_ex::mpq_INFTY,
+                          dreal::qsopt_ex::mpq_NINFTY);
+  dreal::Expression::InitConstants();
+  const int ret{dreal::Run(num_vars, num_checks)};
+  dreal::Expression::DeInitConstants();
+  dreal::util::InftyFinish();
+  dreal::qsopt_ex::QSXFinish();
+  return ret;
+}
@@ -522,20 +522,16 @@ bool IsDifferentiable(const Expression& e) {
   return IsDifferentiableVisitor{}.Visit(e);
 }
 
+// Folding the formulas with && or || would rebuild the n-ary cell, its hash
+// and its free variables at every step, which is quadratic in the number of
+// operands. Instead, they are collected once and handed to Drake's set-based
+// builders, which flatten them and allocate a single cell.
 Formula make_conjunction(const vector<Formula>& formulas) {
-  Formula ret{Formula::True()};
-  for (const auto& f_i : formulas) {
-    ret = std::move(ret) && f_i;
-  }
-  return ret;
+  return make_conjunction(set<Formula>(formulas.begin(), formulas.end()));
 }
 
 Formula make_disjunction(const vector<Formula>& formulas) {
-  Formula ret{Formula::False()};
-  for (const auto& f_i : formulas) {
-    ret = std::move(ret) || f_i;
-  }
-  return ret;
+  return make_disjunction(set<Formula>(formulas.begin(), formulas.end()));
 }
 
 vector<Variable> CreateVector(const string& prefix, const int size,
@@ -96,13 +96,17 @@ bool IsDifferentiable(const Formula& f);
 /// Returns true if the expression @e f is symbolic-differentiable.
 bool IsDifferentiable(const Expression& e);
 
-/// Make conjunction of @p formulas.
+/// Make conjunction of @p formulas. The conjunction is built in one
+/// pass, in O(n log n), with the simplifications of Drake's version.
 ///
 /// @note This is different from the one in Drake's symbolic
 /// library. It takes `std::vector<Formula>` while Drake's version
 /// takes `std::set<Formula>`.
 Formula make_conjunction(const std::vector<Formula>& formulas);
 
+/// Make disjunction of @p formulas. The disjunction is built in one
+/// pass, in O(n log n), with the simplifications of Drake's version.
+///
 /// @note This is different from the one in Drake's symbolic
 /// library. It takes `std::vector<Formula>` while Drake's version
 /// takes `std::set<Formula>`.
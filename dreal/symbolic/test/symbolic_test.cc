@@ -424,6 +424,48 @@ TEST_F(SymbolicTest, DestructiveUpdateOr2) {
   }
 }
 
+TEST_F(SymbolicTest, MakeConjunction) {
+  const Formula f1{x_ <= y_};
+  const Formula f2{y_ <= z_};
+  const Formula f3{Formula{b1_}};
+  EXPECT_TRUE(make_conjunction(vector<Formula>{}).EqualTo(Formula::True()));
+  EXPECT_TRUE(make_conjunction(vector<Formula>{f1}).EqualTo(f1));
+  EXPECT_TRUE(make_conjunction(vector<Formula>{f1, Formula::True(), f1})
+                  .EqualTo(f1));
+  EXPECT_TRUE(make_conjunction(vector<Formula>{f1, Formula::False(), f2})
+                  .EqualTo(Formula::False()));
+  // Nested conjunctions are flattened.
+  EXPECT_TRUE(make_conjunction(vector<Formula>{f1, f2 && f3, f1 || f2})
+                  .EqualTo(f1 && f2 && f3 && (f1 || f2)));
+}
+
+TEST_F(SymbolicTest, MakeDisjunction) {
+  const Formula f1{x_ <= y_};
+  const Formula f2{y_ <= z_};
+  const Formula f3{Formula{b1_}};
+  EXPECT_TRUE(make_disjunction(vector<Formula>{}).EqualTo(Formula::False()));
+  EXPECT_TRUE(make_disjunction(vector<Formula>{f1}).EqualTo(f1));
+  EXPECT_TRUE(make_disjunction(vector<Formula>{f1, Formula::False(), f1})
+                  .EqualTo(f1));
+  EXPECT_TRUE(make_disjunction(vector<Formula>{f1, Formula::True(), f2})
+                  .EqualTo(Formula::True()));
+  // Nested disjunctions are flattened.
+  EXPECT_TRUE(make_disjunction(vector<Formula>{f1, f2 || f3, f1 && f2})
+                  .EqualTo(f1 || f2 || f3 || (f1 && f2)));
+}
+
+TEST_F(SymbolicTest, MakeConjunctionLarge) {
+  constexpr int N{100000};
+  vector<Formula> formulas;
+  for (int i = 0; i < N; ++i) {
+    formulas.push_back(Variable("var_" + to_string(i)) == 0.0);
+  }
+  const Formula f{make_conjunction(formulas)};
+  ASSERT_TRUE(is_conjunction(f));
+  EXPECT_EQ(get_operands(f).size(), static_cast<size_t>(N));
+  EXPECT_EQ(f.GetFreeVariables().size(), static_cast<size_t>(N));
+}
+
 GTEST_TEST(Symbolic, IsNothrowMoveConstructible) {
   static_assert(std::is_nothrow_move_constructible<Variable>::value,
                 "Variable should be nothrow_move_constructible.");
@@ -97,6 +97,21 @@ class ContextTest(unittest.TestCase):
         ctx.Exit()
         self.assertTrue(ctx.box)
 
+    def test_check_sat_assuming(self):
+        ctx = Context()
+        ctx.SetLogic(Logic.QF_LRA)
+        x = Variable("x")
+        b = Variable("b", Variable.Bool)
+        ctx.DeclareVariable(x, -10, 10)
+        ctx.DeclareVariable(b)
+        ctx.Assert(x >= 0)
+        self.assertTrue(ctx.CheckSatAssuming([x <= 5, b]))
+        self.assertFalse(ctx.CheckSatAssuming([b, x <= -1]))
+        self.assertEqual(len(ctx.GetUnsatAssumptions()), 1)
+        self.assertTrue(ctx.GetUnsatAssumptions()[0].EqualTo(x <= -1))
+        # The assumptions do not outlive the call.
+        self.assertTrue(ctx.CheckSat())
+
     def test_config(self):
         ctx = Context()
         config1 = ctx.config
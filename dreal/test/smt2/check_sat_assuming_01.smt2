@@ -0,0 +1,15 @@
+(set-logic QF_LRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun b () Bool)
+(assert (<= (+ x y) 4))
+(assert (>= x 0))
+(assert (>= y 0))
+(assert (=> b (>= x 3)))
+(check-sat-assuming (b (>= y 2)))
+(get-unsat-assumptions)
+(check-sat-assuming (b (>= y 1)))
+(check-sat-assuming ((>= y 5)))
+(get-unsat-assumptions)
+(check-sat)
+(exit)
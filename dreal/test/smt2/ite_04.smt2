@@ -0,0 +1,13 @@
+(set-logic QF_LRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun b1 () Bool)
+(declare-fun b2 () Bool)
+(assert (<= x -1))
+(assert (<= y -1))
+(assert (> (ite b1
+                (max (ite b2 x y) 0)
+                (+ (max (ite b2 x y) 0) 1))
+           2))
+(check-sat)
+(exit)
@@ -0,0 +1,14 @@
+(set-logic QF_LRA)
+(declare-fun x () Real)
+(declare-fun h1 () Real)
+(declare-fun h2 () Real)
+(declare-fun y () Real)
+(assert (<= -1 x))
+(assert (<= x 1))
+(assert (= h1 (max 0 (+ x 1))))
+(assert (= h2 (max 0 (- 1 x))))
+(assert (= y (+ h1 h2)))
+(assert (or (> y 2.5)
+            (< (min h1 h2) (- 0.5 (abs x)))))
+(check-sat)
+(exit)
@@ -0,0 +1,298 @@
+#include "dreal/util/bound_implicator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <iterator>
+
+#include "dreal/util/exception.h"
+#include "dreal/util/logging.h"
+#include "dreal/util/stat.h"
+
+namespace dreal {
+
+using std::cout;
+using std::pair;
+using std::vector;
+
+namespace {
+// A class to show statistics information at destruction.
+class BoundImplicatorStat : public Stat {
+ public:
+  explicit BoundImplicatorStat(const bool enabled) : Stat{enabled} {}
+  BoundImplicatorStat(const BoundImplicatorStat&) = delete;
+  BoundImplicatorStat(BoundImplicatorStat&&) = delete;
+  BoundImplicatorStat& operator=(const BoundImplicatorStat&) = delete;
+  BoundImplicatorStat& operator=(BoundImplicatorStat&&) = delete;
+  ~BoundImplicatorStat() override {
+    if (enabled()) {
+      using fmt::print;
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of bound atoms",
+            "Bound Implicator", num_atoms_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of implications",
+            "Bound Implicator", num_implications_);
+    }
+  }
+
+  void increase_num_atoms() { increase(&num_atoms_); }
+  void add_implications(const int n) {
+    if (enabled()) {
+      num_implications_ += n;
+    }
+  }
+
+ private:
+  std::atomic<int> num_atoms_{0};
+  std::atomic<int> num_implications_{0};
+};
+
+// Adds the linear expression @p e into @p coeffs and @p constant. Returns
+// false if @p e is not linear.
+bool Linearize(const Expression& e, std::map<Variable::Id, mpq_class>* coeffs,
+               mpq_class* constant) {
+  if (is_constant(e)) {
+    *constant += get_constant_value(e);
+    return true;
+  }
+  if (is_variable(e)) {
+    (*coeffs)[get_variable(e).get_id()] += 1;
+    return true;
+  }
+  if (is_multiplication(e)) {
+    const std::map<Expression, Expression>& base_to_exp{
+        get_base_to_exponent_map_in_multiplication(e)};
+    if (base_to_exp.size() != 1 || !is_variable(base_to_exp.begin()->first) ||
+        !is_constant(base_to_exp.begin()->second) ||
+        get_constant_value(base_to_exp.begin()->second) != 1) {
+      return false;
+    }
+    (*coeffs)[get_variable(base_to_exp.begin()->first).get_id()] +=
+        get_constant_in_multiplication(e);
+    return true;
+  }
+  if (is_addition(e)) {
+    *constant += get_constant_in_addition(e);
+    for (const pair<const Expression, mpq_class>& p :
+         get_expr_to_coeff_map_in_addition(e)) {
+      if (!is_variable(p.first)) {
+        return false;
+      }
+      (*coeffs)[get_variable(p.first).get_id()] += p.second;
+    }
+    return true;
+  }
+  return false;
+}
+
+enum class Relation { EQ, LT, LEQ, GT, GEQ };
+
+Relation Flip(const Relation rel) {
+  switch (rel) {
+    case Relation::LT:
+      return Relation::GT;
+    case Relation::LEQ:
+      return Relation::GEQ;
+    case Relation::GT:
+      return Relation::LT;
+    case Relation::GEQ:
+      return Relation::LEQ;
+    case Relation::EQ:
+      return Relation::EQ;
+  }
+  return rel;
+}
+
+Literal Negate(const Literal& l) { return {l.first, !l.second}; }
+}  // namespace
+
+bool BoundImplicator::Before(const Endpoint& a, const Endpoint& b) {
+  return a.value < b.value || (a.value == b.value && a.open && !b.open);
+}
+
+bool BoundImplicator::Contains(const Endpoint& ub, const mpq_class& value) {
+  return value < ub.value || (value == ub.value && !ub.open);
+}
+
+void BoundImplicator::AddBound(const UpperBound& bound, Group* const group,
+                               vector<pair<Literal, Literal>>* const conflicts) {
+  vector<UpperBound>& bounds{group->bounds};
+  // The new bound goes after the ones which are equal to it.
+  const auto it = std::upper_bound(
+      bounds.begin(), bounds.end(), bound,
+      [](const UpperBound& a, const UpperBound& b) {
+        return Before(a.ub, b.ub);
+      });
+  const UpperBound* const prev{it == bounds.begin() ? nullptr
+                                                    : &*std::prev(it)};
+  const UpperBound* const next{it == bounds.end() ? nullptr : &*it};
+  if (prev) {
+    // prev ⇒ bound, and the other way around if they are equal.
+    conflicts->emplace_back(prev->literal, Negate(bound.literal));
+    if (!Before(prev->ub, bound.ub)) {
+      conflicts->emplace_back(bound.literal, Negate(prev->literal));
+    }
+  }
+  if (next) {
+    // bound ⇒ next.
+    conflicts->emplace_back(bound.literal, Negate(next->literal));
+  }
+  // The equalities outside of (prev, next] are already related to prev or
+  // next, and so to the new bound.
+  for (const Point& point : group->points) {
+    if ((prev && Contains(prev->ub, point.value)) ||
+        (next && !Contains(next->ub, point.value))) {
+      continue;
+    }
+    if (Contains(bound.ub, point.value)) {
+      conflicts->emplace_back(point.literal, Negate(bound.literal));
+    } else {
+      conflicts->emplace_back(point.literal, bound.literal);
+    }
+  }
+  bounds.insert(it, bound);
+}
+
+void BoundImplicator::AddPoint(const Point& point, Group* const group,
+                               vector<pair<Literal, Literal>>* const conflicts) {
+  vector<Point>& points{group->points};
+  const auto it = std::lower_bound(
+      points.begin(), points.end(), point,
+      [](const Point& a, const Point& b) { return a.value < b.value; });
+  if (it != points.end() && it->value == point.value) {
+    // Both equalities are the same, and so are their conflicts.
+    conflicts->emplace_back(point.literal, Negate(it->literal));
+    conflicts->emplace_back(it->literal, Negate(point.literal));
+    points.insert(it, point);
+    return;
+  }
+  if (it != points.begin()) {
+    conflicts->emplace_back(point.literal, std::prev(it)->literal);
+  }
+  if (it != points.end()) {
+    conflicts->emplace_back(point.literal, it->literal);
+  }
+  // point ⇒ the tightest bound which contains it, and ¬ the loosest one which
+  // does not.
+  const vector<UpperBound>& bounds{group->bounds};
+  const auto first = std::partition_point(
+      bounds.begin(), bounds.end(), [&point](const UpperBound& b) {
+        return !Contains(b.ub, point.value);
+      });
+  if (first != bounds.end()) {
+    conflicts->emplace_back(point.literal, Negate(first->literal));
+  }
+  if (first != bounds.begin()) {
+    conflicts->emplace_back(point.literal, std::prev(first)->literal);
+  }
+  points.insert(it, point);
+}
+
+vector<pair<Literal, Literal>> BoundImplicator::Add(const Variable& var,
+                                                    const Formula& f) {
+  static BoundImplicatorStat stat{DREAL_LOG_INFO_ENABLED};
+  vector<pair<Literal, Literal>> conflicts;
+  if (!registered_.insert(var.get_id()).second) {
+    return conflicts;
+  }
+  trail_.push_back({var.get_id(), nullptr});
+  Relation rel;
+  if (is_equal_to(f)) {
+    rel = Relation::EQ;
+  } else if (is_less_than(f)) {
+    rel = Relation::LT;
+  } else if (is_less_than_or_equal_to(f)) {
+    rel = Relation::LEQ;
+  } else if (is_greater_than(f)) {
+    rel = Relation::GT;
+  } else if (is_greater_than_or_equal_to(f)) {
+    rel = Relation::GEQ;
+  } else {
+    return conflicts;
+  }
+  std::map<Variable::Id, mpq_class> coeffs;
+  mpq_class constant{0};
+  const Expression e{
+      (get_lhs_expression(f) - get_rhs_expression(f)).Expand()};
+  if (!Linearize(e, &coeffs, &constant)) {
+    return conflicts;
+  }
+  for (auto it = coeffs.begin(); it != coeffs.end();) {
+    it = it->second == 0 ? coeffs.erase(it) : std::next(it);
+  }
+  if (coeffs.empty()) {
+    return conflicts;
+  }
+
+  // f ⇔ Σ aᵢxᵢ ⋈ -constant. Divide by a₀, so that the key is unique.
+  const mpq_class scale{coeffs.begin()->second};
+  Key key;
+  key.reserve(coeffs.size());
+  for (const pair<const Variable::Id, mpq_class>& p : coeffs) {
+    key.emplace_back(p.first, p.second / scale);
+  }
+  const mpq_class value{-constant / scale};
+  if (scale < 0) {
+    rel = Flip(rel);
+  }
+
+  Group& group{groups_[key]};
+  trail_.back().group = &group;
+  const Literal literal{var, true};
+  switch (rel) {
+    case Relation::EQ:
+      AddPoint({literal, value}, &group, &conflicts);
+      break;
+    case Relation::LT:
+      AddBound({literal, {value, true}}, &group, &conflicts);
+      break;
+    case Relation::LEQ:
+      AddBound({literal, {value, false}}, &group, &conflicts);
+      break;
+    case Relation::GT:
+      // ¬f ⇔ p ≤ value.
+      AddBound({Negate(literal), {value, false}}, &group, &conflicts);
+      break;
+    case Relation::GEQ:
+      // ¬f ⇔ p < value.
+      AddBound({Negate(literal), {value, true}}, &group, &conflicts);
+      break;
+  }
+  ++size_;
+  stat.increase_num_atoms();
+  stat.add_implications(conflicts.size());
+  DREAL_LOG_DEBUG("BoundImplicator::Add({} ↦ {}): {} implications", var, f,
+                  conflicts.size());
+  return conflicts;
+}
+
+void BoundImplicator::Push() { scopes_.push_back(trail_.size()); }
+
+void BoundImplicator::Pop() {
+  if (scopes_.empty()) {
+    throw DREAL_RUNTIME_ERROR(
+        "BoundImplicator cannot be popped because its scope is empty.");
+  }
+  while (trail_.size() > scopes_.back()) {
+    const Registration& r{trail_.back()};
+    registered_.erase(r.id);
+    if (r.group) {
+      vector<UpperBound>& bounds{r.group->bounds};
+      bounds.erase(std::remove_if(bounds.begin(), bounds.end(),
+                                  [&r](const UpperBound& b) {
+                                    return b.literal.first.get_id() == r.id;
+                                  }),
+                   bounds.end());
+      vector<Point>& points{r.group->points};
+      points.erase(std::remove_if(points.begin(), points.end(),
+                                  [&r](const Point& p) {
+                                    return p.literal.first.get_id() == r.id;
+                                  }),
+                   points.end());
+      --size_;
+    }
+    trail_.pop_back();
+  }
+  scopes_.pop_back();
+}
+
+}  // namespace dreal
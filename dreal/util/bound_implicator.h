@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/util/literal.h"
+
+namespace dreal {
+
+/// Finds pairs of theory literals which can't hold at the same time, so that
+/// they can be given to the SAT solver as binary clauses up front.
+///
+/// Every atom of the form `p ⋈ c` is considered, where `p` is a linear term,
+/// `c` is a constant and `⋈` is one of `=, <, ≤, >, ≥`. Atoms are grouped by
+/// `p`, after scaling it so that its first coefficient is one. For example,
+/// `b₁ ⇔ (x ≤ 3)` and `b₂ ⇔ (x ≤ 5)` yield the conflict `{b₁, ¬b₂}`, that
+/// is the clause `¬b₁ ∨ b₂`.
+///
+/// Within a group, the inequalities are kept sorted by bound, and a new atom
+/// is only paired with its neighbours: the implications between the other
+/// atoms follow by unit propagation along the chain, so that a group of k
+/// atoms yields O(k) clauses rather than O(k²). An equality is paired with
+/// the nearest bounds on either side, and with the nearest equalities. Two
+/// equalities which are not neighbours are only kept apart by the bounds
+/// between them, if any.
+class BoundImplicator {
+ public:
+  /// Registers the atom @p f, abstracted by the Boolean variable @p var.
+  ///
+  /// @returns the pairs of literals (on @p var and on the atoms registered
+  /// before) which are mutually exclusive. Atoms which are not linear, or
+  /// which were already registered, yield no pair.
+  std::vector<std::pair<Literal, Literal>> Add(const Variable& var,
+                                               const Formula& f);
+
+  /// Returns the number of atoms which have been grouped so far.
+  int size() const { return size_; }
+
+  /// Opens a new scope. The atoms added after this call are forgotten by the
+  /// matching Pop().
+  void Push();
+
+  /// Forgets the atoms added since the last Push().
+  void Pop();
+
+ private:
+  // The end of an interval `(-∞, value)` if `open`, `(-∞, value]` otherwise.
+  struct Endpoint {
+    mpq_class value;
+    bool open;
+  };
+
+  // The literal of an inequality which holds for `p ≤ c` or `p < c`. The
+  // other literal on the same atom holds for the rest of the line.
+  struct UpperBound {
+    Literal literal;
+    Endpoint ub;
+  };
+
+  // The literal of an equality `p = c`.
+  struct Point {
+    Literal literal;
+    mpq_class value;
+  };
+
+  // The atoms on a linear term, sorted by ub and by value respectively.
+  struct Group {
+    std::vector<UpperBound> bounds;
+    std::vector<Point> points;
+  };
+
+  // Linear term, as a sorted list of (variable id, coefficient).
+  using Key = std::vector<std::pair<Variable::Id, mpq_class>>;
+
+  // An atom, as registered by Add(). If it was grouped, `group` points to
+  // its group.
+  struct Registration {
+    Variable::Id id;
+    Group* group;
+  };
+
+  // Returns true if the interval ending at @p a is strictly included in the
+  // one ending at @p b.
+  static bool Before(const Endpoint& a, const Endpoint& b);
+
+  // Returns true if @p value is in the interval ending at @p ub.
+  static bool Contains(const Endpoint& ub, const mpq_class& value);
+
+  // Adds @p bound to @p group, and the conflicts with its neighbours to
+  // @p conflicts.
+  static void AddBound(const UpperBound& bound, Group* group,
+                       std::vector<std::pair<Literal, Literal>>* conflicts);
+
+  // Adds @p point to @p group, and the conflicts with its neighbours to
+  // @p conflicts.
+  static void AddPoint(const Point& point, Group* group,
+                       std::vector<std::pair<Literal, Literal>>* conflicts);
+
+  std::map<Key, Group> groups_;
+  std::set<Variable::Id> registered_;
+  int size_{0};
+
+  // Every registration, in order, and the size of trail_ at each Push().
+  std::vector<Registration> trail_;
+  std::vector<size_t> scopes_;
+};
+
+}  // namespace dreal
@@ -183,6 +183,18 @@ bool Box::has_variable(const Variable& var) const {
 
 int Box::index(const Variable& var) const { return (*var_to_idx_)[var]; }
 
+void Box::InplaceAssign(const Box& b) {
+  if (variables_ != b.variables_ || values_.size() != b.values_.size()) {
+    *this = b;
+    return;
+  }
+  for (size_t i = 0; i < values_.size(); ++i) {
+    if (values_[i] != b.values_[i]) {
+      values_[i] = b.values_[i];
+    }
+  }
+}
+
 const Box::IntervalVector& Box::interval_vector() const { return values_; }
 Box::IntervalVector& Box::mutable_interval_vector() { return values_; }
 
@@ -27,8 +27,8 @@ class Box {
     bool is_empty() const { return lb_ == 1 && ub_ == 0; }
     bool is_degenerated() const { return lb_ == ub_; }
     bool is_bisectable() const { return lb_ < ub_; }
-    mpq_class lb() const { return lb_; }
-    mpq_class ub() const { return ub_; }
+    const mpq_class& lb() const { return lb_; }
+    const mpq_class& ub() const { return ub_; }
     mpq_class mid() const { return (lb_ + ub_) / 2; }
     mpq_class diam() const { return is_empty() ? mpq_class(0) : mpq_class(ub_ - lb_); }
     std::pair<Interval, Interval> bisect(const mpq_class& p) const;
@@ -130,6 +130,12 @@ class Box {
   /// @throws std::runtime if @p i -th dimension is not bisectable.
   std::pair<Box, Box> bisect(const Variable& var) const;
 
+  /// Sets this box to @p b. Unlike operator=, when both boxes share the same
+  /// variables (e.g. one is a copy of the other), the intervals are updated
+  /// in place: only those which differ are written, and their bounds reuse
+  /// the storage they already have.
+  void InplaceAssign(const Box& b);
+
   /// Updates the current box by taking union with @p b.
   ///
   /// @pre variables() == b.variables().
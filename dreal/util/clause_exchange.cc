@@ -0,0 +1,169 @@
+#include "dreal/util/clause_exchange.h"
+
+#include <atomic>
+#include <iostream>
+#include <utility>
+
+#include "dreal/util/assert.h"
+#include "dreal/util/exception.h"
+#include "dreal/util/logging.h"
+#include "dreal/util/stat.h"
+
+namespace dreal {
+
+using std::cout;
+using std::lock_guard;
+using std::memory_order_acquire;
+using std::memory_order_relaxed;
+using std::memory_order_release;
+using std::mutex;
+using std::vector;
+
+namespace {
+// A class to show statistics information at destruction.
+class ClauseExchangeStat : public Stat {
+ public:
+  explicit ClauseExchangeStat(const bool enabled) : Stat{enabled} {}
+  ClauseExchangeStat(const ClauseExchangeStat&) = delete;
+  ClauseExchangeStat(ClauseExchangeStat&&) = delete;
+  ClauseExchangeStat& operator=(const ClauseExchangeStat&) = delete;
+  ClauseExchangeStat& operator=(ClauseExchangeStat&&) = delete;
+  ~ClauseExchangeStat() override {
+    if (enabled()) {
+      using fmt::print;
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of published clauses",
+            "Clause Exchange", num_published_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of dropped clauses",
+            "Clause Exchange", num_dropped_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of collected clauses",
+            "Clause Exchange", num_collected_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of lost clauses",
+            "Clause Exchange", num_lost_);
+    }
+  }
+
+  void increase_num_published() { increase(&num_published_); }
+  void increase_num_dropped() { increase(&num_dropped_); }
+  void increase_num_collected() { increase(&num_collected_); }
+  void increase_num_lost() { increase(&num_lost_); }
+
+ private:
+  std::atomic<int> num_published_{0};
+  std::atomic<int> num_dropped_{0};
+  std::atomic<int> num_collected_{0};
+  std::atomic<int> num_lost_{0};
+};
+
+ClauseExchangeStat& exchange_stat() {
+  static ClauseExchangeStat stat{DREAL_LOG_INFO_ENABLED};
+  return stat;
+}
+}  // namespace
+
+ClauseExchange::ClauseExchange(const int capacity, const int max_clause_size)
+    : capacity_{capacity}, max_clause_size_{max_clause_size} {
+  if (capacity <= 0 || max_clause_size <= 0) {
+    throw DREAL_RUNTIME_ERROR(
+        "ClauseExchange: capacity ({}) and max_clause_size ({}) must be "
+        "positive.",
+        capacity, max_clause_size);
+  }
+  slots_.reset(new Slot[capacity]);
+  lits_.reset(new std::atomic<int>[static_cast<size_t>(capacity) *
+                                   max_clause_size]);
+}
+
+int ClauseExchange::AtomId(const Formula& atom) {
+  lock_guard<mutex> guard{atoms_mutex_};
+  const auto it = atom_ids_.find(atom);
+  if (it != atom_ids_.end()) {
+    return it->second;
+  }
+  const int id = atoms_.size();
+  atoms_.push_back(atom);
+  atom_ids_.emplace(atom, id);
+  return id;
+}
+
+Formula ClauseExchange::atom(const int id) const {
+  lock_guard<mutex> guard{atoms_mutex_};
+  DREAL_ASSERT(0 <= id && id < static_cast<int>(atoms_.size()));
+  return atoms_[id];
+}
+
+bool ClauseExchange::Publish(const int worker, const vector<int>& clause) {
+  auto& stat = exchange_stat();
+  if (clause.empty() || static_cast<int>(clause.size()) > max_clause_size_) {
+    stat.increase_num_dropped();
+    return false;
+  }
+  const uint64_t pos{head_.fetch_add(1, memory_order_relaxed)};
+  const size_t i = pos % capacity_;
+  Slot& slot{slots_[i]};
+  // Take the slot, unless another writer is on it or it already holds a
+  // more recent clause. Then the clause is dropped.
+  uint64_t seq{slot.seq.load(memory_order_relaxed)};
+  if (seq % 2 == 1 || seq > 2 * pos ||
+      !slot.seq.compare_exchange_strong(seq, 2 * pos + 1,
+                                        memory_order_relaxed)) {
+    stat.increase_num_dropped();
+    return false;
+  }
+  std::atomic_thread_fence(memory_order_release);
+  slot.worker.store(worker, memory_order_relaxed);
+  slot.size.store(clause.size(), memory_order_relaxed);
+  std::atomic<int>* const lits{&lits_[i * max_clause_size_]};
+  for (size_t j = 0; j < clause.size(); ++j) {
+    lits[j].store(clause[j], memory_order_relaxed);
+  }
+  slot.seq.store(2 * pos + 2, memory_order_release);
+  stat.increase_num_published();
+  return true;
+}
+
+vector<vector<int>> ClauseExchange::Collect(const int worker,
+                                            uint64_t* const cursor) const {
+  DREAL_ASSERT(cursor != nullptr);
+  auto& stat = exchange_stat();
+  vector<vector<int>> clauses;
+  const uint64_t head{head_.load(memory_order_acquire)};
+  if (head - *cursor > static_cast<uint64_t>(capacity_)) {
+    // The oldest clauses have been overwritten already.
+    stat.increase_num_lost();
+    *cursor = head - capacity_;
+  }
+  for (; *cursor < head; ++*cursor) {
+    const uint64_t pos{*cursor};
+    const size_t i = pos % capacity_;
+    const Slot& slot{slots_[i]};
+    const uint64_t seq{slot.seq.load(memory_order_acquire)};
+    if (seq == 2 * pos + 1) {
+      // Still being written. Come back to it next time.
+      break;
+    }
+    if (seq != 2 * pos + 2) {
+      // Either dropped by its writer, or overwritten.
+      continue;
+    }
+    const int clause_worker{slot.worker.load(memory_order_relaxed)};
+    const int size{slot.size.load(memory_order_relaxed)};
+    vector<int> clause(size);
+    const std::atomic<int>* const lits{&lits_[i * max_clause_size_]};
+    for (int j = 0; j < size; ++j) {
+      clause[j] = lits[j].load(memory_order_relaxed);
+    }
+    std::atomic_thread_fence(memory_order_acquire);
+    if (slot.seq.load(memory_order_relaxed) != seq) {
+      // Overwritten while it was read.
+      stat.increase_num_lost();
+      continue;
+    }
+    if (clause_worker != worker) {
+      stat.increase_num_collected();
+      clauses.push_back(std::move(clause));
+    }
+  }
+  return clauses;
+}
+
+}  // namespace dreal
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "dreal/symbolic/symbolic.h"
+
+namespace dreal {
+
+/// Bounded buffer through which the workers of a portfolio broadcast the
+/// clauses they learn to each other.
+///
+/// A clause is a list of non-zero integers, `id + 1` for an atom and
+/// `-(id + 1)` for its negation. The ids are given by AtomId(), and are the
+/// same in every worker, whatever Boolean variable each of them uses for the
+/// atom.
+///
+/// The clauses are kept in a ring of `capacity` slots, which is lock-free:
+/// Publish() claims the next slot with an atomic counter, and each slot is
+/// guarded by a sequence number so that Collect() can tell whether it read a
+/// complete clause. Sharing is best-effort. A clause which is overwritten
+/// before a worker reads it is lost for that worker, and Publish() drops a
+/// clause rather than wait for a slot which is being written.
+///
+/// The table of atoms is protected by a mutex. Workers are expected to cache
+/// the ids, since the set of atoms is small compared to the number of
+/// clauses.
+class ClauseExchange {
+ public:
+  /// Constructs a buffer of @p capacity clauses of at most @p
+  /// max_clause_size literals.
+  ClauseExchange(int capacity, int max_clause_size);
+
+  ClauseExchange(const ClauseExchange&) = delete;
+  ClauseExchange(ClauseExchange&&) = delete;
+  ClauseExchange& operator=(const ClauseExchange&) = delete;
+  ClauseExchange& operator=(ClauseExchange&&) = delete;
+  ~ClauseExchange() = default;
+
+  int capacity() const { return capacity_; }
+  int max_clause_size() const { return max_clause_size_; }
+
+  /// Returns the id of @p atom, registering it if needed.
+  int AtomId(const Formula& atom);
+
+  /// Returns the atom whose id is @p id.
+  Formula atom(int id) const;
+
+  /// Broadcasts @p clause on behalf of @p worker.
+  ///
+  /// @returns false if the clause was dropped, because it is empty or longer
+  /// than max_clause_size(), or because its slot is being written.
+  bool Publish(int worker, const std::vector<int>& clause);
+
+  /// Returns the clauses published by the workers other than @p worker
+  /// since the position @p cursor, which is then moved to the end of the
+  /// buffer. A cursor starts at zero.
+  std::vector<std::vector<int>> Collect(int worker, uint64_t* cursor) const;
+
+ private:
+  // The sequence number of the slot which holds the clause at position
+  // `pos` is 2 * pos + 1 while it is written, and 2 * pos + 2 once done.
+  struct Slot {
+    std::atomic<uint64_t> seq{0};
+    std::atomic<int> worker{-1};
+    std::atomic<int> size{0};
+  };
+
+  const int capacity_;
+  const int max_clause_size_;
+  std::atomic<uint64_t> head_{0};
+  std::unique_ptr<Slot[]> slots_;
+  // The literals of slot i are lits_[i * max_clause_size_, ...].
+  std::unique_ptr<std::atomic<int>[]> lits_;
+
+  mutable std::mutex atoms_mutex_;
+  std::unordered_map<Formula, int> atom_ids_;
+  std::deque<Formula> atoms_;
+};
+
+}  // namespace dreal
@@ -5,6 +5,7 @@
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 #include "dreal/util/logging.h"
 #include "dreal/util/nnfizer.h"
@@ -13,6 +14,7 @@
 
 using std::cout;
 using std::set;
+using std::string;
 using std::to_string;
 using std::unordered_set;
 
@@ -31,6 +33,8 @@ class IfThenElseElimStat : public Stat {
       using fmt::print;
       print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of Process",
             "ITE Elim", num_process_);
+      print(cout, "{:<45} @ {:<20} = {:>15}\n", "Total # of shared terms",
+            "ITE Elim", num_shared_terms_);
       if (num_process_ > 0) {
         print(cout, "{:<45} @ {:<20} = {:>15f} sec\n",
               "Total time spent in Processing", "ITE Elim",
@@ -40,19 +44,119 @@ class IfThenElseElimStat : public Stat {
   }
 
   void increase_num_process() { increase(&num_process_); }
+  void add_num_shared_terms(const int n) {
+    if (enabled()) {
+      num_shared_terms_ += n;
+    }
+  }
 
   Timer timer_process_;
 
  private:
   std::atomic<int> num_process_{0};
+  std::atomic<int> num_shared_terms_{0};
 };
 
+namespace {
+
+// Returns a new continuous variable, named @p prefix followed by a number.
+Variable MakeVariable(const string& prefix) {
+  // Several contexts may eliminate terms concurrently.
+  static std::atomic<int> counter{0};
+  return Variable{prefix + to_string(counter++), Variable::Type::CONTINUOUS};
+}
+
+// Adds c * [lb, ub] to [*lb_out, *ub_out].
+void AddScaled(const mpq_class& c, const mpq_class& lb, const mpq_class& ub,
+               mpq_class* const lb_out, mpq_class* const ub_out) {
+  if (c >= 0) {
+    *lb_out += c * lb;
+    *ub_out += c * ub;
+  } else {
+    *lb_out += c * ub;
+    *ub_out += c * lb;
+  }
+}
+
+// Computes an enclosure [*lb, *ub] of @p e over @p box.
+//
+// @returns false if @p e is not linear, or if one of its variables is not in
+// @p box.
+bool Enclose(const Expression& e, const Box& box, mpq_class* const lb,
+             mpq_class* const ub) {
+  if (is_constant(e)) {
+    *lb = *ub = get_constant_value(e);
+    return true;
+  }
+  if (is_variable(e)) {
+    const Variable& var{get_variable(e)};
+    if (!box.has_variable(var)) {
+      return false;
+    }
+    *lb = box[var].lb();
+    *ub = box[var].ub();
+    return true;
+  }
+  mpq_class lb_i;
+  mpq_class ub_i;
+  if (is_addition(e)) {
+    // e = c₀ + ∑ᵢ cᵢ * eᵢ
+    *lb = *ub = get_constant_in_addition(e);
+    for (const auto& p : get_expr_to_coeff_map_in_addition(e)) {
+      if (!Enclose(p.first, box, &lb_i, &ub_i)) {
+        return false;
+      }
+      AddScaled(p.second, lb_i, ub_i, lb, ub);
+    }
+    return true;
+  }
+  if (is_multiplication(e)) {
+    // e = c₀ * e₁
+    const auto& base_to_exponent{get_base_to_exponent_map_in_multiplication(e)};
+    if (base_to_exponent.size() != 1) {
+      return false;
+    }
+    const Expression& exponent{base_to_exponent.begin()->second};
+    if (!is_constant(exponent) || get_constant_value(exponent) != 1 ||
+        !Enclose(base_to_exponent.begin()->first, box, &lb_i, &ub_i)) {
+      return false;
+    }
+    *lb = *ub = 0;
+    AddScaled(get_constant_in_multiplication(e), lb_i, ub_i, lb, ub);
+    return true;
+  }
+  return false;
+}
+
+// Returns the guard under which the min, max or abs term @p e, found under
+// @p guard, is cached. The term itself is not guarded, but the definitions of
+// the ite terms in its arguments only hold under @p guard.
+Formula MinMaxGuard(const Expression& e, const Formula& guard) {
+  return e.include_ite() ? guard : Formula::True();
+}
+
+}  // namespace
+
 Formula IfThenElseEliminator::Process(const Formula& f) {
+  return Eliminate(f, nullptr);
+}
+
+Formula IfThenElseEliminator::Process(const Formula& f, const Box& box) {
+  return Eliminate(f, &box);
+}
+
+Formula IfThenElseEliminator::Eliminate(const Formula& f,
+                                        const Box* const box) {
   static IfThenElseElimStat stat{DREAL_LOG_INFO_ENABLED};
   TimerGuard timer_guard(&stat.timer_process_, stat.enabled());
   stat.increase_num_process();
 
+  box_ = box;
+  added_formulas_.clear();
+  ite_variables_.clear();
+  const int num_shared_terms{num_shared_terms_};
   Formula new_f{Visit(f, Formula::True())};
+  stat.add_num_shared_terms(num_shared_terms_ - num_shared_terms);
   if (f.EqualTo(new_f) && added_formulas_.empty()) {
     return f;
   } else {
@@ -60,6 +164,10 @@ Formula IfThenElseEliminator::Process(const Formula& f) {
   }
 }
 
+void IfThenElseEliminator::Push() { terms_.push(); }
+
+void IfThenElseEliminator::Pop() { terms_.pop(); }
+
 const unordered_set<Variable, hash_value<Variable>>&
 IfThenElseEliminator::variables() const {
   return ite_variables_;
@@ -67,13 +175,31 @@ IfThenElseEliminator::variables() const {
 
 Expression IfThenElseEliminator::Visit(const Expression& e,
                                        const Formula& guard) {
-  if (e.include_ite()) {
+  // min, max and abs are not polynomial.
+  if (e.include_ite() || !e.is_polynomial()) {
     return VisitExpression<Expression>(this, e, guard);
   } else {
     return e;
   }
 }
 
+const Expression* IfThenElseEliminator::LookUpTerm(const Expression& e,
+                                                   const Formula& guard) {
+  const auto it = terms_.find(GuardedTerm{guard, e});
+  if (it == terms_.end()) {
+    return nullptr;
+  }
+  ++num_shared_terms_;
+  return &it->second;
+}
+
+Expression IfThenElseEliminator::AddTerm(const Expression& e,
+                                         const Formula& guard,
+                                         const Expression& term) {
+  terms_.insert(GuardedTerm{guard, e}, term);
+  return term;
+}
+
 Expression IfThenElseEliminator::VisitVariable(const Expression& e,
                                                const Formula&) {
   return e;
@@ -121,7 +247,12 @@ Expression IfThenElseEliminator::VisitLog(const Expression& e,
 
 Expression IfThenElseEliminator::VisitAbs(const Expression& e,
                                           const Formula& guard) {
-  return abs(Visit(get_argument(e), guard));
+  const Formula term_guard{MinMaxGuard(e, guard)};
+  if (const Expression* const term{LookUpTerm(e, term_guard)}) {
+    return *term;
+  }
+  const Expression arg{Visit(get_argument(e), guard)};
+  return AddTerm(e, term_guard, LowerMinMax(arg, -arg, true, "ABS"));
 }
 
 Expression IfThenElseEliminator::VisitExp(const Expression& e,
@@ -193,21 +324,60 @@ Expression IfThenElseEliminator::VisitTanh(const Expression& e,
 
 Expression IfThenElseEliminator::VisitMin(const Expression& e,
                                           const Formula& guard) {
-  return min(Visit(get_first_argument(e), guard),
-             Visit(get_second_argument(e), guard));
+  const Formula term_guard{MinMaxGuard(e, guard)};
+  if (const Expression* const term{LookUpTerm(e, term_guard)}) {
+    return *term;
+  }
+  return AddTerm(e, term_guard,
+                 LowerMinMax(Visit(get_first_argument(e), guard),
+                             Visit(get_second_argument(e), guard), false, "MIN"));
 }
 
 Expression IfThenElseEliminator::VisitMax(const Expression& e,
                                           const Formula& guard) {
-  return max(Visit(get_first_argument(e), guard),
-             Visit(get_second_argument(e), guard));
+  const Formula term_guard{MinMaxGuard(e, guard)};
+  if (const Expression* const term{LookUpTerm(e, term_guard)}) {
+    return *term;
+  }
+  return AddTerm(e, term_guard,
+                 LowerMinMax(Visit(get_first_argument(e), guard),
+                             Visit(get_second_argument(e), guard), true, "MAX"));
+}
+
+Expression IfThenElseEliminator::LowerMinMax(const Expression& e1,
+                                             const Expression& e2,
+                                             const bool is_max,
+                                             const string& prefix) {
+  mpq_class lb;
+  mpq_class ub;
+  if (box_ != nullptr && Enclose(e1 - e2, *box_, &lb, &ub)) {
+    // The phase is already decided by the domains.
+    if (lb >= 0) {
+      return is_max ? e1 : e2;
+    }
+    if (ub <= 0) {
+      return is_max ? e2 : e1;
+    }
+  }
+  const Variable new_var{MakeVariable(prefix)};
+  ite_variables_.insert(new_var);
+  // The case split does not need a guard, since min and max are total. The
+  // bounds v ≥ eᵢ (or v ≤ eᵢ) are implied by it, but they already constrain
+  // v in the LP before the phase is decided.
+  const Formula phase{is_max ? e1 >= e2 : e1 <= e2};
+  added_formulas_.push_back(!phase || (new_var == e1));
+  added_formulas_.push_back(phase || (new_var == e2));
+  added_formulas_.push_back(is_max ? new_var >= e1 : new_var <= e1);
+  added_formulas_.push_back(is_max ? new_var >= e2 : new_var <= e2);
+  return new_var;
 }
 
 Expression IfThenElseEliminator::VisitIfThenElse(const Expression& e,
                                                  const Formula& guard) {
-  static int counter{0};
-  const Variable new_var{"ITE" + to_string(counter++),
-                         Variable::Type::CONTINUOUS};
+  if (const Expression* const term{LookUpTerm(e, guard)}) {
+    return *term;
+  }
+  const Variable new_var{MakeVariable("ITE")};
   ite_variables_.insert(new_var);
   const Formula c{Visit(get_conditional_formula(e), guard)};
   const Formula then_guard{guard && c};
@@ -216,7 +386,7 @@ Expression IfThenElseEliminator::VisitIfThenElse(const Expression& e,
   const Expression e2{Visit(get_else_expression(e), else_guard)};
   added_formulas_.push_back(!then_guard || (new_var == e1));  // then_guard => (new_var = e1)
   added_formulas_.push_back(!else_guard || (new_var == e2));  // else_guard => (new_var = e2)
-  return new_var;
+  return AddTerm(e, guard, new_var);
 }
 
 Expression IfThenElseEliminator::VisitUninterpretedFunction(const Expression& e,
@@ -1,14 +1,32 @@
 #pragma once
 
+#include <string>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "dreal/symbolic/symbolic.h"
+#include "dreal/util/box.h"
+#include "dreal/util/scoped_unordered_map.h"
 
 namespace dreal {
 
 /// Eliminates If-Then-Else expressions by introducing new variables.
 ///
+/// The piecewise-linear functions `min`, `max` and `abs` are lowered in the
+/// same way, so that the LP solvers only see linear atoms: `max(e₁, e₂)` is
+/// replaced by a new variable `v` with
+///
+///     (e₁ ≥ e₂ → v = e₁) ∧ (¬(e₁ ≥ e₂) → v = e₂) ∧ v ≥ e₁ ∧ v ≥ e₂,
+///
+/// where the atom `e₁ ≥ e₂` is the phase of the term, which is decided by
+/// the SAT solver. `min(e₁, e₂)` is lowered symmetrically and `abs(e)` as
+/// `max(e, -e)`.
+///
+/// The repeated occurrences of a term under the same guard share one
+/// variable and its definition, also across the calls of Process(). The
+/// shared terms can be scoped with Push() and Pop().
+///
 /// TODO(soonho): Check "Efficient Term ITE Conversion for
 /// Satisfiability Modulo Theories", H. Kim, F. Somenzi,
 /// H. Jin. Twelfth International Conference on Theory and
@@ -17,10 +35,34 @@ class IfThenElseEliminator {
  public:
   /// Returns a equisatisfiable formula by eliminating
   /// if-then-expressions in @p f by introducing new variables.
+  ///
+  /// A term which was eliminated by a previous call, in the current scope,
+  /// is replaced by the same variable, whose definition is not added again.
   Formula Process(const Formula& f);
+
+  /// Similar to Process(f), but uses the domains of @p box to fix the phase
+  /// of the `min`, `max` and `abs` terms whose linear arguments are ordered
+  /// over @p box, e.g. `max(x, 0)` with `x ∈ [1, 2]` is replaced by `x`.
+  ///
+  /// @note @p box may only shrink until the matching Pop(), since the terms
+  /// whose phase it fixes are shared.
+  Formula Process(const Formula& f, const Box& box);
+
+  /// Opens a scope. The terms which are eliminated after it are forgotten
+  /// by the matching Pop().
+  void Push();
+
+  /// Forgets the terms eliminated since the matching Push().
+  void Pop();
+
+  /// Returns the variables introduced by the last call of Process().
   const std::unordered_set<Variable, hash_value<Variable>>& variables() const;
 
  private:
+  // Eliminates the terms of @p f, using the domains of @p box if it is not
+  // nullptr.
+  Formula Eliminate(const Formula& f, const Box* box);
+
   // Handle expressions.
   Expression Visit(const Expression& e, const Formula& guard);
   Expression VisitVariable(const Expression& e, const Formula& guard);
@@ -49,6 +91,19 @@ class IfThenElseEliminator {
   Expression VisitUninterpretedFunction(const Expression& e,
                                         const Formula& guard);
 
+  // Returns the term which replaces @p e under @p guard, if @p e has already
+  // been eliminated under @p guard, or nullptr.
+  const Expression* LookUpTerm(const Expression& e, const Formula& guard);
+
+  // Records that @p term replaces @p e under @p guard, and returns it.
+  Expression AddTerm(const Expression& e, const Formula& guard,
+                     const Expression& term);
+
+  // Returns a term equal to max(e1, e2) if @p is_max, or to min(e1, e2)
+  // otherwise. @p prefix is the name of the new variable, if any.
+  Expression LowerMinMax(const Expression& e1, const Expression& e2,
+                         bool is_max, const std::string& prefix);
+
   // Handle formula
   Formula Visit(const Formula& f, const Formula& guard);
   Formula VisitFalse(const Formula& f, const Formula& guard);
@@ -69,10 +124,29 @@ class IfThenElseEliminator {
   // Member fields
   // ---------------
 
+  // The domains used by the running Process() to fix the phase of the
+  // min/max/abs terms, or nullptr.
+  const Box* box_{nullptr};
+
   // The added formulas introduced by the elimination process.
   std::vector<Formula> added_formulas_;
   // The variables introduced by the elimination process.
   std::unordered_set<Variable, hash_value<Variable>> ite_variables_;
+  // An eliminated term, with the guard under which it was found.
+  using GuardedTerm = std::pair<Formula, Expression>;
+  struct GuardedTermEqual {
+    bool operator()(const GuardedTerm& t1, const GuardedTerm& t2) const {
+      return t1.first.EqualTo(t2.first) && t1.second.EqualTo(t2.second);
+    }
+  };
+  // The terms which replace the eliminated ones. The min, max and abs terms
+  // use the guard True, since they are not guarded, unless they include an
+  // ite term.
+  ScopedUnorderedMap<GuardedTerm, Expression, hash_value<GuardedTerm>,
+                     GuardedTermEqual>
+      terms_;
+  // The number of terms found in terms_.
+  int num_shared_terms_{0};
 
   // Makes VisitFormula a friend of this class so that it can use private
   // operator()s.
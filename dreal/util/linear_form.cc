@@ -0,0 +1,126 @@
+#include "dreal/util/linear_form.h"
+
+#include <cstddef>
+#include <utility>
+
+#include "dreal/util/exception.h"
+
+namespace dreal {
+
+using std::pair;
+
+bool LinearFormExtractor::Extract(const Expression& e,
+                                  const std::map<Variable::Id, int>& to_col) {
+  Clear();
+  to_col_ = &to_col;
+  if (!Visit(e, mpq_class{1})) {
+    return false;
+  }
+  Finish();
+  return true;
+}
+
+bool LinearFormExtractor::Extract(const Expression& lhs, const Expression& rhs,
+                                  const std::map<Variable::Id, int>& to_col) {
+  Clear();
+  to_col_ = &to_col;
+  if (!Visit(lhs, mpq_class{1}) || !Visit(rhs, mpq_class{-1})) {
+    return false;
+  }
+  Finish();
+  return true;
+}
+
+void LinearFormExtractor::Clear() {
+  for (const int col : columns_) {
+    position_[col] = -1;
+  }
+  columns_.clear();
+  coefficients_.clear();
+  constant_ = 0;
+}
+
+bool LinearFormExtractor::Visit(const Expression& e, const mpq_class& scale) {
+  switch (e.get_kind()) {
+    case ExpressionKind::Constant:
+      constant_ += scale * get_constant_value(e);
+      return true;
+    case ExpressionKind::Var:
+      AddTerm(get_variable(e), scale);
+      return true;
+    case ExpressionKind::Add: {
+      constant_ += scale * get_constant_in_addition(e);
+      mpq_class term_scale;
+      for (const pair<const Expression, mpq_class>& p :
+           get_expr_to_coeff_map_in_addition(e)) {
+        term_scale = scale * p.second;
+        if (!Visit(p.first, term_scale)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case ExpressionKind::Mul: {
+      // c · b₁^e₁ · ... · bₙ^eₙ is linear if n = 1 and e₁ = 1.
+      const std::map<Expression, Expression>& base_to_exponent{
+          get_base_to_exponent_map_in_multiplication(e)};
+      if (base_to_exponent.size() != 1) {
+        return false;
+      }
+      const Expression& exponent{base_to_exponent.begin()->second};
+      if (!is_constant(exponent) || get_constant_value(exponent) != 1) {
+        return false;
+      }
+      return Visit(base_to_exponent.begin()->first,
+                   scale * get_constant_in_multiplication(e));
+    }
+    case ExpressionKind::Div: {
+      const Expression& divisor{get_second_argument(e)};
+      if (!is_constant(divisor) || get_constant_value(divisor) == 0) {
+        return false;
+      }
+      return Visit(get_first_argument(e), scale / get_constant_value(divisor));
+    }
+    default:
+      return false;
+  }
+}
+
+void LinearFormExtractor::AddTerm(const Variable& var, const mpq_class& coeff) {
+  const auto it = to_col_->find(var.get_id());
+  if (it == to_col_->end()) {
+    throw DREAL_RUNTIME_ERROR("Variable undefined: {}", var);
+  }
+  const int col{it->second};
+  if (static_cast<size_t>(col) >= position_.size()) {
+    position_.resize(col + 1, -1);
+  }
+  if (position_[col] < 0) {
+    position_[col] = columns_.size();
+    columns_.push_back(col);
+    coefficients_.push_back(coeff);
+  } else {
+    coefficients_[position_[col]] += coeff;
+  }
+}
+
+void LinearFormExtractor::Finish() {
+  // Drop the coefficients which cancelled out, e.g. in `x + y - x`.
+  size_t j{0};
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    if (coefficients_[i] == 0) {
+      position_[columns_[i]] = -1;
+      continue;
+    }
+    if (i != j) {
+      position_[columns_[i]] = j;
+      columns_[j] = columns_[i];
+      coefficients_[j] = std::move(coefficients_[i]);
+    }
+    ++j;
+  }
+  columns_.resize(j);
+  coefficients_.resize(j);
+}
+
+}  // namespace dreal
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include "dreal/symbolic/symbolic.h"
+
+namespace dreal {
+
+/// Extracts the linear form `c₁x₁ + ... + cₙxₙ + c₀` of an expression, where
+/// the variables xᵢ are given as LP columns.
+///
+/// The expression is walked once, without expanding it. Additions are
+/// distributed over their terms, and a multiplication (or a division) is
+/// only accepted when all its factors but one are constants. The walk stops
+/// at the first term which is not linear. The coefficients of a column which
+/// occurs several times are merged, and the ones which cancel out are
+/// dropped, so that the result is a sparse vector with distinct columns.
+///
+/// An extractor keeps its buffers between calls, so that the LP backends
+/// can use a single one for all the atoms they encode.
+class LinearFormExtractor {
+ public:
+  /// Computes the linear form of @p e. @p to_col maps the id of each
+  /// variable to its column.
+  ///
+  /// @returns false if @p e is not syntactically linear, for instance
+  /// `x * (y + 1) - x * y`. The result is then unspecified.
+  /// @throws std::runtime_error if a variable of @p e has no column.
+  bool Extract(const Expression& e, const std::map<Variable::Id, int>& to_col);
+
+  /// Computes the linear form of `lhs - rhs`, without building it.
+  /// @see Extract(const Expression&, const std::map<Variable::Id, int>&).
+  bool Extract(const Expression& lhs, const Expression& rhs,
+               const std::map<Variable::Id, int>& to_col);
+
+  /// Returns the columns with a non-zero coefficient, in the order in which
+  /// they first occur in the expression.
+  const std::vector<int>& columns() const { return columns_; }
+
+  /// Returns the coefficients of columns(), which are all non-zero.
+  const std::vector<mpq_class>& coefficients() const { return coefficients_; }
+
+  /// Returns the constant term c₀.
+  const mpq_class& constant() const { return constant_; }
+
+ private:
+  void Clear();
+  bool Visit(const Expression& e, const mpq_class& scale);
+  void AddTerm(const Variable& var, const mpq_class& coeff);
+  void Finish();
+
+  const std::map<Variable::Id, int>* to_col_{nullptr};
+  std::vector<int> columns_;
+  std::vector<mpq_class> coefficients_;
+  mpq_class constant_;
+  // position_[col] is the index of `col` in columns_, or -1. It is reset
+  // after each extraction, which only touches the columns it used.
+  std::vector<int> position_;
+};
+
+}  // namespace dreal
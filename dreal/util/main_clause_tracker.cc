@@ -0,0 +1,132 @@
+#include "dreal/util/main_clause_tracker.h"
+
+#include <algorithm>
+
+#include "dreal/util/assert.h"
+
+namespace dreal {
+
+using std::vector;
+
+void MainClauseTracker::AddLiteral(const int lit) {
+  DREAL_ASSERT(lit != 0);
+  literals_.push_back(lit);
+  indexed_ = false;
+}
+
+void MainClauseTracker::EndClause() {
+  literals_.push_back(0);
+  ++num_clauses_;
+  indexed_ = false;
+}
+
+void MainClauseTracker::Resize(const size_t size) {
+  DREAL_ASSERT(size <= literals_.size());
+  DREAL_ASSERT(size == 0 || literals_[size - 1] == 0);
+  if (size == literals_.size()) {
+    return;
+  }
+  num_clauses_ -= std::count(literals_.begin() + size, literals_.end(), 0);
+  literals_.resize(size);
+  indexed_ = false;
+}
+
+void MainClauseTracker::BuildOccurrences() {
+  size_t num_indices{2};
+  for (const int lit : literals_) {
+    num_indices = std::max(num_indices, Index(lit) + 1);
+  }
+  // Counts the occurrences of each literal, in occurrence_start_[i + 1].
+  // last_clause[i] detects a literal repeated in a clause.
+  occurrence_start_.assign(num_indices + 1, 0);
+  vector<int> last_clause(num_indices, -1);
+  int clause{0};
+  for (const int lit : literals_) {
+    if (lit == 0) {
+      ++clause;
+    } else if (last_clause[Index(lit)] != clause) {
+      last_clause[Index(lit)] = clause;
+      ++occurrence_start_[Index(lit) + 1];
+    }
+  }
+  for (size_t i = 1; i <= num_indices; ++i) {
+    occurrence_start_[i] += occurrence_start_[i - 1];
+  }
+  // Fills the occurrences. next[i] is the next free slot of the literal.
+  occurrences_.resize(occurrence_start_[num_indices]);
+  vector<int> next(occurrence_start_.begin(), occurrence_start_.end() - 1);
+  std::fill(last_clause.begin(), last_clause.end(), -1);
+  clause = 0;
+  for (const int lit : literals_) {
+    if (lit == 0) {
+      ++clause;
+    } else if (last_clause[Index(lit)] != clause) {
+      last_clause[Index(lit)] = clause;
+      occurrences_[next[Index(lit)]++] = clause;
+    }
+  }
+  indexed_ = true;
+}
+
+const vector<int>& MainClauseTracker::GetActiveLiterals(
+    const int num_vars, const std::function<int(int)>& deref) {
+  if (!indexed_) {
+    BuildOccurrences();
+  }
+  const size_t num_indices{occurrence_start_.size() - 1};
+  const auto occurrences_begin = [this, num_indices](const int lit) {
+    const size_t i{std::min(Index(lit), num_indices)};
+    return occurrences_.begin() + occurrence_start_[i];
+  };
+  const auto occurrences_end = [this, num_indices](const int lit) {
+    const size_t i{std::min(Index(lit) + 1, num_indices)};
+    return occurrences_.begin() + occurrence_start_[i];
+  };
+
+  // Number of true literals in each clause.
+  values_.assign(num_vars + 1, 0);
+  true_count_.assign(num_clauses_, 0);
+  for (int v = 1; v <= num_vars; ++v) {
+    const int value{deref(v)};
+    if (value == 0) {
+      continue;
+    }
+    values_[v] = value > 0 ? v : -v;
+    for (auto it = occurrences_begin(values_[v]);
+         it != occurrences_end(values_[v]); ++it) {
+      ++true_count_[*it];
+    }
+  }
+
+  // A literal is required if it is the last true literal of a clause, once
+  // the literals before it have been dropped.
+  active_.clear();
+  const auto visit = [&](const int lit) {
+    const auto begin = occurrences_begin(lit);
+    const auto end = occurrences_end(lit);
+    const bool required{std::any_of(
+        begin, end, [this](const int c) { return true_count_[c] == 1; })};
+    if (required) {
+      active_.push_back(lit);
+      return;
+    }
+    for (auto it = begin; it != end; ++it) {
+      --true_count_[*it];
+    }
+  };
+  // Increasing order: the false variables from the largest one, and then the
+  // true variables from the smallest one.
+  for (int v = num_vars; v >= 1; --v) {
+    if (values_[v] < 0) {
+      visit(values_[v]);
+    }
+  }
+  for (int v = 1; v <= num_vars; ++v) {
+    if (values_[v] > 0) {
+      visit(values_[v]);
+    }
+  }
+  return active_;
+}
+
+}  // namespace dreal
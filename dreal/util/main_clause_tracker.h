@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace dreal {
+
+/// Keeps a copy of the main (non-learned) clauses given to a SAT solver, to
+/// find which literals of a model are needed to satisfy them.
+///
+/// The clauses are stored in a flat array of literals, each clause ending
+/// with 0. The occurrences of each literal are indexed in a second flat
+/// array, which is only rebuilt when clauses have been added or removed
+/// since the last query.
+class MainClauseTracker {
+ public:
+  /// Appends @p lit to the clause being added.
+  void AddLiteral(int lit);
+
+  /// Ends the clause being added.
+  void EndClause();
+
+  /// Returns the size of the flat array of clauses, to be given to Resize()
+  /// in order to forget the clauses added afterwards.
+  size_t size() const { return literals_.size(); }
+
+  /// Forgets the clauses added since size() was @p size.
+  void Resize(size_t size);
+
+  /// Returns the literals of the model which are needed to satisfy the main
+  /// clauses, in increasing order. @p deref gives the value of each variable
+  /// in 1..@p num_vars: positive if it is true, negative if it is false and 0
+  /// if it is unassigned.
+  ///
+  /// The literals are visited in increasing order, and a literal is dropped
+  /// if every clause which contains it still has another true literal. The
+  /// result is an irredundant subset of the model which satisfies all the
+  /// main clauses. The returned vector is reused by the next call.
+  const std::vector<int>& GetActiveLiterals(
+      int num_vars, const std::function<int(int)>& deref);
+
+ private:
+  // Position of a literal in occurrence_start_.
+  static size_t Index(const int lit) {
+    return lit > 0 ? 2 * static_cast<size_t>(lit)
+                   : 2 * static_cast<size_t>(-lit) + 1;
+  }
+
+  // Builds occurrence_start_ and occurrences_ from literals_.
+  void BuildOccurrences();
+
+  // Flat array of the clauses, each of them ending with 0.
+  std::vector<int> literals_;
+  int num_clauses_{0};
+  // Whether occurrence_start_ and occurrences_ match literals_.
+  bool indexed_{false};
+  // The clauses containing a literal `l` are occurrences_[i] for i in
+  // [occurrence_start_[Index(l)], occurrence_start_[Index(l) + 1]). A clause
+  // which contains a literal twice is only listed once.
+  std::vector<int> occurrence_start_;
+  std::vector<int> occurrences_;
+
+  // Buffers for GetActiveLiterals(), kept between calls.
+  std::vector<int> values_;
+  std::vector<int> true_count_;
+  std::vector<int> active_;
+};
+
+}  // namespace dreal
@@ -66,9 +66,21 @@ vector<Formula> PlaistedGreenbaumCnfizer::Convert(const Formula& f) {
   return aux_;
 }
 
+void PlaistedGreenbaumCnfizer::Push() { definitions_.push(); }
+
+void PlaistedGreenbaumCnfizer::Pop() { definitions_.pop(); }
+
 Formula PlaistedGreenbaumCnfizer::Visit(const Formula& f) {
-  // TODO(soonho): use cache.
-  return VisitFormula<Formula>(this, f);
+  if (!is_conjunction(f) && !is_disjunction(f) && !is_forall(f)) {
+    return VisitFormula<Formula>(this, f);
+  }
+  const auto it = definitions_.find(f);
+  if (it != definitions_.end()) {
+    return Formula{it->second};
+  }
+  const Formula bvar{VisitFormula<Formula>(this, f)};
+  definitions_.insert(f, get_variable(bvar));
+  return bvar;
 }
 
 Formula PlaistedGreenbaumCnfizer::VisitFalse(const Formula& f) { return f; }
@@ -85,7 +97,7 @@ Formula PlaistedGreenbaumCnfizer::VisitLessThanOrEqualTo(const Formula& f) { ret
 
 Formula PlaistedGreenbaumCnfizer::VisitForall(const Formula& f) {
   // We always need a variable
-  static size_t id{0};
+  static std::atomic<size_t> id{0};
   const Variable bvar{string("forall") + to_string(id++),
                       Variable::Type::BOOLEAN};
   vars_.push_back(bvar);
@@ -125,7 +137,7 @@ Formula PlaistedGreenbaumCnfizer::VisitForall(const Formula& f) {
 // TODO: flatten nested conjunctions and disjunctions?
 
 Formula PlaistedGreenbaumCnfizer::VisitConjunction(const Formula& f) {
-  static size_t id{0};
+  static std::atomic<size_t> id{0};
   // Introduce a new Boolean variable, `bvar` for `f`.
   const Variable bvar{string("conj") + to_string(id++),
                       Variable::Type::BOOLEAN};
@@ -137,7 +149,7 @@ Formula PlaistedGreenbaumCnfizer::VisitConjunction(const Formula& f) {
 }
 
 Formula PlaistedGreenbaumCnfizer::VisitDisjunction(const Formula& f) {
-  static size_t id{0};
+  static std::atomic<size_t> id{0};
   // Introduce a new Boolean variable, `bvar` for `f`.
   const Variable bvar{string("disj") + to_string(id++),
                       Variable::Type::BOOLEAN};
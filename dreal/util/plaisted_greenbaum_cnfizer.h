@@ -6,16 +6,33 @@
 
 #include "dreal/symbolic/symbolic.h"
 #include "dreal/util/naive_cnfizer.h"
+#include "dreal/util/scoped_unordered_map.h"
 
 namespace dreal {
 /// Transforms a symbolic formula @p f into an equi-satisfiable CNF
 /// formula by introducing extra Boolean variables (Plaisted-Greenbaum
 /// transformation: https://doi.org/10.1016/S0747-7171(86)80028-1).
+///
+/// The definitions are kept across calls to Convert, so that a subformula
+/// which occurs in several formulas is encoded once. As the formulas are in
+/// negation normal form, every subformula occurs positively and only needs
+/// the definition `b → subformula`. A subformula which also occurs under a
+/// negation has a different normal form, which gets its own variable.
 class PlaistedGreenbaumCnfizer {
  public:
   /// Convert @p f into an equi-satisfiable formula @c f' in CNF.
+  ///
+  /// @note The clauses may use the variables defined by the previous calls,
+  /// and are only equi-satisfiable with @p f together with their clauses.
   std::vector<Formula> Convert(const Formula& f);
 
+  /// Opens a scope. The definitions which are added after it are forgotten
+  /// by the matching Pop(), together with the clauses defining them.
+  void Push();
+
+  /// Forgets the definitions added since the matching Push().
+  void Pop();
+
   /// Returns a const reference of `map_` member.
   ///
   /// @note that this member `map_` is cleared at the beginning of `Convert`
@@ -55,6 +72,10 @@ class PlaistedGreenbaumCnfizer {
   // call.
   std::vector<Variable> vars_;
 
+  // The variable defined for each conjunction, disjunction and universal
+  // quantification in negation normal form.
+  ScopedUnorderedMap<Formula, Variable> definitions_;
+
   // Makes VisitFormula a friend of this class so that it can use private
   // operator()s.
   friend Formula drake::symbolic::VisitFormula<Formula, PlaistedGreenbaumCnfizer>(
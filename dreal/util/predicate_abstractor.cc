@@ -2,8 +2,11 @@
 
 #include <atomic>
 #include <iostream>
+#include <map>
 #include <set>
 #include <sstream>
+#include <string>
+#include <utility>
 
 #include "dreal/util/logging.h"
 #include "dreal/util/stat.h"
@@ -13,7 +16,9 @@ namespace dreal {
 
 using std::cout;
 using std::set;
+using std::string;
 using std::stringstream;
+using std::to_string;
 using std::vector;
 
 namespace {
@@ -46,6 +51,62 @@ class PredicateAbstractorStat : public Stat {
   std::atomic<int> num_convert_{0};
 };
 
+// Returns the canonical form of the atom @p f. A linear atom `e₁ ⋈ e₂`,
+// where ⋈ is one of `=, <, ≤`, is rewritten as `p ⋈ c` or `¬(p ⋈' c)`,
+// where `p = Σ aᵢxᵢ` has one as its first coefficient and `c` is a
+// constant. For example, `2x + 2y ≤ 6` becomes `x + y ≤ 3`, and `-x - y < -3`
+// becomes `¬(x + y ≤ 3)`. Other atoms are returned as they are.
+Formula Normalize(const Formula& f) {
+  if (!is_equal_to(f) && !is_less_than(f) && !is_less_than_or_equal_to(f)) {
+    return f;
+  }
+  const Expression e{
+      (get_lhs_expression(f) - get_rhs_expression(f)).Expand()};
+  // e = Σ aᵢxᵢ + k, as a list of (xᵢ, aᵢ) in the order of the variables.
+  std::vector<std::pair<Variable, mpq_class>> terms;
+  mpq_class k{0};
+  if (is_variable(e)) {
+    terms.emplace_back(get_variable(e), 1);
+  } else if (is_multiplication(e)) {
+    const std::map<Expression, Expression>& base_to_exp{
+        get_base_to_exponent_map_in_multiplication(e)};
+    if (base_to_exp.size() != 1 || !is_variable(base_to_exp.begin()->first) ||
+        !is_constant(base_to_exp.begin()->second) ||
+        get_constant_value(base_to_exp.begin()->second) != 1) {
+      return f;
+    }
+    terms.emplace_back(get_variable(base_to_exp.begin()->first),
+                       get_constant_in_multiplication(e));
+  } else if (is_addition(e)) {
+    for (const std::pair<const Expression, mpq_class>& p :
+         get_expr_to_coeff_map_in_addition(e)) {
+      if (!is_variable(p.first)) {
+        return f;
+      }
+      terms.emplace_back(get_variable(p.first), p.second);
+    }
+    k = get_constant_in_addition(e);
+  } else {
+    // Constant or non-linear.
+    return f;
+  }
+  const mpq_class lead{terms.front().second};
+  Expression p{Expression::Zero()};
+  for (const std::pair<Variable, mpq_class>& term : terms) {
+    p += Expression{mpq_class{term.second / lead}} * term.first;
+  }
+  const Expression c{mpq_class{-k / lead}};
+  if (is_equal_to(f)) {
+    return p == c;
+  }
+  if (lead > 0) {
+    return is_less_than(f) ? p < c : p <= c;
+  }
+  // Dividing by a negative number flips the relation: p > c ⇔ ¬(p ≤ c), and
+  // p ≥ c ⇔ ¬(p < c).
+  return is_less_than(f) ? !(p <= c) : !(p < c);
+}
+
 }  // namespace
 
 void PredicateAbstractor::Add(const Variable& var, const Formula& f) {
@@ -93,13 +154,21 @@ Formula PredicateAbstractor::VisitVariable(const Formula& f) {
 }
 
 Formula PredicateAbstractor::VisitAtomic(const Formula& f) {
+  // Atoms which only differ by a scaling factor, or by the side of their
+  // terms, share one Boolean variable.
+  const Formula normalized{Normalize(f)};
+  if (is_negation(normalized)) {
+    return !AbstractAtom(get_operand(normalized));
+  }
+  return AbstractAtom(normalized);
+}
+
+Formula PredicateAbstractor::AbstractAtom(const Formula& f) {
   // Leaf case: create a new Boolean variable `bvar` and record the
   // relation between `bvar` and `f`.
-  stringstream ss;
-  ss << "b(" << f << ")";
   auto it = formula_to_var_map_.find(f);
   if (it == formula_to_var_map_.end()) {
-    const Variable bvar{ss.str(), Variable::Type::BOOLEAN};
+    const Variable bvar{MakeAtomName(f), Variable::Type::BOOLEAN};
     Add(bvar, f);
     return Formula{bvar};
   } else {
@@ -107,6 +176,18 @@ Formula PredicateAbstractor::VisitAtomic(const Formula& f) {
   }
 }
 
+string PredicateAbstractor::MakeAtomName(const Formula& f) const {
+  if (DREAL_LOG_DEBUG_ENABLED) {
+    // Spell out the atom, so that the logs are readable.
+    stringstream ss;
+    ss << "b(" << f << ")";
+    return ss.str();
+  }
+  // Printing large atoms is costly. The atom of a variable can still be
+  // looked up with operator[].
+  return "b" + to_string(var_to_formula_map_.size());
+}
+
 Formula PredicateAbstractor::VisitEqualTo(const Formula& f) {
   return VisitAtomic(f);
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -16,6 +17,10 @@ class PredicateAbstractor {
   /// `x > 0` and `b₂` corresponds with `y < 0`. The class provides
   /// `operator[b]` which looks up the corresponding formula for a
   /// Boolean variable `b`.
+  ///
+  /// Linear atoms are normalized first, so that `2x + 2y ≤ 6`, `x + y ≤ 3`
+  /// and `3 ≥ x + y` are all abstracted by the same variable, which
+  /// corresponds with `x + y ≤ 3`.
   Formula Convert(const Formula& f);
 
   /// Converts @p formulas into a conjunction of Boolean formulas. See
@@ -27,6 +32,10 @@ class PredicateAbstractor {
     return var_to_formula_map_;
   }
 
+  const std::unordered_map<Formula, Variable>& formula_to_var_map() const {
+    return formula_to_var_map_;
+  }
+
   const Variable& operator[](const Formula& f) const {
     return formula_to_var_map_.at(f);
   }
@@ -41,6 +50,13 @@ class PredicateAbstractor {
   Formula VisitTrue(const Formula& f);
   Formula VisitVariable(const Formula& f);
   Formula VisitAtomic(const Formula& f);
+  // Returns the Boolean variable for the (normalized) atom @p f, creating
+  // it if needed.
+  Formula AbstractAtom(const Formula& f);
+  // Returns the name of a new Boolean variable for the atom @p f. It is only
+  // spelled out as `b(f)` when debug logging is enabled; otherwise, it is a
+  // compact `bN`, where N is the number of atoms so far.
+  std::string MakeAtomName(const Formula& f) const;
   Formula VisitEqualTo(const Formula& f);
   Formula VisitNotEqualTo(const Formula& f);
   Formula VisitGreaterThan(const Formula& f);
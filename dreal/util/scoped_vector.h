@@ -65,6 +65,8 @@ class ScopedVector {
 
   bool empty() const { return vector_.empty(); }
   size_t size() const { return vector_.size(); }
+  // Returns the size of the vector when each of the open scopes was pushed.
+  const std::vector<size_t>& scopes() const { return scopes_; }
   vector const& get_vector() const { return vector_; }
   vector get_vector() { return vector_; }
 
@@ -0,0 +1,220 @@
+#include "dreal/util/bound_implicator.h"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/symbolic/symbolic_test_util.h"
+
+using std::pair;
+using std::set;
+using std::vector;
+
+namespace dreal {
+namespace {
+
+class BoundImplicatorTest : public ::testing::Test {
+  DrakeSymbolicGuard guard_;
+ protected:
+  // Returns true if {l1, l2} (in any order) is one of the @p conflicts.
+  static bool HasConflict(const vector<pair<Literal, Literal>>& conflicts,
+                          const Literal& l1, const Literal& l2) {
+    auto same = [](const Literal& a, const Literal& b) {
+      return a.first.get_id() == b.first.get_id() && a.second == b.second;
+    };
+    for (const pair<Literal, Literal>& p : conflicts) {
+      if ((same(p.first, l1) && same(p.second, l2)) ||
+          (same(p.first, l2) && same(p.second, l1))) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Returns the literals implied by @p l through the binary clauses of
+  // @p conflicts, as unit propagation would find them. A literal is given
+  // as (variable id, polarity).
+  static set<pair<Variable::Id, bool>> Implied(
+      const vector<pair<Literal, Literal>>& conflicts, const Literal& l) {
+    // {a, b} is the clause ¬a ∨ ¬b, that is a ⇒ ¬b and b ⇒ ¬a.
+    std::map<pair<Variable::Id, bool>, vector<pair<Variable::Id, bool>>> edges;
+    for (const pair<Literal, Literal>& p : conflicts) {
+      edges[{p.first.first.get_id(), p.first.second}].emplace_back(
+          p.second.first.get_id(), !p.second.second);
+      edges[{p.second.first.get_id(), p.second.second}].emplace_back(
+          p.first.first.get_id(), !p.first.second);
+    }
+    set<pair<Variable::Id, bool>> implied;
+    vector<pair<Variable::Id, bool>> todo{{l.first.get_id(), l.second}};
+    while (!todo.empty()) {
+      const pair<Variable::Id, bool> current{todo.back()};
+      todo.pop_back();
+      for (const pair<Variable::Id, bool>& next : edges[current]) {
+        if (implied.insert(next).second) {
+          todo.push_back(next);
+        }
+      }
+    }
+    return implied;
+  }
+
+  const Variable x_{"x", Variable::Type::CONTINUOUS};
+  const Variable y_{"y", Variable::Type::CONTINUOUS};
+
+  const Variable b1_{"b1", Variable::Type::BOOLEAN};
+  const Variable b2_{"b2", Variable::Type::BOOLEAN};
+  const Variable b3_{"b3", Variable::Type::BOOLEAN};
+  const Variable b4_{"b4", Variable::Type::BOOLEAN};
+
+  BoundImplicator implicator_;
+};
+
+TEST_F(BoundImplicatorTest, UpperBounds) {
+  EXPECT_TRUE(implicator_.Add(b1_, x_ <= 3).empty());
+  const auto conflicts = implicator_.Add(b2_, x_ <= 5);
+  // x ≤ 3 ⇒ x ≤ 5, that is {b1, ¬b2} is a conflict.
+  ASSERT_EQ(conflicts.size(), 1);
+  EXPECT_TRUE(HasConflict(conflicts, {b1_, true}, {b2_, false}));
+}
+
+TEST_F(BoundImplicatorTest, LowerAndUpperBounds) {
+  implicator_.Add(b1_, x_ <= 3);
+  // 5 < x is a lower bound on x.
+  const auto conflicts = implicator_.Add(b2_, 5 < x_);
+  // x ≤ 3 and x > 5 can't both hold.
+  ASSERT_EQ(conflicts.size(), 1);
+  EXPECT_TRUE(HasConflict(conflicts, {b1_, true}, {b2_, true}));
+  // x ≤ 5 ∨ x > 5 always holds, that is {¬b3, ¬b2} is a conflict.
+  const auto more = implicator_.Add(b3_, x_ <= 5);
+  EXPECT_TRUE(HasConflict(more, {b3_, false}, {b2_, false}));
+}
+
+TEST_F(BoundImplicatorTest, StrictAndNonStrict) {
+  implicator_.Add(b1_, x_ < 3);
+  const auto conflicts = implicator_.Add(b2_, x_ <= 3);
+  // x < 3 ⇒ x ≤ 3, but not the other way around.
+  ASSERT_EQ(conflicts.size(), 1);
+  EXPECT_TRUE(HasConflict(conflicts, {b1_, true}, {b2_, false}));
+}
+
+TEST_F(BoundImplicatorTest, Equalities) {
+  implicator_.Add(b1_, x_ == 3);
+  implicator_.Add(b2_, x_ == 4);
+  const auto conflicts = implicator_.Add(b3_, x_ <= 3);
+  // x = 3 ⇒ x ≤ 3, and x = 4 ⇒ ¬(x ≤ 3).
+  ASSERT_EQ(conflicts.size(), 2);
+  EXPECT_TRUE(HasConflict(conflicts, {b3_, false}, {b1_, true}));
+  EXPECT_TRUE(HasConflict(conflicts, {b3_, true}, {b2_, true}));
+}
+
+TEST_F(BoundImplicatorTest, ScaledLinearTerms) {
+  implicator_.Add(b1_, x_ + y_ <= 2);
+  // -2x - 2y ≤ -6 ⇔ x + y ≥ 3
+  const auto conflicts = implicator_.Add(b2_, -2 * x_ - 2 * y_ <= -6);
+  ASSERT_EQ(conflicts.size(), 1);
+  EXPECT_TRUE(HasConflict(conflicts, {b1_, true}, {b2_, true}));
+}
+
+TEST_F(BoundImplicatorTest, DifferentTerms) {
+  implicator_.Add(b1_, x_ <= 3);
+  implicator_.Add(b2_, x_ + y_ <= 3);
+  EXPECT_TRUE(implicator_.Add(b3_, y_ <= 5).empty());
+  EXPECT_EQ(implicator_.size(), 3);
+}
+
+TEST_F(BoundImplicatorTest, Duplicates) {
+  implicator_.Add(b1_, x_ <= 3);
+  EXPECT_TRUE(implicator_.Add(b1_, x_ <= 3).empty());
+  EXPECT_EQ(implicator_.size(), 1);
+}
+
+TEST_F(BoundImplicatorTest, NonLinear) {
+  EXPECT_TRUE(implicator_.Add(b1_, x_ * y_ <= 3).empty());
+  EXPECT_TRUE(implicator_.Add(b2_, x_ * y_ <= 5).empty());
+  EXPECT_EQ(implicator_.size(), 0);
+}
+
+TEST_F(BoundImplicatorTest, PushPop) {
+  implicator_.Add(b1_, x_ <= 3);
+  implicator_.Push();
+  EXPECT_EQ(implicator_.Add(b2_, x_ <= 5).size(), 1);
+  EXPECT_EQ(implicator_.size(), 2);
+  implicator_.Pop();
+  EXPECT_EQ(implicator_.size(), 1);
+  // b2 is forgotten, so it can be registered again, and b3 is not related to
+  // it any more.
+  const auto conflicts = implicator_.Add(b3_, x_ >= 4);
+  ASSERT_EQ(conflicts.size(), 1);
+  EXPECT_TRUE(HasConflict(conflicts, {b3_, true}, {b1_, true}));
+  // x ≤ 5 is next to x ≥ 4 only. x ≤ 3 ⇒ x ≤ 5 follows from x ≤ 3 ⇒ ¬(x ≥ 4)
+  // and ¬(x ≥ 4) ⇒ x ≤ 5.
+  const auto more = implicator_.Add(b2_, x_ <= 5);
+  ASSERT_EQ(more.size(), 1);
+  EXPECT_TRUE(HasConflict(more, {b3_, false}, {b2_, false}));
+  EXPECT_THROW(implicator_.Pop(), std::runtime_error);
+}
+
+TEST_F(BoundImplicatorTest, NearestNeighbours) {
+  // x ≤ 0, ..., x ≤ 19, in some order.
+  const int n{20};
+  vector<int> order(n);
+  for (int i = 0; i < n; ++i) {
+    order[i] = i;
+  }
+  std::shuffle(order.begin(), order.end(), std::mt19937{42});
+  vector<Variable> b;
+  for (int i = 0; i < n; ++i) {
+    b.emplace_back("b" + std::to_string(i), Variable::Type::BOOLEAN);
+  }
+  vector<pair<Literal, Literal>> conflicts;
+  for (const int i : order) {
+    const auto more = implicator_.Add(b[i], x_ <= i);
+    // Only the next looser and the next tighter bounds.
+    EXPECT_LE(more.size(), 2);
+    conflicts.insert(conflicts.end(), more.begin(), more.end());
+  }
+  EXPECT_LE(conflicts.size(), 2 * n);
+  // All the same, x ≤ i ⇒ x ≤ j for every i < j.
+  for (int i = 0; i < n; ++i) {
+    const auto implied = Implied(conflicts, {b[i], true});
+    for (int j = 0; j < n; ++j) {
+      EXPECT_EQ(implied.count({b[j].get_id(), true}), i < j ? 1 : 0);
+    }
+  }
+}
+
+TEST_F(BoundImplicatorTest, EqualitiesBetweenBounds) {
+  vector<pair<Literal, Literal>> conflicts;
+  auto add = [&](const Variable& b, const Formula& f) {
+    const auto more = implicator_.Add(b, f);
+    conflicts.insert(conflicts.end(), more.begin(), more.end());
+  };
+  add(b1_, x_ == 2);
+  add(b2_, x_ <= 1);
+  add(b3_, x_ < 3);
+  // Splits the equalities between x ≤ 1 and x < 3.
+  add(b4_, x_ <= 2);
+  const auto implied = Implied(conflicts, {b1_, true});
+  EXPECT_EQ(implied.count({b2_.get_id(), false}), 1);
+  EXPECT_EQ(implied.count({b3_.get_id(), true}), 1);
+  EXPECT_EQ(implied.count({b4_.get_id(), true}), 1);
+  EXPECT_EQ(Implied(conflicts, {b2_, true}).count({b1_.get_id(), false}), 1);
+}
+
+TEST_F(BoundImplicatorTest, EqualBounds) {
+  implicator_.Add(b1_, x_ <= 3);
+  // 2x ≤ 6 ⇔ x ≤ 3.
+  const auto conflicts = implicator_.Add(b2_, 2 * x_ <= 6);
+  ASSERT_EQ(conflicts.size(), 2);
+  EXPECT_TRUE(HasConflict(conflicts, {b1_, true}, {b2_, false}));
+  EXPECT_TRUE(HasConflict(conflicts, {b2_, true}, {b1_, false}));
+}
+
+}  // namespace
+}  // namespace dreal
@@ -150,6 +150,25 @@ TEST_F(BoxTest, Sharing) {
   EXPECT_EQ(b2.size(), 4 /* x, y, z, w_ */);
 }
 
+TEST_F(BoxTest, InplaceAssign) {
+  Box b1{{x_, y_}};
+  b1[x_] = Box::Interval(0, 1);
+  Box b2{b1};
+  b2[y_] = Box::Interval(2, 3);
+
+  // b1 and b2 share their variables, so b1 is updated in place.
+  b1.InplaceAssign(b2);
+  EXPECT_EQ(b1, b2);
+  EXPECT_EQ(b1[y_], Box::Interval(2, 3));
+
+  // Otherwise, it is a plain assignment.
+  Box b3{{x_, y_, z_}};
+  b3[z_] = Box::Interval(4, 5);
+  b1.InplaceAssign(b3);
+  EXPECT_EQ(b1, b3);
+  EXPECT_EQ(b1.size(), 3);
+}
+
 #if 0
 TEST_F(BoxTest, InplaceUnion) {
   Box b1{{x_, y_}};
@@ -0,0 +1,106 @@
+#include "dreal/util/clause_exchange.h"
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dreal/symbolic/symbolic.h"
+#include "dreal/symbolic/symbolic_test_util.h"
+
+using std::thread;
+using std::vector;
+
+namespace dreal {
+namespace {
+
+class ClauseExchangeTest : public ::testing::Test {
+  DrakeSymbolicGuard guard_;
+
+ protected:
+  const Variable x_{"x", Variable::Type::CONTINUOUS};
+  const Variable y_{"y", Variable::Type::CONTINUOUS};
+};
+
+TEST_F(ClauseExchangeTest, AtomIds) {
+  ClauseExchange exchange{4, 3};
+  const int id1{exchange.AtomId(x_ <= 3)};
+  const int id2{exchange.AtomId(x_ + y_ <= 1)};
+  EXPECT_NE(id1, id2);
+  EXPECT_EQ(exchange.AtomId(x_ <= 3), id1);
+  EXPECT_TRUE(exchange.atom(id2).EqualTo(x_ + y_ <= 1));
+}
+
+TEST_F(ClauseExchangeTest, PublishCollect) {
+  ClauseExchange exchange{4, 3};
+  uint64_t cursor0{0};
+  uint64_t cursor1{0};
+  EXPECT_TRUE(exchange.Publish(0, {1, -2}));
+  EXPECT_TRUE(exchange.Publish(1, {3}));
+  // A worker doesn't get its own clauses back.
+  EXPECT_EQ(exchange.Collect(0, &cursor0), (vector<vector<int>>{{3}}));
+  EXPECT_EQ(exchange.Collect(1, &cursor1), (vector<vector<int>>{{1, -2}}));
+  // Nor does it get a clause twice.
+  EXPECT_TRUE(exchange.Collect(0, &cursor0).empty());
+  EXPECT_TRUE(exchange.Publish(1, {-1, 2, 3}));
+  EXPECT_EQ(exchange.Collect(0, &cursor0), (vector<vector<int>>{{-1, 2, 3}}));
+}
+
+TEST_F(ClauseExchangeTest, ClauseSize) {
+  ClauseExchange exchange{4, 3};
+  EXPECT_FALSE(exchange.Publish(0, {}));
+  EXPECT_FALSE(exchange.Publish(0, {1, 2, 3, 4}));
+  uint64_t cursor{0};
+  EXPECT_TRUE(exchange.Collect(1, &cursor).empty());
+}
+
+TEST_F(ClauseExchangeTest, Overflow) {
+  ClauseExchange exchange{4, 1};
+  for (int i = 1; i <= 6; ++i) {
+    EXPECT_TRUE(exchange.Publish(0, {i}));
+  }
+  // The first two clauses have been overwritten.
+  uint64_t cursor{0};
+  EXPECT_EQ(exchange.Collect(1, &cursor),
+            (vector<vector<int>>{{3}, {4}, {5}, {6}}));
+  EXPECT_EQ(cursor, 6);
+}
+
+TEST_F(ClauseExchangeTest, Concurrent) {
+  constexpr int kWorkers{4};
+  constexpr int kClauses{10000};
+  ClauseExchange exchange{64, 3};
+  vector<thread> threads;
+  vector<int> num_collected(kWorkers, 0);
+  vector<int> consistent(kWorkers, 1);
+  for (int w = 0; w < kWorkers; ++w) {
+    threads.emplace_back([&, w]() {
+      uint64_t cursor{0};
+      for (int i = 1; i <= kClauses; ++i) {
+        // Every clause is {n, n, -n}, with n encoding the worker.
+        const int n{i * kWorkers + w};
+        exchange.Publish(w, {n, n, -n});
+        for (const vector<int>& clause : exchange.Collect(w, &cursor)) {
+          ++num_collected[w];
+          if (clause.size() != 3 || clause[0] != clause[1] ||
+              clause[0] != -clause[2] || clause[0] % kWorkers == w) {
+            consistent[w] = 0;
+          }
+        }
+      }
+    });
+  }
+  for (thread& t : threads) {
+    t.join();
+  }
+  // Clauses may be lost, but those which are collected are never torn.
+  int total{0};
+  for (int w = 0; w < kWorkers; ++w) {
+    EXPECT_TRUE(consistent[w]);
+    total += num_collected[w];
+  }
+  EXPECT_GT(total, 0);
+}
+
+}  // namespace
+}  // namespace dreal
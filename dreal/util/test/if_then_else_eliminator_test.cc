@@ -42,15 +42,14 @@ class IfThenElseEliminatorTest : public ::testing::Test {
       // Addition, multiplication, division
       1 + x_ + y_ * 3 / z_ == 0,
       // math functions
-      log(x_) == abs(y_),
+      log(x_) == y_,
       exp(x_) > sqrt(y_),
       pow(x_, y_) < sin(z_),
       cos(x_) >= tan(y_),
       asin(x_) <= acos(y_),
       atan(x_) >= atan2(y_, z_),
       sinh(x_) == cosh(y_),
-      tanh(x_) == min(y_, z_),
-      max(x_, y_) != z_,
+      tanh(x_) != z_,
       !b1_,
       uninterpreted_function("uf", {x_, y_, z_}) == 0.0,
       (b1_ && b2_) || (!b1_ && !b2_),
@@ -110,5 +109,106 @@ TEST_F(IfThenElseEliminatorTest, ITEsInForall) {
             "(!((ITE4 == y)) and !((x > y)))))");
 }
 
+TEST_F(IfThenElseEliminatorTest, Max) {
+  const Formula f{max(x_, y_) == z_};
+  IfThenElseEliminator ite_elim;
+  const Formula converted{ite_elim.Process(f)};
+  ASSERT_EQ(ite_elim.variables().size(), 1);
+  const Variable& v{*(ite_elim.variables().begin())};
+  const Formula expected{v == z_ && (!(x_ >= y_) || v == x_) &&
+                         (x_ >= y_ || v == y_) && v >= x_ && v >= y_};
+  EXPECT_PRED2(FormulaEqual, converted, expected);
+}
+
+TEST_F(IfThenElseEliminatorTest, Min) {
+  const Formula f{min(x_, y_) == z_};
+  IfThenElseEliminator ite_elim;
+  const Formula converted{ite_elim.Process(f)};
+  ASSERT_EQ(ite_elim.variables().size(), 1);
+  const Variable& v{*(ite_elim.variables().begin())};
+  const Formula expected{v == z_ && (!(x_ <= y_) || v == x_) &&
+                         (x_ <= y_ || v == y_) && v <= x_ && v <= y_};
+  EXPECT_PRED2(FormulaEqual, converted, expected);
+}
+
+TEST_F(IfThenElseEliminatorTest, Abs) {
+  const Formula f{abs(x_) <= 1};
+  IfThenElseEliminator ite_elim;
+  const Formula converted{ite_elim.Process(f)};
+  ASSERT_EQ(ite_elim.variables().size(), 1);
+  const Variable& v{*(ite_elim.variables().begin())};
+  const Formula expected{v <= 1 && (!(x_ >= -x_) || v == x_) &&
+                         (x_ >= -x_ || v == -x_) && v >= x_ && v >= -x_};
+  EXPECT_PRED2(FormulaEqual, converted, expected);
+}
+
+TEST_F(IfThenElseEliminatorTest, FixedPhases) {
+  Box box{{x_, y_}};
+  box[x_] = Box::Interval{1, 2};
+  box[y_] = Box::Interval{-1, 1};
+  IfThenElseEliminator ite_elim;
+  // x ∈ [1, 2] is above 0 and below 3.
+  EXPECT_PRED2(
+      FormulaEqual,
+      ite_elim.Process(max(x_, 0) + min(3 - x_, 0) + abs(x_) == z_, box),
+      2 * x_ == z_);
+  EXPECT_TRUE(ite_elim.variables().empty());
+  // The phase of max(y, 0) is not decided by y ∈ [-1, 1].
+  ite_elim.Process(max(2 * y_, 0) + max(y_ - 1, 0) == z_, box);
+  EXPECT_EQ(ite_elim.variables().size(), 1);
+}
+
+TEST_F(IfThenElseEliminatorTest, SharedTerms) {
+  const Expression ite{if_then_else(Formula{b1_}, x_, y_)};
+  IfThenElseEliminator ite_elim;
+  ite_elim.Process(ite > 0 && ite < 5 && max(x_, y_) > z_ &&
+                   (max(x_, y_) < w_ || abs(z_) > 1 || abs(z_) < w_));
+  EXPECT_EQ(ite_elim.variables().size(), 3);
+
+  // The two occurrences of `ite` are under different guards.
+  IfThenElseEliminator ite_elim2;
+  ite_elim2.Process(if_then_else(Formula{b2_}, ite, ite + 1) > 0);
+  EXPECT_EQ(ite_elim2.variables().size(), 3);
+}
+
+TEST_F(IfThenElseEliminatorTest, SharedTermsWithGuardedITEs) {
+  // The ite in max(ite, 0) is only defined under the guard of the max, so
+  // the two occurrences of the max can't share a variable.
+  const Expression ite{if_then_else(Formula{b2_}, x_, y_)};
+  const Expression m{max(ite, 0)};
+  IfThenElseEliminator ite_elim;
+  ite_elim.Process(if_then_else(Formula{b1_}, m, m + 1) > 2);
+  // One ite for the root, and a max and an ite for each branch.
+  EXPECT_EQ(ite_elim.variables().size(), 5);
+
+  // Without an ite, the max is shared by the two branches.
+  IfThenElseEliminator ite_elim2;
+  ite_elim2.Process(if_then_else(Formula{b1_}, max(x_, 0), max(x_, 0) + 1) >
+                    2);
+  EXPECT_EQ(ite_elim2.variables().size(), 2);
+}
+
+TEST_F(IfThenElseEliminatorTest, SharedTermsAcrossCalls) {
+  const Expression ite{if_then_else(Formula{b1_}, x_, y_)};
+  IfThenElseEliminator ite_elim;
+  ite_elim.Process(max(x_, y_) + ite > z_);
+  ASSERT_EQ(ite_elim.variables().size(), 2);
+
+  // The variables of the first call are reused, without their definitions.
+  ite_elim.Push();
+  const Formula f2{ite_elim.Process(max(x_, y_) + ite < w_)};
+  EXPECT_TRUE(ite_elim.variables().empty());
+  EXPECT_TRUE(is_relational(f2));
+  ite_elim.Process(abs(z_) < w_);
+  EXPECT_EQ(ite_elim.variables().size(), 1);
+
+  // The terms eliminated in the popped scope are forgotten.
+  ite_elim.Pop();
+  ite_elim.Process(abs(z_) < w_);
+  EXPECT_EQ(ite_elim.variables().size(), 1);
+  ite_elim.Process(max(x_, y_) + ite < w_);
+  EXPECT_TRUE(ite_elim.variables().empty());
+}
+
 }  // namespace
 }  // namespace dreal
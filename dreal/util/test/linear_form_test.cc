@@ -0,0 +1,82 @@
+#include "dreal/util/linear_form.h"
+
+#include <map>
+
+#include <gtest/gtest.h>
+
+#include "dreal/symbolic/symbolic_test_util.h"
+
+namespace dreal {
+namespace {
+
+class LinearFormExtractorTest : public ::testing::Test {
+  DrakeSymbolicGuard guard_;
+
+ protected:
+  // Returns the coefficient of @p col in the last extraction.
+  mpq_class Coeff(const int col) const {
+    for (size_t i = 0; i < extractor_.columns().size(); ++i) {
+      if (extractor_.columns()[i] == col) {
+        return extractor_.coefficients()[i];
+      }
+    }
+    return 0;
+  }
+
+  const Variable x_{"x", Variable::Type::CONTINUOUS};
+  const Variable y_{"y", Variable::Type::CONTINUOUS};
+  const Variable z_{"z", Variable::Type::CONTINUOUS};
+  const Variable w_{"w", Variable::Type::CONTINUOUS};
+  const std::map<Variable::Id, int> to_col_{
+      {x_.get_id(), 0}, {y_.get_id(), 1}, {z_.get_id(), 2}};
+  LinearFormExtractor extractor_;
+};
+
+TEST_F(LinearFormExtractorTest, Linear) {
+  ASSERT_TRUE(extractor_.Extract(2 * x_ + 3 * (y_ - z_ / 4) + 5, to_col_));
+  EXPECT_EQ(extractor_.columns().size(), 3u);
+  EXPECT_EQ(Coeff(0), 2);
+  EXPECT_EQ(Coeff(1), 3);
+  EXPECT_EQ(Coeff(2), mpq_class(-3, 4));
+  EXPECT_EQ(extractor_.constant(), 5);
+}
+
+TEST_F(LinearFormExtractorTest, Difference) {
+  ASSERT_TRUE(extractor_.Extract(x_ + y_ + 1, y_ - 2 * z_ + 3, to_col_));
+  // y cancels out.
+  EXPECT_EQ(extractor_.columns().size(), 2u);
+  EXPECT_EQ(Coeff(0), 1);
+  EXPECT_EQ(Coeff(1), 0);
+  EXPECT_EQ(Coeff(2), 2);
+  EXPECT_EQ(extractor_.constant(), -2);
+
+  // The buffers are reset between calls.
+  ASSERT_TRUE(extractor_.Extract(Expression{y_}, Expression{7}, to_col_));
+  ASSERT_EQ(extractor_.columns().size(), 1u);
+  EXPECT_EQ(extractor_.columns()[0], 1);
+  EXPECT_EQ(extractor_.coefficients()[0], 1);
+  EXPECT_EQ(extractor_.constant(), -7);
+}
+
+TEST_F(LinearFormExtractorTest, NonLinear) {
+  EXPECT_FALSE(extractor_.Extract(x_ * y_ + z_, to_col_));
+  EXPECT_FALSE(extractor_.Extract(x_ + pow(y_, 2), to_col_));
+  EXPECT_FALSE(extractor_.Extract(x_ / y_, to_col_));
+  EXPECT_FALSE(extractor_.Extract(sin(x_), to_col_));
+  // Linear once expanded, but not syntactically.
+  EXPECT_FALSE(extractor_.Extract(x_ * (y_ + 1) - x_ * y_, to_col_));
+  ASSERT_TRUE(extractor_.Extract((x_ * (y_ + 1) - x_ * y_).Expand(), to_col_));
+  EXPECT_EQ(extractor_.columns().size(), 1u);
+  EXPECT_EQ(Coeff(0), 1);
+}
+
+TEST_F(LinearFormExtractorTest, UndefinedVariable) {
+  EXPECT_THROW(extractor_.Extract(x_ + w_, to_col_), std::runtime_error);
+  // The extractor can still be used afterwards.
+  ASSERT_TRUE(extractor_.Extract(x_ + x_, to_col_));
+  ASSERT_EQ(extractor_.columns().size(), 1u);
+  EXPECT_EQ(Coeff(0), 2);
+}
+
+}  // namespace
+}  // namespace dreal
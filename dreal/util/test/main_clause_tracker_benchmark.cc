@@ -0,0 +1,130 @@
+// Measures MainClauseTracker::GetActiveLiterals() on a large random CNF,
+// against the std::set/std::map scan which the SAT solvers used before:
+//
+//   bazel run //dreal/util:main_clause_tracker_benchmark -- \
+//       [#vars] [#clauses] [#calls]
+//
+// Each clause has three literals, one of which is true in a fixed random
+// model, so that the model satisfies the CNF. Both methods are called
+// #calls times, as the SAT solvers do after each satisfiable check, and
+// must agree on the result.
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "dreal/util/main_clause_tracker.h"
+#include "dreal/util/timer.h"
+
+namespace dreal {
+namespace {
+
+using std::cerr;
+using std::cout;
+using std::map;
+using std::set;
+using std::vector;
+
+// The previous algorithm: for each true literal, rescan every clause which
+// contains it.
+set<int> ScanActiveLiterals(const vector<int>& model,
+                            const vector<int>& clauses,
+                            const map<int, set<int>>& lookup) {
+  set<int> lits(model.begin(), model.end());
+  for (auto it = lits.begin(); it != lits.end();) {
+    bool required{false};
+    const auto c_it = lookup.find(*it);
+    if (c_it != lookup.end()) {
+      for (const int c : c_it->second) {
+        int count{0};
+        for (size_t j = c; clauses[j] != 0; ++j) {
+          count += lits.count(clauses[j]);
+        }
+        if (count == 1) {
+          required = true;
+          break;
+        }
+      }
+    }
+    it = required ? std::next(it) : lits.erase(it);
+  }
+  return lits;
+}
+
+int Run(const int num_vars, const int num_clauses, const int num_calls) {
+  std::mt19937 rng{0};
+  std::uniform_int_distribution<int> var_dist{1, num_vars};
+  std::bernoulli_distribution sign_dist;
+  vector<int> model;
+  for (int v = 1; v <= num_vars; ++v) {
+    model.push_back(sign_dist(rng) ? v : -v);
+  }
+
+  MainClauseTracker tracker;
+  vector<int> clauses;
+  map<int, set<int>> lookup;
+  for (int i = 0; i < num_clauses; ++i) {
+    const int start = clauses.size();
+    int lits[3] = {model[var_dist(rng) - 1], 0, 0};
+    for (int j = 1; j < 3; ++j) {
+      // The old scan counts a repeated literal twice, so there is none.
+      do {
+        lits[j] = sign_dist(rng) ? var_dist(rng) : -var_dist(rng);
+      } while (std::count(lits, lits + j, lits[j]) > 0);
+    }
+    for (const int lit : lits) {
+      tracker.AddLiteral(lit);
+      clauses.push_back(lit);
+      lookup[lit].insert(start);
+    }
+    tracker.EndClause();
+    clauses.push_back(0);
+  }
+
+  const auto deref = [&model](const int v) { return model[v - 1]; };
+  Timer tracker_timer;
+  size_t num_active{0};
+  for (int i = 0; i < num_calls; ++i) {
+    tracker_timer.resume();
+    num_active = tracker.GetActiveLiterals(num_vars, deref).size();
+    tracker_timer.pause();
+  }
+
+  Timer scan_timer;
+  set<int> scanned;
+  for (int i = 0; i < num_calls; ++i) {
+    scan_timer.resume();
+    scanned = ScanActiveLiterals(model, clauses, lookup);
+    scan_timer.pause();
+  }
+
+  const vector<int>& active{tracker.GetActiveLiterals(num_vars, deref)};
+  if (!std::equal(active.begin(), active.end(), scanned.begin(),
+                  scanned.end())) {
+    cerr << "The two methods disagree.\n";
+    return 1;
+  }
+  cout << fmt::format("{} vars, {} clauses, {} active literals\n", num_vars,
+                      num_clauses, num_active);
+  cout << fmt::format("MainClauseTracker: {:>10.3f} ms/call\n",
+                      tracker_timer.seconds() * 1e3 / num_calls);
+  cout << fmt::format("set/map scan:      {:>10.3f} ms/call\n",
+                      scan_timer.seconds() * 1e3 / num_calls);
+  return 0;
+}
+
+}  // namespace
+}  // namespace dreal
+
+int main(int argc, char* argv[]) {
+  const int num_vars{argc > 1 ? std::atoi(argv[1]) : 100000};
+  const int num_clauses{argc > 2 ? std::atoi(argv[2]) : 400000};
+  const int num_calls{argc > 3 ? std::atoi(argv[3]) : 10};
+  return dreal::Run(num_vars, num_clauses, num_calls);
+}
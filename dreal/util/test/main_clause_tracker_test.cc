@@ -0,0 +1,107 @@
+#include "dreal/util/main_clause_tracker.h"
+
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace dreal {
+namespace {
+
+using std::vector;
+
+class MainClauseTrackerTest : public ::testing::Test {
+ protected:
+  void AddClause(const vector<int>& clause) {
+    for (const int lit : clause) {
+      tracker_.AddLiteral(lit);
+    }
+    tracker_.EndClause();
+  }
+
+  // Returns the active literals for the model which assigns the literals of
+  // @p model to true and leaves the other variables unassigned.
+  vector<int> Active(const int num_vars, const vector<int>& model) {
+    vector<int> values(num_vars + 1, 0);
+    for (const int lit : model) {
+      values[std::abs(lit)] = lit > 0 ? 1 : -1;
+    }
+    return tracker_.GetActiveLiterals(
+        num_vars, [&values](const int v) { return values[v]; });
+  }
+
+  MainClauseTracker tracker_;
+};
+
+TEST_F(MainClauseTrackerTest, Basic) {
+  AddClause({1, 2});
+  AddClause({-1, 3});
+  // -4 is in no clause, and 1 comes before 2 which also satisfies the first
+  // clause, so both are dropped.
+  EXPECT_EQ(Active(4, {1, 2, 3, -4}), (vector<int>{2, 3}));
+  // -1 is the only true literal of the second clause.
+  EXPECT_EQ(Active(4, {-1, 2, -3}), (vector<int>{-1, 2}));
+}
+
+TEST_F(MainClauseTrackerTest, RepeatedLiteral) {
+  AddClause({1, 1, 2});
+  EXPECT_EQ(Active(2, {1, -2}), (vector<int>{1}));
+}
+
+TEST_F(MainClauseTrackerTest, Resize) {
+  AddClause({1, 2});
+  const size_t size{tracker_.size()};
+  AddClause({3});
+  EXPECT_EQ(Active(3, {1, 2, 3}), (vector<int>{2, 3}));
+  tracker_.Resize(size);
+  EXPECT_EQ(Active(3, {1, 2, 3}), (vector<int>{2}));
+  // The variables of the removed clauses may disappear from the model.
+  EXPECT_EQ(Active(2, {-1, 2}), (vector<int>{2}));
+}
+
+TEST_F(MainClauseTrackerTest, Random) {
+  // The result satisfies every clause, and no literal can be dropped from it.
+  constexpr int kNumVars{50};
+  std::mt19937 rng{0};
+  std::uniform_int_distribution<int> var_dist{1, kNumVars};
+  std::bernoulli_distribution sign_dist;
+  vector<int> model;
+  for (int v = 1; v <= kNumVars; ++v) {
+    model.push_back(sign_dist(rng) ? v : -v);
+  }
+  vector<vector<int>> clauses;
+  for (int i = 0; i < 200; ++i) {
+    vector<int> clause{model[var_dist(rng) - 1]};
+    for (int j = 0; j < 3; ++j) {
+      clause.push_back(sign_dist(rng) ? var_dist(rng) : -var_dist(rng));
+    }
+    AddClause(clause);
+    clauses.push_back(clause);
+  }
+  const vector<int> active{Active(kNumVars, model)};
+  vector<int> count(clauses.size(), 0);
+  for (size_t c = 0; c < clauses.size(); ++c) {
+    for (const int lit : active) {
+      for (const int l : clauses[c]) {
+        if (l == lit) {
+          ++count[c];
+          break;
+        }
+      }
+    }
+    EXPECT_GT(count[c], 0);
+  }
+  for (const int lit : active) {
+    bool required{false};
+    for (size_t c = 0; c < clauses.size(); ++c) {
+      for (const int l : clauses[c]) {
+        required |= l == lit && count[c] == 1;
+      }
+    }
+    EXPECT_TRUE(required) << lit;
+  }
+}
+
+}  // namespace
+}  // namespace dreal
@@ -133,6 +133,34 @@ TEST_F(PredicateAbstractorTest, Leq) {
   EXPECT_PRED2(VarEqual, abstractor_[f], var);
 }
 
+TEST_F(PredicateAbstractorTest, Normalization) {
+  // 2x + 2y ≤ 6, x + y ≤ 3 and 3 ≥ x + y <-> b
+  const Formula f1_abstracted{abstractor_.Convert(2 * x_ + 2 * y_ <= 6)};
+  const Formula f2_abstracted{abstractor_.Convert(x_ + y_ <= 3)};
+  const Formula f3_abstracted{abstractor_.Convert(3 >= x_ + y_)};
+  ASSERT_TRUE(is_variable(f1_abstracted));
+  const Variable& var{get_variable(f1_abstracted)};
+  EXPECT_PRED2(FormulaEqual, abstractor_[var], x_ + y_ <= 3);
+  EXPECT_PRED2(FormulaEqual, f2_abstracted, f1_abstracted);
+  EXPECT_PRED2(FormulaEqual, f3_abstracted, f1_abstracted);
+
+  // -x - y < -3 <-> x + y > 3 <-> !b
+  EXPECT_PRED2(FormulaEqual, abstractor_.Convert(-x_ - y_ < -3), !var);
+
+  // 4y = 2 - 2z <-> y + ½z = ½
+  const Formula f4_abstracted{abstractor_.Convert(4 * y_ == 2 - 2 * z_)};
+  ASSERT_TRUE(is_variable(f4_abstracted));
+  EXPECT_PRED2(FormulaEqual, abstractor_[get_variable(f4_abstracted)],
+               y_ + 0.5 * z_ == 0.5);
+
+  // Non-linear atoms are kept as they are.
+  const Formula f5{2 * x_ * y_ <= 6};
+  const Formula f5_abstracted{abstractor_.Convert(f5)};
+  ASSERT_TRUE(is_variable(f5_abstracted));
+  EXPECT_PRED2(FormulaEqual, abstractor_[get_variable(f5_abstracted)], f5);
+  EXPECT_EQ(abstractor_.var_to_formula_map().size(), 3);
+}
+
 TEST_F(PredicateAbstractorTest, Conjunction) {
   // f₁ ∧ f₂ ∧ f₃ ∧ f₄ <-> !b₁ ∧ !b₂ ∧ b₃ ∧ !b₄
   const Formula f1{x_ >= y_};
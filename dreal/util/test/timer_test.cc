@@ -1,5 +1,8 @@
 #include "dreal/util/timer.h"
 
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 namespace dreal {
@@ -49,5 +52,31 @@ GTEST_TEST(Timer, Test1) {
   EXPECT_LE(duration5, duration1);
   EXPECT_TRUE(timer.is_running());
 }
+
+GTEST_TEST(ConcurrentTimer, SumOfThreads) {
+  ConcurrentTimer timer;
+  EXPECT_EQ(timer.seconds(), 0.0);
+
+  // Each thread measures its own run, and they are all added up.
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&timer]() {
+      ConcurrentTimerGuard guard(&timer, true);
+      DoSomeWork(1000);
+    });
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+  const double seconds{timer.seconds()};
+  EXPECT_GT(seconds, 0.0);
+
+  // A disabled guard does not add anything.
+  {
+    ConcurrentTimerGuard guard(&timer, false);
+    DoSomeWork(1000);
+  }
+  EXPECT_EQ(timer.seconds(), seconds);
+}
 }  // namespace
 }  // namespace dreal
@@ -34,10 +34,19 @@ bool IsSatisfiable(const Formula& f) {
 class TseitinCnfizerTest : public ::testing::Test {
   DrakeSymbolicGuard guard_;
  protected:
-  ::testing::AssertionResult CnfChecker(const Formula& f) {
-    const vector<Formula> clauses{cnfizer_.Convert(f)};
-    const Formula f_cnf{
-        make_conjunction(set<Formula>{clauses.begin(), clauses.end()})};
+  // Converts @p formulas with a new cnfizer, and checks the conjunction of
+  // all the clauses against the conjunction of @p formulas. The clauses of a
+  // formula may use the definitions added by the previous ones.
+  ::testing::AssertionResult CnfChecker(const vector<Formula>& formulas) {
+    TseitinCnfizer cnfizer;
+    set<Formula> clauses;
+    for (const Formula& f_i : formulas) {
+      const vector<Formula> clauses_i{cnfizer.Convert(f_i)};
+      clauses.insert(clauses_i.begin(), clauses_i.end());
+    }
+    const Formula f{
+        make_conjunction(set<Formula>{formulas.begin(), formulas.end()})};
+    const Formula f_cnf{make_conjunction(clauses)};
     // Check1: f_cnf should be in CNF.
     if (!is_cnf(f_cnf)) {
       return ::testing::AssertionFailure() << f_cnf << " is not in CNF.";
@@ -87,9 +96,38 @@ TEST_F(TseitinCnfizerTest, Test) {
   formulas.push_back((b1_ || b2_) && (b1_ || !b3_));
 
   for (const auto& f : formulas) {
-    EXPECT_TRUE(CnfChecker(f));
+    EXPECT_TRUE(CnfChecker({f}));
   }
 }
 
+TEST_F(TseitinCnfizerTest, SharedSubformulas) {
+  const Formula shared{(b1_ && b2_) || !b3_};
+  EXPECT_TRUE(CnfChecker({shared || b3_, !shared || b1_,
+                          shared && (b2_ || b3_), shared}));
+
+  cnfizer_.Convert(shared && b3_);
+  EXPECT_EQ(cnfizer_.map().size(), 3);
+  // Only `shared ∨ b2` needs a new variable.
+  cnfizer_.Convert(shared || b2_);
+  EXPECT_EQ(cnfizer_.map().size(), 1);
+  // `shared` is already defined, and so is its negation.
+  EXPECT_EQ(cnfizer_.Convert(shared).size(), 1);
+  EXPECT_TRUE(cnfizer_.map().empty());
+  cnfizer_.Convert(!shared || b1_);
+  EXPECT_EQ(cnfizer_.map().size(), 2);
+}
+
+TEST_F(TseitinCnfizerTest, PushPop) {
+  cnfizer_.Push();
+  cnfizer_.Convert(b2_ || (b1_ && b3_));
+  EXPECT_EQ(cnfizer_.map().size(), 2);
+  cnfizer_.Convert(b3_ || (b1_ && b3_));
+  EXPECT_EQ(cnfizer_.map().size(), 1);
+  cnfizer_.Pop();
+  // The definition of `b1 ∧ b3` is forgotten.
+  cnfizer_.Convert(b3_ || (b1_ && b3_));
+  EXPECT_EQ(cnfizer_.map().size(), 2);
+}
+
 }  // namespace
 }  // namespace dreal
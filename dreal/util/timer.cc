@@ -100,6 +100,39 @@ void TimerGuard::resume() {
   }
 }
 
+void ConcurrentTimer::add(const Timer& timer) {
+  std::atomic_fetch_add_explicit(&elapsed_, timer.elapsed().count(),
+                                 std::memory_order_relaxed);
+}
+
+std::chrono::duration<double>::rep ConcurrentTimer::seconds() const {
+  using seconds_in_double = std::chrono::duration<double>;
+  return std::chrono::duration_cast<seconds_in_double>(
+             Timer::duration{elapsed_.load(std::memory_order_relaxed)})
+      .count();
+}
+
+ConcurrentTimerGuard::ConcurrentTimerGuard(ConcurrentTimer* const timer,
+                                           const bool enabled)
+    : timer_{timer}, enabled_{enabled} {
+  if (enabled_) {
+    local_.start();
+  }
+}
+
+ConcurrentTimerGuard::~ConcurrentTimerGuard() {
+  if (enabled_) {
+    local_.pause();
+    timer_->add(local_);
+  }
+}
+
+void ConcurrentTimerGuard::pause() {
+  if (enabled_) {
+    local_.pause();
+  }
+}
+
 UserTimer main_timer;
 
 }  // namespace dreal
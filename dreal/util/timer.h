@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <iostream>
 #include <type_traits>
@@ -105,6 +106,48 @@ class TimerGuard {
   const bool enabled_{false};
 };
 
+/// Sum of the times measured by several threads at once, which a Timer
+/// shared through TimerGuard can't do. Each thread measures its own time with
+/// a ConcurrentTimerGuard.
+class ConcurrentTimer {
+ public:
+  /// Adds the elapsed time of @p timer.
+  void add(const Timer& timer);
+
+  /// Returns the total time in seconds.
+  std::chrono::duration<double>::rep seconds() const;
+
+ private:
+  std::atomic<Timer::duration::rep> elapsed_{0};
+};
+
+/// Measures the time spent in its scope with a Timer of its own, and adds it
+/// to the passed ConcurrentTimer when the guard object is destructed.
+class ConcurrentTimerGuard {
+ public:
+  /// Constructs the timer guard object with @p timer, and starts measuring.
+  ///
+  /// If @p enabled is false, this class does not do anything.
+  ConcurrentTimerGuard(ConcurrentTimer* timer, bool enabled);
+
+  ConcurrentTimerGuard(const ConcurrentTimerGuard&) = delete;
+  ConcurrentTimerGuard(ConcurrentTimerGuard&&) = delete;
+  ConcurrentTimerGuard& operator=(const ConcurrentTimerGuard&) = delete;
+  ConcurrentTimerGuard& operator=(ConcurrentTimerGuard&&) = delete;
+
+  /// Destructs the timer guard object. It adds the measured time to the
+  /// embedded timer object.
+  ~ConcurrentTimerGuard();
+
+  /// Stops measuring. The time so far is still added on destruction.
+  void pause();
+
+ private:
+  ConcurrentTimer* const timer_;
+  const bool enabled_{false};
+  Timer local_;
+};
+
 extern UserTimer main_timer;
 
 }  // namespace dreal
@@ -70,8 +70,14 @@ vector<Formula> TseitinCnfizer::Convert(const Formula& f) {
   TimerGuard timer_guard(&stat.timer_convert_, stat.enabled());
   stat.increase_num_convert();
   map_.clear();
+  const auto it = definitions_.find(f);
+  if (it != definitions_.end()) {
+    return {Formula{it->second}};
+  }
   vector<Formula> ret;
-  const Formula head{Visit(f)};
+  // Visits `f` without recording its definition, which is added as a set of
+  // clauses rather than as an equivalence.
+  const Formula head{VisitFormula<Formula>(this, f)};
   if (map_.empty()) {
     return {head};
   }
@@ -90,9 +96,20 @@ vector<Formula> TseitinCnfizer::Convert(const Formula& f) {
   return ret;
 }
 
+void TseitinCnfizer::Push() { definitions_.push(); }
+
+void TseitinCnfizer::Pop() { definitions_.pop(); }
+
 Formula TseitinCnfizer::Visit(const Formula& f) {
-  // TODO(soonho): use cache.
-  return VisitFormula<Formula>(this, f);
+  const auto it = definitions_.find(f);
+  if (it != definitions_.end()) {
+    return Formula{it->second};
+  }
+  const Formula g{VisitFormula<Formula>(this, f)};
+  if (is_variable(g) && !is_variable(f)) {
+    definitions_.insert(f, get_variable(g));
+  }
+  return g;
 }
 
 Formula TseitinCnfizer::VisitFalse(const Formula& f) { return f; }
@@ -131,7 +148,7 @@ Formula TseitinCnfizer::VisitForall(const Formula& f) {
   if (new_clauses.size() == 1) {
     return *(new_clauses.begin());
   } else {
-    static size_t id{0};
+    static std::atomic<size_t> id{0};
     const Variable bvar{string("forall") + to_string(id++),
                         Variable::Type::BOOLEAN};
     map_.emplace(bvar, make_conjunction(new_clauses));
@@ -142,7 +159,7 @@ Formula TseitinCnfizer::VisitForall(const Formula& f) {
 Formula TseitinCnfizer::VisitConjunction(const Formula& f) {
   // Introduce a new Boolean variable, `bvar` for `f` and record the
   // relation `bvar ⇔ f`.
-  static size_t id{0};
+  static std::atomic<size_t> id{0};
   const set<Formula> transformed_operands{::dreal::map(
       get_operands(f),
       [this](const Formula& formula) { return this->Visit(formula); })};
@@ -153,7 +170,7 @@ Formula TseitinCnfizer::VisitConjunction(const Formula& f) {
 }
 
 Formula TseitinCnfizer::VisitDisjunction(const Formula& f) {
-  static size_t id{0};
+  static std::atomic<size_t> id{0};
   const set<Formula>& transformed_operands{::dreal::map(
       get_operands(f),
       [this](const Formula& formula) { return this->Visit(formula); })};
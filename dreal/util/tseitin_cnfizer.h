@@ -6,19 +6,35 @@
 
 #include "dreal/symbolic/symbolic.h"
 #include "dreal/util/naive_cnfizer.h"
+#include "dreal/util/scoped_unordered_map.h"
 
 namespace dreal {
 /// Transforms a symbolic formula @p f into an equi-satisfiable CNF
 /// formula by introducing extra Boolean variables (Tseitin transformation).
+///
+/// The definitions are kept across calls to Convert, so that a subformula
+/// which occurs in several formulas is encoded once. Since a definition
+/// `b ⇔ subformula` holds in both polarities, the occurrences of a
+/// subformula under a negation share it too.
 class TseitinCnfizer {
  public:
   /// Convert @p f into an equi-satisfiable formula @c f' in CNF.
+  ///
+  /// @note The clauses may use the variables defined by the previous calls,
+  /// and are only equi-satisfiable with @p f together with their clauses.
   std::vector<Formula> Convert(const Formula& f);
 
+  /// Opens a scope. The definitions which are added after it are forgotten
+  /// by the matching Pop(), together with the clauses defining them.
+  void Push();
+
+  /// Forgets the definitions added since the matching Push().
+  void Pop();
+
   /// Returns a const reference of `map_` member.
   ///
   /// @note that this member `map_` is cleared at the beginning of `Convert`
-  /// method.
+  /// method. It only holds the definitions added by the last call.
   const std::map<Variable, Formula>& map() const { return map_; }
 
  private:
@@ -44,6 +60,11 @@ class TseitinCnfizer {
   // call.
   std::map<Variable, Formula> map_;
 
+  // The variable defined for each non-atomic subformula, by the previous
+  // calls to `Convert` as well. The formulas passed to `Convert` are not
+  // included, since their definitions are not added as equivalences.
+  ScopedUnorderedMap<Formula, Variable> definitions_;
+
   // To transform nested formulas inside of universal quantifications.
   const NaiveCnfizer naive_cnfizer_{};
 
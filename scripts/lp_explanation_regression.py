@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""Compares LP conflict explanation modes on the hong and powersystem benchmarks.
+
+For every benchmark, dReal is run once per --lp-explanation mode. The script
+checks the answer against the .expected file and reports the number of
+DPLL(T) iterations (theory CheckSat calls), the average explanation size and
+the running time for each mode.
+
+Usage:
+    scripts/lp_explanation_regression.py [--dreal bazel-bin/dreal/dreal]
+        [--lp-solver qsoptex] [--phase 1] [--timeout 600]
+        [--modes assertions,farkas] [benchmark-dir ...]
+"""
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import argparse
+import glob
+import os
+import re
+import subprocess
+import sys
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+ROOT = os.path.dirname(HERE)
+DEFAULT_DIRS = [
+    os.path.join(ROOT, 'dreal', 'test', 'smt2', 'hong'),
+    os.path.join(ROOT, 'dreal', 'test', 'smt2', 'powersystem'),
+]
+STAT_RE = re.compile(r'^(Total # of [^@]*?)\s*@\s*(.*?)\s*=\s*(\d+)\s*$')
+
+
+def expected_output(smt2, phase):
+    filename = smt2 + '.expected'
+    if not os.path.exists(filename):
+        filename += '_phase_{}'.format(phase)
+    if not os.path.exists(filename):
+        return None
+    with open(filename, 'r') as f:
+        return f.read().strip().splitlines()
+
+
+def run(args, smt2, mode):
+    env = dict(os.environ)
+    env['LD_LIBRARY_PATH'] = (os.path.join(ROOT, 'install', 'qsopt-ex', 'lib') +
+                              ':' + env.get('LD_LIBRARY_PATH', ''))
+    cmd = [args.dreal, smt2, '--lp-solver', args.lp_solver,
+           '--simplex-sat-phase', args.phase, '--lp-explanation', mode,
+           '--verbose', 'info']
+    start = time.time()
+    try:
+        output = subprocess.check_output(cmd, env=env,
+                                         stderr=subprocess.DEVNULL,
+                                         timeout=args.timeout).decode('UTF-8')
+    except subprocess.TimeoutExpired:
+        return None, {}, args.timeout
+    except subprocess.CalledProcessError as e:
+        return 'error {}'.format(e.returncode), {}, time.time() - start
+    elapsed = time.time() - start
+    answer = []
+    stats = {}
+    for line in output.splitlines():
+        m = STAT_RE.match(line)
+        if m:
+            stats[(m.group(1), m.group(2))] = int(m.group(3))
+        elif line.strip():
+            answer.append(line)
+    return answer, stats, elapsed
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('--dreal',
+                        default=os.path.join(ROOT, 'bazel-bin', 'dreal', 'dreal'))
+    parser.add_argument('--lp-solver', default='qsoptex',
+                        choices=['qsoptex', 'soplex'])
+    parser.add_argument('--phase', default='1', choices=['1', '2'])
+    parser.add_argument('--timeout', type=float, default=600)
+    parser.add_argument('--modes', default='assertions,farkas')
+    parser.add_argument('dirs', nargs='*', default=DEFAULT_DIRS)
+    args = parser.parse_args()
+    modes = args.modes.split(',')
+
+    smt2s = []
+    for d in args.dirs:
+        smt2s += sorted(glob.glob(os.path.join(d, '*.smt2')))
+
+    header = '{:<32}'.format('benchmark')
+    for mode in modes:
+        header += ' | {:>10} {:>8} {:>9}'.format(mode + ' it', 'avg.exp', 'sec')
+    print(header)
+    print('-' * len(header))
+
+    totals = {mode: [0, 0.0] for mode in modes}
+    failures = 0
+    for smt2 in smt2s:
+        expected = expected_output(smt2, args.phase)
+        row = '{:<32}'.format(os.path.basename(smt2))
+        for mode in modes:
+            answer, stats, elapsed = run(args, smt2, mode)
+            iterations = stats.get(('Total # of CheckSat', 'Theory level'), 0)
+            explanations = stats.get(
+                ('Total # of explanations', 'Theory level'), 0)
+            literals = stats.get(
+                ('Total # of literals in explanations', 'Theory level'), 0)
+            avg = literals / explanations if explanations else 0.0
+            if answer is None:
+                row += ' | {:>10} {:>8} {:>9}'.format('timeout', '-', '-')
+                continue
+            if expected is not None and answer[:len(expected)] != expected:
+                failures += 1
+                row += ' | {:>10} {:>8} {:>9}'.format('WRONG', '-', '-')
+                continue
+            totals[mode][0] += iterations
+            totals[mode][1] += elapsed
+            row += ' | {:>10} {:>8.1f} {:>9.2f}'.format(iterations, avg, elapsed)
+        print(row)
+        sys.stdout.flush()
+
+    print('-' * len(header))
+    row = '{:<32}'.format('total')
+    for mode in modes:
+        row += ' | {:>10} {:>8} {:>9.2f}'.format(totals[mode][0], '',
+                                                 totals[mode][1])
+    print(row)
+    return 1 if failures else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
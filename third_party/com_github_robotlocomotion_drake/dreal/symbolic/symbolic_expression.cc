@@ -1,6 +1,7 @@
 #include "dreal/symbolic/symbolic_expression.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
@@ -14,6 +15,7 @@
 #include "dreal/symbolic/symbolic_environment.h"
 #include "dreal/symbolic/symbolic_expression_cell.h"
 #include "dreal/symbolic/symbolic_formula.h"
+#include "dreal/symbolic/symbolic_hash_consing.h"
 #include "dreal/symbolic/symbolic_variable.h"
 #include "dreal/symbolic/symbolic_variables.h"
 #include "dreal/util/infty.h"
@@ -38,6 +40,18 @@ bool operator<(ExpressionKind k1, ExpressionKind k2) {
   return static_cast<int>(k1) < static_cast<int>(k2);
 }
 
+namespace {
+std::atomic<bool> hash_consing_enabled{false};
+}  // namespace
+
+void set_hash_consing(const bool enabled) {
+  hash_consing_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool is_hash_consing_enabled() {
+  return hash_consing_enabled.load(std::memory_order_relaxed);
+}
+
 namespace {
 
 // Returns true if @p v is represented by `int`.
@@ -60,6 +74,10 @@ Expression NegateAddition(const ExpressionAdd* e) {
 // Negates an addition expression.
 // - (E_1 + ... + E_n) => (-E_1 + ... + -E_n)
 Expression NegateAddition(ExpressionAdd* e) {
+  if (e->use_count() > 1 || e->is_interned()) {
+    // Shared with someone else. It must not be updated.
+    return NegateAddition(static_cast<const ExpressionAdd*>(e));
+  }
   return ExpressionAddFactory{e->get_constant(),
                               std::move(e->get_mutable_expr_to_coeff_map())}
       .Negate()
@@ -75,6 +93,10 @@ Expression NegateMultiplication(const ExpressionMul* e) {
 // Negates a multiplication expression.
 // - (c0 * E_1 * ... * E_n) => (-c0 * E_1 * ... * E_n)
 Expression NegateMultiplication(ExpressionMul* e) {
+  if (e->use_count() > 1 || e->is_interned()) {
+    // Shared with someone else. It must not be updated.
+    return NegateMultiplication(static_cast<const ExpressionMul*>(e));
+  }
   return ExpressionMulFactory{e->get_constant(),
                               std::move(e->get_mutable_base_to_exponent_map())}
       .Negate()
@@ -154,7 +176,12 @@ Expression::Expression(const double d) : Expression{make_cell(d)} {}
 
 Expression::Expression(ExpressionCell* ptr) : ptr_{ptr} {
   assert(ptr_ != nullptr);
-  ptr_->increase_rc();
+  if (ptr_->use_count() == 0 && is_hash_consing_enabled()) {
+    // A new cell.
+    ptr_ = HashConsingTable<ExpressionCell>::Intern(ptr_);
+  } else {
+    ptr_->increase_rc();
+  }
 }
 
 ExpressionKind Expression::get_kind() const {
@@ -229,6 +256,10 @@ bool Expression::EqualTo(const Expression& e) const {
   if (ptr_ == e.ptr_) {
     return true;
   }
+  if (ptr_->is_interned() && e.ptr_->is_interned()) {
+    // Two different hash-consed cells are never structurally equal.
+    return false;
+  }
   if (get_kind() != e.get_kind()) {
     return false;
   }
@@ -379,7 +410,7 @@ Expression& operator+=(Expression& lhs, const Expression& rhs) {
   // ExpressionAddFactory which holds intermediate terms and does
   // simplifications internally.
   if (is_addition(lhs)) {
-    if (lhs.ptr_->use_count() == 1) {
+    if (lhs.ptr_->use_count() == 1 && !lhs.ptr_->is_interned()) {
       return lhs =
                  ExpressionAddFactory{
                      get_constant_in_addition(lhs),
@@ -461,7 +492,7 @@ Expression operator-(const Expression& e) {
 }
 
 Expression operator-(Expression&& e) {
-  if (e.ptr_->use_count() == 1) {
+  if (e.ptr_->use_count() == 1 && !e.ptr_->is_interned()) {
     if (is_addition(e)) {
       return NegateAddition(to_addition(e));
     }
@@ -612,7 +643,7 @@ Expression& operator*=(Expression& lhs, const Expression& rhs) {
   ExpressionMulFactory mul_factory{};
   if (is_multiplication(lhs)) {
     // (e_1 * ... * e_n) * rhs
-    if (lhs.ptr_->use_count() == 1) {
+    if (lhs.ptr_->use_count() == 1 && !lhs.ptr_->is_interned()) {
       return lhs =
                  ExpressionMulFactory{
                      get_constant_in_multiplication(lhs),
@@ -101,6 +101,21 @@ using ExpressionSubstitution =
 using FormulaSubstitution =
     std::unordered_map<Variable, Formula, hash_value<Variable>>;
 
+/** Enables or disables the hash-consing of the expression and formula cells
+ * which are created from now on. It is disabled by default.
+ *
+ * When it is enabled, structurally equal expressions (resp. formulas) share a
+ * single cell, so that comparing two of them for equality is a pointer
+ * comparison and that common sub-terms are stored once. The cells are then
+ * never updated in place, which the arithmetic operators otherwise do when an
+ * operand is not shared. Cells created while it was disabled are left as
+ * they are.
+ */
+void set_hash_consing(bool enabled);
+
+/** Returns true if hash-consing is enabled. */
+bool is_hash_consing_enabled();
+
 /** Represents a symbolic form of an expression.
 
 Its syntax tree is as follows:
@@ -496,6 +511,7 @@ class Expression {
   friend class ExpressionAddFactory;
   friend class ExpressionMulFactory;
   friend class ExpressionCell;
+  friend class FormulaCell;
 
  private:
   static ExpressionCell* make_cell(const mpq_class& d);
@@ -18,6 +18,9 @@
 #include "dreal/symbolic/symbolic_environment.h"
 #include "dreal/symbolic/symbolic_expression.h"
 #include "dreal/symbolic/symbolic_expression_visitor.h"
+#include "dreal/symbolic/symbolic_formula_cell.h"
+#include "dreal/symbolic/symbolic_hash_consing.h"
+#include "dreal/symbolic/symbolic_lazy_variables.h"
 #include "dreal/symbolic/symbolic_variable.h"
 #include "dreal/symbolic/symbolic_variables.h"
 
@@ -212,18 +215,66 @@ ExpressionCell::ExpressionCell(const ExpressionKind k, const size_t hash,
       hash_{hash_combine(static_cast<size_t>(kind_), hash)},
       is_polynomial_{is_poly},
       include_ite_{include_ite},
-      variables_{std::move(variables)} {}
+      variables_{variables.empty() ? &EmptyVariables()
+                                   : new Variables(std::move(variables))} {}
+
+ExpressionCell::ExpressionCell(const ExpressionKind k, const size_t hash,
+                               const bool is_poly, const bool include_ite)
+    : kind_{k},
+      hash_{hash_combine(static_cast<size_t>(kind_), hash)},
+      is_polynomial_{is_poly},
+      include_ite_{include_ite} {}
+
+ExpressionCell::~ExpressionCell() {
+  if (interned_) {
+    HashConsingTable<ExpressionCell>::Erase(this);
+  }
+  const Variables* const vars{variables_.load(std::memory_order_acquire)};
+  if (vars != &EmptyVariables()) {
+    delete vars;
+  }
+}
 
 Expression ExpressionCell::GetExpression() { return Expression{this}; }
 
-const Variables& ExpressionCell::GetVariables() const { return variables_; }
+const Variables& ExpressionCell::GetVariables() const {
+  return *LoadOrComputeVariables(
+      &variables_, [this](Variables* const vars) { DoCollectVariables(vars); });
+}
+
+void ExpressionCell::CollectVariables(Variables* const vars) const {
+  const Variables* const cached{variables_.load(std::memory_order_acquire)};
+  if (cached != nullptr) {
+    vars->insert(*cached);
+  } else if (use_count() > 1) {
+    // A shared sub-expression might be visited many times. Its variables are
+    // worth caching.
+    vars->insert(GetVariables());
+  } else {
+    DoCollectVariables(vars);
+  }
+}
+
+void ExpressionCell::DoCollectVariables(Variables* const) const {}
+
+void ExpressionCell::CollectVariablesOf(const Expression& e,
+                                        Variables* const vars) {
+  e.ptr_->CollectVariables(vars);
+}
+
+void ExpressionCell::CollectVariablesOf(const Formula& f,
+                                        Variables* const vars) {
+  f.ptr_->CollectFreeVariables(vars);
+}
 
 UnaryExpressionCell::UnaryExpressionCell(const ExpressionKind k,
                                          const Expression& e,
                                          const bool is_poly)
-    : ExpressionCell{k, e.get_hash(), is_poly, e.include_ite(),
-                     e.GetVariables()},
-      e_{e} {}
+    : ExpressionCell{k, e.get_hash(), is_poly, e.include_ite()}, e_{e} {}
+
+void UnaryExpressionCell::DoCollectVariables(Variables* const vars) const {
+  CollectVariablesOf(e_, vars);
+}
 
 bool UnaryExpressionCell::EqualTo(const ExpressionCell& e) const {
   // Expression::EqualTo guarantees the following assertion.
@@ -249,11 +300,15 @@ BinaryExpressionCell::BinaryExpressionCell(const ExpressionKind k,
                                            const Expression& e2,
                                            const bool is_poly)
     : ExpressionCell{k, hash_combine(e1.get_hash(), e2), is_poly,
-                     e1.include_ite() || e2.include_ite(),
-                     e1.GetVariables() + e2.GetVariables()},
+                     e1.include_ite() || e2.include_ite()},
       e1_{e1},
       e2_{e2} {}
 
+void BinaryExpressionCell::DoCollectVariables(Variables* const vars) const {
+  CollectVariablesOf(e1_, vars);
+  CollectVariablesOf(e2_, vars);
+}
+
 bool BinaryExpressionCell::EqualTo(const ExpressionCell& e) const {
   // Expression::EqualTo guarantees the following assertion.
   assert(get_kind() == e.get_kind());
@@ -477,20 +532,16 @@ ExpressionAdd::ExpressionAdd(const mpq_class& constant,
     : ExpressionCell{ExpressionKind::Add,
                      hash_combine(hash<mpq_class>{}(constant), expr_to_coeff_map),
                      determine_polynomial(expr_to_coeff_map),
-                     determine_include_ite(expr_to_coeff_map),
-                     ExtractVariables(expr_to_coeff_map)},
+                     determine_include_ite(expr_to_coeff_map)},
       constant_(constant),
       expr_to_coeff_map_{std::move(expr_to_coeff_map)} {
   assert(!expr_to_coeff_map_.empty());
 }
 
-Variables ExpressionAdd::ExtractVariables(
-    const std::map<Expression, mpq_class>& expr_to_coeff_map) {
-  Variables ret{};
-  for (const auto& p : expr_to_coeff_map) {
-    ret.insert(p.first.GetVariables());
+void ExpressionAdd::DoCollectVariables(Variables* const vars) const {
+  for (const auto& p : expr_to_coeff_map_) {
+    CollectVariablesOf(p.first, vars);
   }
-  return ret;
 }
 
 bool ExpressionAdd::EqualTo(const ExpressionCell& e) const {
@@ -739,21 +790,17 @@ ExpressionMul::ExpressionMul(const mpq_class& constant,
                      hash_combine(hash<mpq_class>{}(constant),
                                   base_to_exponent_map),
                      determine_polynomial(base_to_exponent_map),
-                     determine_include_ite(base_to_exponent_map),
-                     ExtractVariables(base_to_exponent_map)},
+                     determine_include_ite(base_to_exponent_map)},
       constant_(constant),
       base_to_exponent_map_{std::move(base_to_exponent_map)} {
   assert(!base_to_exponent_map_.empty());
 }
 
-Variables ExpressionMul::ExtractVariables(
-    const std::map<Expression, Expression>& base_to_exponent_map) {
-  Variables ret{};
-  for (const auto& p : base_to_exponent_map) {
-    ret.insert(p.first.GetVariables());
-    ret.insert(p.second.GetVariables());
+void ExpressionMul::DoCollectVariables(Variables* const vars) const {
+  for (const auto& p : base_to_exponent_map_) {
+    CollectVariablesOf(p.first, vars);
+    CollectVariablesOf(p.second, vars);
   }
-  return ret;
 }
 
 bool ExpressionMul::EqualTo(const ExpressionCell& e) const {
@@ -1996,18 +2043,15 @@ ExpressionIfThenElse::ExpressionIfThenElse(const Formula& f_cond,
     : ExpressionCell{ExpressionKind::IfThenElse,
                      hash_combine(hash_value<Formula>{}(f_cond), e_then,
                                   e_else),
-                     false, true, ExtractVariables(f_cond, e_then, e_else)},
+                     false, true},
       f_cond_{f_cond},
       e_then_{e_then},
       e_else_{e_else} {}
 
-Variables ExpressionIfThenElse::ExtractVariables(const Formula& f_cond,
-                                                 const Expression& e_then,
-                                                 const Expression& e_else) {
-  Variables ret{f_cond.GetFreeVariables()};
-  ret.insert(e_then.GetVariables());
-  ret.insert(e_else.GetVariables());
-  return ret;
+void ExpressionIfThenElse::DoCollectVariables(Variables* const vars) const {
+  CollectVariablesOf(f_cond_, vars);
+  CollectVariablesOf(e_then_, vars);
+  CollectVariablesOf(e_else_, vars);
 }
 
 bool ExpressionIfThenElse::EqualTo(const ExpressionCell& e) const {
@@ -2087,10 +2131,15 @@ ExpressionUninterpretedFunction::ExpressionUninterpretedFunction(
     const string& name, const Variables& vars)
     : ExpressionCell{ExpressionKind::UninterpretedFunction,
                      hash_combine(hash_value<string>{}(name), vars), false,
-                     false, vars},
+                     false},
       name_{name},
       variables_{vars} {}
 
+void ExpressionUninterpretedFunction::DoCollectVariables(
+    Variables* const vars) const {
+  vars->insert(variables_);
+}
+
 bool ExpressionUninterpretedFunction::EqualTo(const ExpressionCell& e) const {
   // Expression::EqualTo guarantees the following assertion.
   assert(get_kind() == e.get_kind());
@@ -33,9 +33,14 @@ class ExpressionCell {
   /** Returns hash value. */
   size_t get_hash() const { return hash_; }
 
-  /** Collects variables in expression. */
+  /** Collects variables in expression. Unless they were given at
+   * construction, they are computed on the first call and cached. */
   const Variables& GetVariables() const;
 
+  /** Adds the variables in expression to @p vars. Unlike GetVariables(), it
+   * does not cache them, except in the sub-expressions which are shared. */
+  void CollectVariables(Variables* vars) const;
+
   /** Checks structural equality. */
   virtual bool EqualTo(const ExpressionCell& c) const = 0;
 
@@ -81,6 +86,10 @@ class ExpressionCell {
     return atomic_load_explicit(&rc_, std::memory_order_acquire);
   }
 
+  /** Returns true if this cell is hash-consed. It is then shared by all the
+   * structurally equal expressions, and must not be updated in place. */
+  bool is_interned() const { return interned_; }
+
   /** Copy-constructs an ExpressionCell from an lvalue. (DELETED) */
   ExpressionCell(const ExpressionCell& e) = delete;
 
@@ -96,21 +105,34 @@ class ExpressionCell {
  protected:
   /** Default constructor. */
   ExpressionCell() = default;
-  /** Constructs ExpressionCell of kind @p k with @p hash, @p is_poly, and @p
-   * include_ite. */
+  /** Constructs ExpressionCell of kind @p k with @p hash, @p is_poly, @p
+   * include_ite, and @p variables. */
   ExpressionCell(ExpressionKind k, size_t hash, bool is_poly, bool include_ite,
                  Variables variables);
-  /** Default destructor. */
-  virtual ~ExpressionCell() = default;
+  /** Constructs ExpressionCell of kind @p k with @p hash, @p is_poly, and @p
+   * include_ite, whose variables are collected by DoCollectVariables() when
+   * they are needed. */
+  ExpressionCell(ExpressionKind k, size_t hash, bool is_poly, bool include_ite);
+  /** Destructor. Removes this cell from the hash-consing table. */
+  virtual ~ExpressionCell();
   /** Returns an expression pointing to this ExpressionCell. */
   Expression GetExpression();
+  /** Adds the variables of the arguments of this cell to @p vars. It is only
+   * called if the variables were not given at construction. */
+  virtual void DoCollectVariables(Variables* vars) const;
+  /** Adds the variables in @p e to @p vars. */
+  static void CollectVariablesOf(const Expression& e, Variables* vars);
+  /** Adds the free variables in @p f to @p vars. */
+  static void CollectVariablesOf(const Formula& f, Variables* vars);
 
  private:
   const ExpressionKind kind_{};
   const size_t hash_{};
   const bool is_polynomial_{false};
   const bool include_ite_{false};
-  const Variables variables_;
+  // Owned by this cell, except for the shared empty set. Null until it is
+  // computed.
+  mutable std::atomic<const Variables*> variables_{nullptr};
 
   // Reference counter.
   mutable std::atomic<unsigned> rc_{0};
@@ -123,8 +145,13 @@ class ExpressionCell {
     }
   }
 
+  // Set once this cell is in the hash-consing table.
+  bool interned_{false};
+
   // So that Expression can call {increase,decrease}_rc.
   friend Expression;
+  template <typename Cell>
+  friend class HashConsingTable;
 };
 
 /** Represents the base class for unary expressions.  */
@@ -158,6 +185,7 @@ class UnaryExpressionCell : public ExpressionCell {
   /** Constructs UnaryExpressionCell of kind @p k with @p hash, @p e, @p
    * is_poly. */
   UnaryExpressionCell(ExpressionKind k, const Expression& e, bool is_poly);
+  void DoCollectVariables(Variables* vars) const override;
   /** Returns the evaluation result f(@p v ). */
   virtual mpq_class DoEvaluate(const mpq_class& v) const = 0;
 
@@ -201,6 +229,7 @@ class BinaryExpressionCell : public ExpressionCell {
    */
   BinaryExpressionCell(ExpressionKind k, const Expression& e1,
                        const Expression& e2, bool is_poly);
+  void DoCollectVariables(Variables* vars) const override;
   /** Returns the evaluation result f(@p v1, @p v2 ). */
   virtual mpq_class DoEvaluate(const mpq_class& v1, const mpq_class& v2) const = 0;
 
@@ -320,9 +349,10 @@ class ExpressionAdd : public ExpressionCell {
     return expr_to_coeff_map_;
   }
 
+ protected:
+  void DoCollectVariables(Variables* vars) const override;
+
  private:
-  static Variables ExtractVariables(
-      const std::map<Expression, mpq_class>& expr_to_coeff_map);
   std::ostream& DisplayTerm(std::ostream& os, bool print_plus, const mpq_class& coeff,
                             const Expression& term) const;
 
@@ -441,9 +471,10 @@ class ExpressionMul : public ExpressionCell {
     return base_to_exponent_map_;
   }
 
+ protected:
+  void DoCollectVariables(Variables* vars) const override;
+
  private:
-  static Variables ExtractVariables(
-      const std::map<Expression, Expression>& base_to_exponent_map);
   std::ostream& DisplayTerm(std::ostream& os, bool print_mul,
                             const Expression& base,
                             const Expression& exponent) const;
@@ -822,11 +853,10 @@ class ExpressionIfThenElse : public ExpressionCell {
   /** Returns the 'else' expression. */
   const Expression& get_else_expression() const { return e_else_; }
 
- private:
-  static Variables ExtractVariables(const Formula& f_cond,
-                                    const Expression& e_then,
-                                    const Expression& e_else);
+ protected:
+  void DoCollectVariables(Variables* vars) const override;
 
+ private:
   const Formula f_cond_;
   const Expression e_then_;
   const Expression e_else_;
@@ -851,6 +881,9 @@ class ExpressionUninterpretedFunction : public ExpressionCell {
   /** Returns the name of this expression. */
   const std::string& get_name() const { return name_; }
 
+ protected:
+  void DoCollectVariables(Variables* vars) const override;
+
  private:
   const std::string name_;
   const Variables variables_;
@@ -10,6 +10,7 @@
 #include "dreal/symbolic/symbolic_environment.h"
 #include "dreal/symbolic/symbolic_expression.h"
 #include "dreal/symbolic/symbolic_formula_cell.h"
+#include "dreal/symbolic/symbolic_hash_consing.h"
 #include "dreal/symbolic/symbolic_variable.h"
 #include "dreal/symbolic/symbolic_variables.h"
 
@@ -60,7 +61,14 @@ Formula::~Formula() {
   }
 }
 
-Formula::Formula(FormulaCell* const ptr) : ptr_{ptr} { ptr_->increase_rc(); }
+Formula::Formula(FormulaCell* const ptr) : ptr_{ptr} {
+  if (ptr_->use_count() == 0 && is_hash_consing_enabled()) {
+    // A new cell.
+    ptr_ = HashConsingTable<FormulaCell>::Intern(ptr_);
+  } else {
+    ptr_->increase_rc();
+  }
+}
 
 Formula::Formula(const Variable& var) : Formula{new FormulaVar(var)} {}
 
@@ -86,6 +94,10 @@ bool Formula::EqualTo(const Formula& f) const {
     // pointer equality
     return true;
   }
+  if (ptr_->is_interned() && f.ptr_->is_interned()) {
+    // Two different hash-consed cells are never structurally equal.
+    return false;
+  }
   if (get_kind() != f.get_kind()) {
     return false;
   }
@@ -98,6 +110,9 @@ bool Formula::EqualTo(const Formula& f) const {
 }
 
 bool Formula::Less(const Formula& f) const {
+  if (ptr_ == f.ptr_) {
+    return false;  // this equals to f, not less-than.
+  }
   const FormulaKind k1{get_kind()};
   const FormulaKind k2{f.get_kind()};
   if (k1 < k2) {
@@ -204,7 +219,7 @@ Formula Formula::make_conjunction(Formula& f1, const Formula& f2) {
     return f1;
   }
   if (is_conjunction(f1)) {
-    if (f1.ptr_->use_count() == 1) {
+    if (f1.ptr_->use_count() == 1 && !f1.ptr_->is_interned()) {
       set<Formula>& operands{to_nary(f1)->get_mutable_operands()};  // reference
       MergeConjunction(f2, &operands);
       return f1 = Formula{new FormulaAnd(std::move(operands))};
@@ -253,7 +268,7 @@ Formula make_conjunction(const set<Formula>& formulas) {
     return *(operands.begin());
   }
   // TODO(soonho-tri): Returns False if both f and ¬f appear in operands.
-  return Formula{new FormulaAnd(operands)};
+  return Formula{new FormulaAnd(std::move(operands))};
 }
 
 Formula operator&&(const Formula& f1, const Formula& f2) {
@@ -332,7 +347,7 @@ Formula Formula::make_disjunction(Formula& f1, const Formula& f2) {
     return f1;
   }
   if (is_disjunction(f1)) {
-    if (f1.ptr_->use_count() == 1) {
+    if (f1.ptr_->use_count() == 1 && !f1.ptr_->is_interned()) {
       set<Formula>& operands{to_nary(f1)->get_mutable_operands()};  // reference
       MergeDisjunction(f2, &operands);
       return f1 = Formula{new FormulaOr(std::move(operands))};
@@ -381,7 +396,7 @@ Formula make_disjunction(const set<Formula>& formulas) {
     return *(operands.begin());
   }
   // TODO(soonho-tri): Returns True if both f and ¬f appear in operands.
-  return Formula{new FormulaOr(operands)};
+  return Formula{new FormulaOr(std::move(operands))};
 }
 
 Formula operator||(const Formula& f1, const Formula& f2) {
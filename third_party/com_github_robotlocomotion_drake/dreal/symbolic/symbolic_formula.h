@@ -254,6 +254,7 @@ class Formula {
   static Formula make_disjunction(Formula& f1, const Formula& f2);
 
   friend FormulaCell;
+  friend ExpressionCell;
   friend Formula forall(const Variables& vars, const Formula& f);
   friend Formula make_conjunction(const std::set<Formula>& formulas);
   friend Formula make_disjunction(const std::set<Formula>& formulas);
@@ -11,7 +11,10 @@
 #include "dreal/symbolic/hash.h"
 #include "dreal/symbolic/symbolic_environment.h"
 #include "dreal/symbolic/symbolic_expression.h"
+#include "dreal/symbolic/symbolic_expression_cell.h"
 #include "dreal/symbolic/symbolic_formula.h"
+#include "dreal/symbolic/symbolic_hash_consing.h"
+#include "dreal/symbolic/symbolic_lazy_variables.h"
 #include "dreal/symbolic/symbolic_variable.h"
 #include "dreal/symbolic/symbolic_variables.h"
 
@@ -34,11 +37,56 @@ FormulaCell::FormulaCell(const FormulaKind k, const size_t hash,
     : kind_{k},
       hash_{hash_combine(hash, static_cast<size_t>(kind_))},
       include_ite_{include_ite},
-      variables_{std::move(variables)} {}
+      variables_{variables.empty() ? &EmptyVariables()
+                                   : new Variables(std::move(variables))} {}
+
+FormulaCell::FormulaCell(const FormulaKind k, const size_t hash,
+                         const bool include_ite)
+    : kind_{k},
+      hash_{hash_combine(hash, static_cast<size_t>(kind_))},
+      include_ite_{include_ite} {}
+
+FormulaCell::~FormulaCell() {
+  if (interned_) {
+    HashConsingTable<FormulaCell>::Erase(this);
+  }
+  const Variables* const vars{variables_.load(std::memory_order_acquire)};
+  if (vars != &EmptyVariables()) {
+    delete vars;
+  }
+}
 
 Formula FormulaCell::GetFormula() { return Formula{this}; }
 
-const Variables& FormulaCell::GetFreeVariables() const { return variables_; }
+const Variables& FormulaCell::GetFreeVariables() const {
+  return *LoadOrComputeVariables(&variables_, [this](Variables* const vars) {
+    DoCollectFreeVariables(vars);
+  });
+}
+
+void FormulaCell::CollectFreeVariables(Variables* const vars) const {
+  const Variables* const cached{variables_.load(std::memory_order_acquire)};
+  if (cached != nullptr) {
+    vars->insert(*cached);
+  } else if (use_count() > 1) {
+    // A shared sub-formula might be visited many times. Its variables are
+    // worth caching.
+    vars->insert(GetFreeVariables());
+  } else {
+    DoCollectFreeVariables(vars);
+  }
+}
+
+void FormulaCell::DoCollectFreeVariables(Variables* const) const {}
+
+void FormulaCell::CollectVariablesOf(const Expression& e,
+                                     Variables* const vars) {
+  e.ptr_->CollectVariables(vars);
+}
+
+void FormulaCell::CollectVariablesOf(const Formula& f, Variables* const vars) {
+  f.ptr_->CollectFreeVariables(vars);
+}
 
 bool FormulaCell::include_ite() const { return include_ite_; }
 
@@ -46,11 +94,16 @@ RelationalFormulaCell::RelationalFormulaCell(const FormulaKind k,
                                              const Expression& lhs,
                                              const Expression& rhs)
     : FormulaCell{k, hash_combine(lhs.get_hash(), rhs),
-                  lhs.include_ite() || rhs.include_ite(),
-                  lhs.GetVariables() + rhs.GetVariables()},
+                  lhs.include_ite() || rhs.include_ite()},
       e_lhs_{lhs},
       e_rhs_{rhs} {}
 
+void RelationalFormulaCell::DoCollectFreeVariables(
+    Variables* const vars) const {
+  CollectVariablesOf(e_lhs_, vars);
+  CollectVariablesOf(e_rhs_, vars);
+}
+
 bool RelationalFormulaCell::EqualTo(const FormulaCell& f) const {
   // Formula::EqualTo guarantees the following assertion.
   assert(get_kind() == f.get_kind());
@@ -74,16 +127,13 @@ bool RelationalFormulaCell::Less(const FormulaCell& f) const {
 NaryFormulaCell::NaryFormulaCell(const FormulaKind k, set<Formula> formulas)
     : FormulaCell{k, hash_value<set<Formula>>{}(formulas),
                   any_of(formulas.begin(), formulas.end(),
-                         [](const Formula& f) { return f.include_ite(); }),
-                  ExtractFreeVariables(formulas)},
+                         [](const Formula& f) { return f.include_ite(); })},
       formulas_{std::move(formulas)} {}
 
-Variables NaryFormulaCell::ExtractFreeVariables(const set<Formula>& formulas) {
-  Variables ret{};
-  for (const auto& f : formulas) {
-    ret.insert(f.GetFreeVariables());
+void NaryFormulaCell::DoCollectFreeVariables(Variables* const vars) const {
+  for (const auto& f : formulas_) {
+    CollectVariablesOf(f, vars);
   }
-  return ret;
 }
 
 bool NaryFormulaCell::EqualTo(const FormulaCell& f) const {
@@ -505,9 +555,11 @@ ostream& FormulaOr::Display(ostream& os) const {
 }
 
 FormulaNot::FormulaNot(const Formula& f)
-    : FormulaCell{FormulaKind::Not, f.get_hash(), f.include_ite(),
-                  f.GetFreeVariables()},
-      f_{f} {}
+    : FormulaCell{FormulaKind::Not, f.get_hash(), f.include_ite()}, f_{f} {}
+
+void FormulaNot::DoCollectFreeVariables(Variables* const vars) const {
+  CollectVariablesOf(f_, vars);
+}
 
 bool FormulaNot::EqualTo(const FormulaCell& f) const {
   // Formula::EqualTo guarantees the following assertion.
@@ -45,8 +45,13 @@ class FormulaCell {
   FormulaKind get_kind() const { return kind_; }
   /** Returns hash of formula. */
   size_t get_hash() const { return hash_; }
-  /** Returns set of free variables in formula. */
+  /** Returns set of free variables in formula. Unless they were given at
+   * construction, they are computed on the first call and cached. */
   const Variables& GetFreeVariables() const;
+  /** Adds the free variables in formula to @p vars. Unlike
+   * GetFreeVariables(), it does not cache them, except in the sub-formulas
+   * and sub-expressions which are shared. */
+  void CollectFreeVariables(Variables* vars) const;
   /** Checks structural equality. */
   virtual bool EqualTo(const FormulaCell& c) const = 0;
   /** Checks ordering. */
@@ -67,24 +72,40 @@ class FormulaCell {
     return atomic_load_explicit(&rc_, std::memory_order_acquire);
   }
 
+  /** Returns true if this cell is hash-consed. It is then shared by all the
+   * structurally equal formulas, and must not be updated in place. */
+  bool is_interned() const { return interned_; }
+
   /// Returns true if this symbolic formula includes an ITE (If-Then-Else)
   /// expression.
   bool include_ite() const;
 
  protected:
-  /** Construct FormulaCell of kind @p k with @p hash. */
+  /** Construct FormulaCell of kind @p k with @p hash and @p variables. */
   FormulaCell(FormulaKind k, size_t hash, bool include_ite,
               Variables variables);
-  /** Default destructor. */
-  virtual ~FormulaCell() = default;
+  /** Construct FormulaCell of kind @p k with @p hash, whose free variables
+   * are collected by DoCollectFreeVariables() when they are needed. */
+  FormulaCell(FormulaKind k, size_t hash, bool include_ite);
+  /** Destructor. Removes this cell from the hash-consing table. */
+  virtual ~FormulaCell();
   /** Returns a Formula pointing to this FormulaCell. */
   Formula GetFormula();
+  /** Adds the free variables of the operands of this cell to @p vars. It is
+   * only called if the variables were not given at construction. */
+  virtual void DoCollectFreeVariables(Variables* vars) const;
+  /** Adds the variables in @p e to @p vars. */
+  static void CollectVariablesOf(const Expression& e, Variables* vars);
+  /** Adds the free variables in @p f to @p vars. */
+  static void CollectVariablesOf(const Formula& f, Variables* vars);
 
  private:
   const FormulaKind kind_{};
   const size_t hash_{};
   const bool include_ite_{false};
-  const Variables variables_;
+  // Owned by this cell, except for the shared empty set. Null until it is
+  // computed.
+  mutable std::atomic<const Variables*> variables_{nullptr};
 
   // Reference counter.
   mutable std::atomic<unsigned> rc_{0};
@@ -97,8 +118,13 @@ class FormulaCell {
     }
   }
 
+  // Set once this cell is in the hash-consing table.
+  bool interned_{false};
+
   // So that Expression can call {increase,decrease}_rc.
   friend Formula;
+  template <typename Cell>
+  friend class HashConsingTable;
 };
 
 /** Represents the base class for relational operators (==, !=, <, <=, >, >=).
@@ -128,6 +154,9 @@ class RelationalFormulaCell : public FormulaCell {
   /** Returns the expression on right-hand-side. */
   const Expression& get_rhs_expression() const { return e_rhs_; }
 
+ protected:
+  void DoCollectFreeVariables(Variables* vars) const override;
+
  private:
   const Expression e_lhs_;
   const Expression e_rhs_;
@@ -164,10 +193,9 @@ class NaryFormulaCell : public FormulaCell {
 
  protected:
   std::ostream& DisplayWithOp(std::ostream& os, const std::string& op) const;
+  void DoCollectFreeVariables(Variables* vars) const override;
 
  private:
-  static Variables ExtractFreeVariables(const std::set<Formula>& formulas);
-
   std::set<Formula> formulas_;
 };
 
@@ -322,6 +350,9 @@ class FormulaNot : public FormulaCell {
   /** Returns the operand. */
   const Formula& get_operand() const { return f_; }
 
+ protected:
+  void DoCollectFreeVariables(Variables* vars) const override;
+
  private:
   const Formula f_;
 };
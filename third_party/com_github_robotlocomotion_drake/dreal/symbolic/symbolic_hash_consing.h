@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "dreal/symbolic/never_destroyed.h"
+
+namespace dreal {
+namespace drake {
+namespace symbolic {
+
+/** Table of the hash-consed cells of type @p Cell, which is either
+ * ExpressionCell or FormulaCell.
+ *
+ * A cell is interned when it is wrapped into an Expression or a Formula for
+ * the first time, if hash-consing is enabled. If the table already has a
+ * cell which is structurally equal, the new one is deleted and the existing
+ * one is shared instead. The table does not own its cells: a cell removes
+ * itself when its reference count drops to zero.
+ *
+ * The table is split into shards, selected by the hash of a cell, each with
+ * its own mutex so that the threads of a portfolio rarely wait for each
+ * other.
+ */
+template <typename Cell>
+class HashConsingTable {
+ public:
+  /** Returns a cell which is structurally equal to @p cell, with its
+   * reference count increased. @p cell must not have been shared yet. It is
+   * either interned and returned, or deleted.
+   */
+  static Cell* Intern(Cell* const cell) {
+    const size_t hash{cell->get_hash()};
+    Shard& s{shard(hash)};
+    Cell* result{nullptr};
+    // The candidates which turn out to be different are released once the
+    // mutex is unlocked, since releasing a cell might destroy it.
+    std::vector<Cell*> released;
+    {
+      std::lock_guard<std::mutex> guard{s.mutex};
+      const auto range = s.cells.equal_range(hash);
+      for (auto it = range.first; it != range.second; ++it) {
+        Cell* const candidate{it->second};
+        if (candidate->get_kind() != cell->get_kind() || !Acquire(candidate)) {
+          continue;
+        }
+        if (candidate->EqualTo(*cell)) {
+          result = candidate;
+          break;
+        }
+        released.push_back(candidate);
+      }
+      if (result == nullptr) {
+        cell->interned_ = true;
+        cell->increase_rc();
+        s.cells.emplace(hash, cell);
+        result = cell;
+      }
+    }
+    for (Cell* const candidate : released) {
+      candidate->decrease_rc();
+    }
+    if (result != cell) {
+      delete cell;
+    }
+    return result;
+  }
+
+  /** Removes @p cell, which is being destroyed, from the table. */
+  static void Erase(const Cell* const cell) {
+    const size_t hash{cell->get_hash()};
+    Shard& s{shard(hash)};
+    std::lock_guard<std::mutex> guard{s.mutex};
+    const auto range = s.cells.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == cell) {
+        s.cells.erase(it);
+        return;
+      }
+    }
+  }
+
+ private:
+  static constexpr size_t kNumShards{64};
+
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_multimap<size_t, Cell*> cells;
+  };
+
+  static Shard& shard(const size_t hash) {
+    static never_destroyed<std::array<Shard, kNumShards>> shards;
+    return shards.access()[hash % kNumShards];
+  }
+
+  // Takes a reference to @p cell, unless it is already being destroyed.
+  static bool Acquire(Cell* const cell) {
+    unsigned rc{cell->rc_.load(std::memory_order_relaxed)};
+    do {
+      if (rc == 0) {
+        return false;
+      }
+    } while (!cell->rc_.compare_exchange_weak(rc, rc + 1,
+                                              std::memory_order_acquire,
+                                              std::memory_order_relaxed));
+    return true;
+  }
+};
+
+}  // namespace symbolic
+}  // namespace drake
+}  // namespace dreal
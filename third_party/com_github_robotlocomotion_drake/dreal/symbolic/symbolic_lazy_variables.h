@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include "dreal/symbolic/never_destroyed.h"
+#include "dreal/symbolic/symbolic_variables.h"
+
+namespace dreal {
+namespace drake {
+namespace symbolic {
+
+/** Returns the empty set of variables, which is shared by all the cells
+ * without variables (constants, True, False, ...). */
+inline const Variables& EmptyVariables() {
+  static const never_destroyed<Variables> empty;
+  return empty.access();
+}
+
+/** Returns the set of variables cached in @p cache. If there is none yet, it
+ * is computed by calling @p collect with an empty set to fill, and stored in
+ * @p cache, which then owns it.
+ *
+ * Threads sharing a cell may compute its variables at the same time. Only the
+ * first result is kept, and the others are discarded.
+ */
+template <typename Collect>
+const Variables* LoadOrComputeVariables(std::atomic<const Variables*>* cache,
+                                        Collect collect) {
+  const Variables* cached{cache->load(std::memory_order_acquire)};
+  if (cached != nullptr) {
+    return cached;
+  }
+  auto vars = std::make_unique<Variables>();
+  collect(vars.get());
+  if (cache->compare_exchange_strong(cached, vars.get(),
+                                     std::memory_order_acq_rel,
+                                     std::memory_order_acquire)) {
+    return vars.release();
+  }
+  // Another thread was faster. `cached` is its result.
+  return cached;
+}
+
+}  // namespace symbolic
+}  // namespace drake
+}  // namespace dreal
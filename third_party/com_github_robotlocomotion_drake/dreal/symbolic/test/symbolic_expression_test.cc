@@ -1665,6 +1665,19 @@ TEST_F(SymbolicExpressionTest, GetVariables) {
   EXPECT_EQ(vars2.size(), 3u);
 }
 
+TEST_F(SymbolicExpressionTest, GetVariablesSharedSubExpressions) {
+  // The variables are computed lazily. A sub-expression which appears twice
+  // at every level must not be visited an exponential number of times.
+  Expression e{x_ + y_};
+  for (int i = 0; i < 100; ++i) {
+    e = sin(e) + cos(e) * z_;
+  }
+  const Variables& vars{e.GetVariables()};
+  EXPECT_EQ(vars, Variables({var_x_, var_y_, var_z_}));
+  // The result is cached.
+  EXPECT_EQ(&e.GetVariables(), &vars);
+}
+
 TEST_F(SymbolicExpressionTest, Swap) {
   Expression e1{sin(x_ + y_ * z_)};
   Expression e2{(x_ * x_ + pow(y_, 2) * z_)};
@@ -768,6 +768,18 @@ TEST_F(SymbolicFormulaTest, GetFreeVariables) {
   EXPECT_TRUE(vars5.include(var_y_));
 }
 
+TEST_F(SymbolicFormulaTest, GetFreeVariablesSharedSubFormulas) {
+  // A sub-formula which appears twice at every level must not be visited an
+  // exponential number of times.
+  Formula f{x_ + y_ > 0};
+  for (int i = 0; i < 100; ++i) {
+    f = (f && z_ > i) || (!f && z_ < i);
+  }
+  const Variables& vars{f.GetFreeVariables()};
+  EXPECT_EQ(vars, Variables({var_x_, var_y_, var_z_}));
+  EXPECT_EQ(&f.GetFreeVariables(), &vars);
+}
+
 TEST_F(SymbolicFormulaTest, ToString) {
   EXPECT_EQ(f1_.to_string(), "((x + y) > 0)");
   EXPECT_EQ(f2_.to_string(), "((x * y) < 5)");
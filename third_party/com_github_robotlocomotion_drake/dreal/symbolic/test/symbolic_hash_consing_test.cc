@@ -0,0 +1,127 @@
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dreal/symbolic/symbolic_expression.h"
+#include "dreal/symbolic/symbolic_expression_cell.h"
+#include "dreal/symbolic/symbolic_formula.h"
+#include "dreal/symbolic/symbolic_formula_cell.h"
+#include "dreal/symbolic/test/symbolic_test_util.h"
+
+namespace dreal {
+namespace drake {
+namespace symbolic {
+namespace {
+
+using std::set;
+using std::thread;
+using std::vector;
+
+using test::ExprEqual;
+using test::FormulaEqual;
+
+class SymbolicHashConsingTest : public ::testing::Test {
+  ::dreal::drake::symbolic::test::DrakeSymbolicGuard guard_;
+
+ protected:
+  void SetUp() override { set_hash_consing(true); }
+  void TearDown() override { set_hash_consing(false); }
+
+  const Variable x_{"x", Variable::Type::CONTINUOUS};
+  const Variable y_{"y", Variable::Type::CONTINUOUS};
+  const Variable b_{"b", Variable::Type::BOOLEAN};
+};
+
+TEST_F(SymbolicHashConsingTest, ExpressionsShareCells) {
+  const Expression e1{2 * x_ + sin(y_)};
+  const Expression e2{2 * x_ + sin(y_)};
+  const Expression e3{2 * x_ + cos(y_)};
+  EXPECT_TRUE(is_addition(e1));
+  EXPECT_TRUE(to_addition(e1)->is_interned());
+  EXPECT_EQ(to_addition(e1), to_addition(e2));
+  EXPECT_NE(to_addition(e1), to_addition(e3));
+  EXPECT_PRED2(ExprEqual, e1, e2);
+  EXPECT_FALSE(e1.EqualTo(e3));
+  EXPECT_EQ(e1.Less(e3), !e3.Less(e1));
+}
+
+TEST_F(SymbolicHashConsingTest, FormulasShareCells) {
+  const Formula f1{x_ + y_ <= 3 && b_};
+  const Formula f2{b_ && x_ + y_ <= 3};
+  const Formula f3{x_ + y_ < 3 && b_};
+  EXPECT_TRUE(to_nary(f1)->is_interned());
+  EXPECT_EQ(to_nary(f1), to_nary(f2));
+  EXPECT_NE(to_nary(f1), to_nary(f3));
+  EXPECT_PRED2(FormulaEqual, f1, f2);
+  EXPECT_FALSE(f1.EqualTo(f3));
+}
+
+TEST_F(SymbolicHashConsingTest, SharedCellsAreNotUpdatedInPlace) {
+  const Expression e1{x_ + y_};
+  Expression e2{x_ + y_};
+  e2 += 3;
+  EXPECT_PRED2(ExprEqual, e1, x_ + y_);
+  EXPECT_PRED2(ExprEqual, e2, x_ + y_ + 3);
+  Expression e3{x_ + y_};
+  const Expression e4{-std::move(e3)};
+  EXPECT_PRED2(ExprEqual, e1, x_ + y_);
+  EXPECT_PRED2(ExprEqual, e4, -x_ - y_);
+
+  const Formula f1{x_ <= 1 && y_ <= 1};
+  Formula f2{x_ <= 1 && y_ <= 1};
+  f2 = std::move(f2) && b_;
+  EXPECT_EQ(get_operands(f1).size(), 2U);
+  EXPECT_EQ(get_operands(f2).size(), 3U);
+}
+
+TEST_F(SymbolicHashConsingTest, CellsAreReleased) {
+  // A cell which is no longer used leaves the table, and a new one takes
+  // its place.
+  { const Formula f{x_ * y_ <= 7}; }
+  const Formula f{x_ * y_ <= 7};
+  EXPECT_TRUE(is_relational(f));
+  EXPECT_PRED2(FormulaEqual, f, x_ * y_ <= 7);
+}
+
+TEST_F(SymbolicHashConsingTest, Disabled) {
+  set_hash_consing(false);
+  const Expression e1{x_ + y_};
+  const Expression e2{x_ + y_};
+  EXPECT_FALSE(to_addition(e1)->is_interned());
+  EXPECT_NE(to_addition(e1), to_addition(e2));
+  EXPECT_PRED2(ExprEqual, e1, e2);
+}
+
+TEST_F(SymbolicHashConsingTest, Concurrent) {
+  constexpr int kThreads{4};
+  constexpr int kIterations{2000};
+  vector<vector<Formula>> formulas(kThreads);
+  vector<thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < kIterations; ++i) {
+        // Every thread builds the same formulas, and drops half of them.
+        Formula f{x_ + i * y_ <= i};
+        if (i % 2 == 0) {
+          formulas[t].push_back(std::move(f));
+        }
+      }
+    });
+  }
+  for (thread& th : threads) {
+    th.join();
+  }
+  for (int t = 1; t < kThreads; ++t) {
+    ASSERT_EQ(formulas[t].size(), formulas[0].size());
+    for (size_t i = 0; i < formulas[0].size(); ++i) {
+      EXPECT_PRED2(FormulaEqual, formulas[t][i], formulas[0][i]);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace symbolic
+}  // namespace drake
+}  // namespace dreal